@@ -40,6 +40,7 @@
 #define GRAPH_MATRIX_H
 
 #include <stdbool.h>
+#include "thread_pool.h"
 
 /**
  * @brief Structure representing a graph.
@@ -76,6 +77,20 @@ typedef struct edge {
  */
 graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edges);
 
+/**
+ * @brief Create a graph, allocating and initializing the rows of the matrices in parallel.
+ *
+ * Each row is allocated and first written by the task which initializes it.
+ *
+ * @param nb_vertices Number of vertices in the graph.
+ * @param nb_edges Number of edges in the graph.
+ * @param directed Indicates if the graph is directed.
+ * @param edges Array of edges to initialize the graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created graph.
+ */
+graph_s *create_graph_parallel(int nb_vertices, int nb_edges, bool directed, edge_s *edges, thread_pool_s *pool);
+
 /**
  * @brief Delete a graph and free its resources.
  *
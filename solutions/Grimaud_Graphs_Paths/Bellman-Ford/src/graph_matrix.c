@@ -90,6 +90,79 @@ graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edge
   return g;
 }
 
+/**
+ * @brief Structure shared by the tasks building a graph in parallel.
+ */
+typedef struct {
+  graph_s *g;   /**< The graph being built */
+  bool failed;  /**< A memory allocation failed (atomic) */
+} graph_build_s;
+
+/**
+ * @brief Allocates and initializes the rows [lo, hi) of the matrices.
+ */
+static void build_rows(int lo, int hi, void *arg) {
+  graph_build_s *b = arg;
+  graph_s *g = b->g;
+  int nb_vertices = g->nb_vertices;
+  for (int i = lo; i < hi; i++) {
+    g->adj_matrix[i] = (double *)malloc(nb_vertices * sizeof(double));
+    if (!g->adj_matrix[i]) {
+      __atomic_store_n(&b->failed, true, __ATOMIC_RELAXED);
+      return;
+    }
+    for (int j = 0; j < nb_vertices; j++) {
+      g->adj_matrix[i][j] = (i == j) ? 0 : INFINITY;
+    }
+  }
+}
+
+/**
+ * @brief Creates a graph, allocating and initializing the rows of the matrices in parallel.
+ * 
+ * @param nb_vertices Number of vertices in the graph
+ * @param nb_edges Number of edges in the graph
+ * @param directed Boolean indicating if the graph is directed
+ * @param edges Array of edges in the graph
+ * @param pool The thread pool (NULL for a sequential execution)
+ * 
+ * @return Pointer to the created graph
+ */
+graph_s *create_graph_parallel(int nb_vertices, int nb_edges, bool directed, edge_s *edges, thread_pool_s *pool) {
+  graph_s *g = (graph_s *)malloc(sizeof(graph_s));
+  if (!g) return NULL; // Memory allocation failed
+  
+  g->nb_vertices = nb_vertices;
+  g->nb_edges = nb_edges;
+  g->directed = directed;
+
+  g->adj_matrix = (double **)calloc(nb_vertices, sizeof(double *));
+  g->dist = (double *)malloc(nb_vertices * sizeof(double));
+  g->parent = (int *)malloc(nb_vertices * sizeof(int));
+  if (!g->adj_matrix || !g->dist || !g->parent) {
+    delete_graph(g);
+    return NULL;
+  }
+
+  graph_build_s b = {.g = g, .failed = false};
+  thread_pool_parallel_for(pool, 0, nb_vertices, 16, build_rows, &b);
+  if (__atomic_load_n(&b.failed, __ATOMIC_RELAXED)) {
+    delete_graph(g);
+    return NULL;
+  }
+
+  // Initialize weights
+  for (int i = 0; i < nb_edges; i++) {
+    g->adj_matrix[edges[i].src][edges[i].dst] = edges[i].weight;
+    if (!directed) {
+      g->adj_matrix[edges[i].dst][edges[i].src] = edges[i].weight;
+    }
+  }
+  g->neg_weight_cycle = false;
+
+  return g;
+}
+
 /**
  * @brief Deletes a graph and frees its memory.
  * 
@@ -40,7 +40,10 @@
 #include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <unistd.h>
 #include "graph_matrix.h"
+#include "thread_pool.h"
+#include "dist_store.h"
 
 /**
  * @brief Applies the Bellman-Ford algorithm to find shortest paths from a single source vertex.
@@ -68,7 +71,7 @@ void bellman_ford(graph_s *g, int src) {
  
   // Bellmon-Ford's algorithm
   for (int k = 1; k < nb_vertices - 1; k++) {
-x    for (int w = 0; w < nb_vertices; w++) {
+    for (int w = 0; w < nb_vertices; w++) {
       for (int u = 0; u < nb_vertices; u++) {
         if (adj_matrix[u][w] != INFINITY) {
           double new_distance = dist[u] + adj_matrix[u][w];
@@ -103,6 +106,87 @@ x    for (int w = 0; w < nb_vertices; w++) {
   }
 }
 
+/**
+ * @brief Structure describing a round of the parallel Bellman-Ford algorithm.
+ */
+typedef struct {
+  graph_s *g;          /**< The graph */
+  dist_store_s *store; /**< The labels, lowered without locks */
+  bool changed;        /**< A distance decreased during the round (atomic) */
+} bf_round_s;
+
+/**
+ * @brief Relaxes all the edges leaving the vertices [lo, hi).
+ *
+ * Each task scans its own rows of the adjacency matrix and lowers the labels of the
+ * heads of the edges with an atomic min.
+ */
+static void bf_relax_range(int lo, int hi, void *arg) {
+  bf_round_s *round = arg;
+  graph_s *g = round->g;
+  bool changed = false;
+  for (int u = lo; u < hi; u++) {
+    float dist_u = dist_store_dist(round->store, u);
+    if (dist_u == INFINITY) continue;
+    double *row = g->adj_matrix[u];
+    for (int w = 0; w < g->nb_vertices; w++) {
+      if (row[w] != INFINITY && dist_store_min(round->store, w, (float)(dist_u + row[w]), u))
+        changed = true;
+    }
+  }
+  if (changed) __atomic_store_n(&round->changed, true, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Applies the Bellman-Ford algorithm in parallel.
+ *
+ * Each round relaxes all the edges, the rows of the adjacency matrix being split
+ * between the tasks of the pool. The labels are shared by all the tasks and lowered
+ * without locks (see `dist_store.h`), so a round may already use the distances
+ * lowered by the other tasks. The rounds stop as soon as no distance decreases, then
+ * the negative weight cycles are detected as in `bellman_ford`. The distances are
+ * computed in single precision.
+ *
+ * @param g Pointer to the graph structure containing adjacency matrix, distance array, and parent array.
+ * @param src The source vertex index.
+ * @param pool The thread pool.
+ */
+void bellman_ford_parallel(graph_s *g, int src, thread_pool_s *pool) {
+  assert(g && g->adj_matrix && g->dist && g->parent);
+
+  int nb_vertices = g->nb_vertices;
+  dist_store_s *store = dist_store_create(nb_vertices);
+  dist_store_set(store, src, 0.0f, src);
+
+  int grain = (nb_vertices + 4 * thread_pool_size(pool) - 1) / (4 * thread_pool_size(pool));
+  for (int k = 1; k < nb_vertices; k++) {
+    bf_round_s round = {.g = g, .store = store, .changed = false};
+    thread_pool_parallel_for(pool, 0, nb_vertices, grain, bf_relax_range, &round);
+    if (!__atomic_load_n(&round.changed, __ATOMIC_RELAXED)) break;
+  }
+
+  for (int w = 0; w < nb_vertices; w++) {
+    uint64_t label = dist_store_load(store, w);
+    g->dist[w] = dist_store_unpack_dist(label);
+    g->parent[w] = dist_store_unpack_parent(label);
+  }
+
+  // Verification of negative weight cycles, in the precision of the labels
+  g->neg_weight_cycle = false;
+  for (int u = 0; u < nb_vertices && !g->neg_weight_cycle; u++) {
+    float dist_u = dist_store_dist(store, u);
+    for (int w = 0; w < nb_vertices; w++) {
+      if (g->adj_matrix[u][w] != INFINITY && (float)(dist_u + g->adj_matrix[u][w]) < dist_store_dist(store, w)) {
+        // A shorter path found, indicates a negative weight cycle
+        g->neg_weight_cycle = true;
+        printf("Negative cycle detected at vertex %d.\n", w);
+        break; // Stop further processing
+      }
+    }
+  }
+  dist_store_delete(store);
+}
+
 /**
  * @brief Prints the shortest path from the source vertex to a destination vertex.
  * 
@@ -154,9 +238,12 @@ void print_help(char *prog_name) {
   printf("  -d, --directed          Specify that the graph is a directed graph (default: undirected)\n");
   printf("  -v, --vertices <number> Specify the number of vertices\n");
   printf("  -a, --adjacencies       Specify the adjacency list in the format \"src:dst1/weight1,dst2/weight2 ...\"\n");
+  printf("  -j, --threads <number>  Number of worker threads (default: number of online processors)\n");
+  printf("      --pin               Pin each worker thread to a processor\n");
   printf("\nExamples:\n");
   printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\"\n", prog_name);
   printf("  %s --vertices 5 --adjacencies \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0\" --directed\n", prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" --threads 4 --pin\n", prog_name);
   return;
 }
 
@@ -176,6 +263,8 @@ int main(int argc, char **argv) {
   char *edges_list = NULL;
   bool directed = false;
   int start_vertex = 0; // Default start vertex
+  int nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  bool pin_threads = false;
   
   // parse options
   for (int i = 1; i < argc; i++) {
@@ -205,8 +294,18 @@ int main(int argc, char **argv) {
 	fprintf(stderr, "Error: Missing argument for --start\n");
 	return 1;
       }
+    } else if (strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0) {
+      if (i + 1 < argc) {
+        nb_threads = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --threads\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--pin") == 0) {
+      pin_threads = true;
     }
   }
+  if (nb_threads < 1) nb_threads = 1;
   if (vertices == 0 || edges_list == NULL) {
     fprintf(stderr, "Error: --vertices and --adjacencies are required\n\n");
     print_help(argv[0]);
@@ -280,16 +379,22 @@ int main(int argc, char **argv) {
     while (*ptr == ' ') ptr++;
   }
   
-  // create the graph_s 
-  graph_s *g = create_graph(vertices, edge_count, directed, edges);
+  // create the thread pool and the graph_s 
+  thread_pool_s *pool = thread_pool_create(nb_threads, pin_threads);
+  graph_s *g = create_graph_parallel(vertices, edge_count, directed, edges, pool);
   if (!g) {
     fprintf(stderr, "Error: Failed to create graph\n");
+    thread_pool_delete(pool);
     return 1;
   }
   print(g);
 
   // Bellman-Ford algorithm process - beginning
-  bellman_ford(g, start_vertex);
+  if (thread_pool_size(pool) > 1) {
+    bellman_ford_parallel(g, start_vertex, pool);
+  } else {
+    bellman_ford(g, start_vertex);
+  }
   printf("Resulting Bellman-Ford shortest paths :\n");
 
   if (!g->neg_weight_cycle){
@@ -307,6 +412,7 @@ int main(int argc, char **argv) {
   
   // delete the graph_s
   delete_graph(g);
+  thread_pool_delete(pool);
   
   // that's all folk !
   return 0;
@@ -0,0 +1,107 @@
+/**
+ * @file arcflags.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Arc flags for goal-directed point-to-point searches.
+ *
+ * This file declares the arc flags preprocessing (Lauther, Möhring et al.). The
+ * vertices are partitioned into R regions (the Voronoi cells of R seeds), and each
+ * edge receives one bit per region: the bit of the region r is set if the edge lies
+ * on a shortest path to a vertex of r. A point-to-point Dijkstra search then only
+ * relaxes the edges flagged for the region of the target, which prunes the
+ * branches leading away from it.
+ *
+ * A shortest path to a vertex t of r enters r for the last time at a boundary
+ * vertex b of r (a vertex of r with an incoming edge from another region), then
+ * stays inside r. The flags of r are thus set on the edges between two vertices of
+ * r, and on the edges of the shortest paths to each boundary vertex b, found by a
+ * backward Dijkstra search from b on the transpose graph (all the ties being
+ * flagged). These searches are independent and run on the thread pool.
+ *
+ * The flags are stored next to the edges of a CSR copy of the graph, one 64-bit
+ * word per edge, so R is at most ARCFLAGS_MAX_REGIONS.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef ARCFLAGS_H
+#define ARCFLAGS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph_csr.h"
+#include "workspace.h"
+#include "thread_pool.h"
+
+/** @brief Largest number of regions (bits of a flag word). */
+#define ARCFLAGS_MAX_REGIONS 64
+
+/**
+ * @brief Structure representing a graph with its arc flags.
+ *
+ * The flags of the edge e (from `csr->first[u]` to `csr->first[u+1]` for the edges
+ * leaving u) are `flags[e]`: bit r for the region r.
+ */
+typedef struct {
+  graph_csr_s *csr;   /**< CSR copy of the graph */
+  int nb_regions;     /**< Number of regions */
+  int *region;        /**< Region of each vertex */
+  uint64_t *flags;    /**< Flags of each edge */
+  int nb_boundary;    /**< Number of boundary vertices (backward searches of the preprocessing) */
+} arcflags_s;
+
+/**
+ * @brief Partitions a graph into regions and computes its arc flags.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param nb_regions The number of regions (1 to ARCFLAGS_MAX_REGIONS, at most the number of vertices).
+ * @param pool The thread pool running the backward searches (NULL for a sequential execution).
+ * @return Pointer to the created arc flags.
+ */
+arcflags_s *arcflags_create(graph_s *g, int nb_regions, thread_pool_s *pool);
+
+/**
+ * @brief Gets the proportion of the flags set.
+ *
+ * @param af The arc flags.
+ * @return The number of bits set divided by the number of edges times the number of regions.
+ */
+double arcflags_density(const arcflags_s *af);
+
+/**
+ * @brief Computes the distance between two vertices with a Dijkstra search stopped at the target.
+ *
+ * The path is left in the workspace (see `workspace_dist`), and the number of vertices
+ * settled in `ws->nb_settled`.
+ *
+ * @param af The arc flags.
+ * @param src The source vertex.
+ * @param dst The target vertex.
+ * @param prune Only relaxes the edges flagged for the region of the target (false runs
+ *              a plain search, for comparison).
+ * @param ws A workspace created for the vertices of the graph.
+ * @return The distance, INFINITY if the target is unreachable.
+ */
+double arcflags_query(const arcflags_s *af, int src, int dst, bool prune, workspace_s *ws);
+
+/**
+ * @brief Deletes arc flags and frees their memory.
+ *
+ * @param af Pointer to the arc flags.
+ */
+void arcflags_delete(arcflags_s *af);
+
+#endif // ARCFLAGS_H
@@ -0,0 +1,50 @@
+/**
+ * @file batch.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Batch of Dijkstra searches running on the thread pool.
+ *
+ * This file declares the computation of the distances from many sources at once.
+ * Each source is a task of the thread pool, and each worker reuses its own
+ * Dijkstra workspace from one source to the next. The searches read a CSR copy of
+ * the graph (see `graph_csr.h`) interleaved over the memory nodes, or a replica
+ * placed on the node of the worker when the node has enough free memory.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "graph_list.h"
+#include "thread_pool.h"
+#include "sssp_csr.h"
+
+/**
+ * @brief Computes the distances from several sources to all the vertices.
+ *
+ * @param g The graph.
+ * @param sources Array of source vertices.
+ * @param nb_sources Number of sources.
+ * @param relax The relaxation loop of the searches (see `sssp_csr.h`).
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return A dynamically allocated array of `nb_sources * g->nb_vertices` distances:
+ *         the distance from `sources[i]` to v is at index `i * g->nb_vertices + v`.
+ */
+double *dijkstra_batch(graph_s *g, const int *sources, int nb_sources, relax_e relax,
+                      thread_pool_s *pool);
+
+#endif // BATCH_H
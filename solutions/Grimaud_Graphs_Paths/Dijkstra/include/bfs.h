@@ -0,0 +1,132 @@
+/**
+ * @file bfs.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Breadth-first searches computing hop distances on unweighted graphs.
+ *
+ * This file declares two breadth-first search engines working on CSR graphs (see
+ * `graph_csr.h`), whose weights are ignored:
+ * - a direction-optimizing BFS (Beamer, Asanović and Patterson) from one source.
+ *   Small frontiers are expanded top-down (the edges leaving the frontier are
+ *   scanned), large ones bottom-up (each unvisited vertex scans its entering edges
+ *   until it finds a parent in the frontier), which skips most of the edges of
+ *   the large middle levels of low-diameter graphs;
+ * - a multi-source bit-parallel BFS (MS-BFS, Then et al.) advancing up to
+ *   MSBFS_SOURCES sources at once. Each vertex holds one bit per source in its
+ *   masks, and a level is one sweep over the adjacency shared by all the sources,
+ *   the masks being combined by whole words (vectorized by the compiler).
+ *
+ * The all-pairs hop statistics of large graphs are computed by running batches of
+ * MSBFS_SOURCES sources as tasks of the thread pool.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef BFS_H
+#define BFS_H
+
+#include <stdint.h>
+#include "graph_csr.h"
+#include "thread_pool.h"
+
+/** @brief Number of 64-bit words of the masks of the multi-source BFS. */
+#define MSBFS_WORDS 4
+
+/** @brief Maximum number of sources of one multi-source BFS. */
+#define MSBFS_SOURCES (64 * MSBFS_WORDS)
+
+/**
+ * @brief Structure representing one bit per source of a multi-source BFS.
+ */
+typedef struct {
+  uint64_t w[MSBFS_WORDS]; /**< Bit i is the bit i%64 of the word i/64 */
+} msbfs_mask_s;
+
+/**
+ * @brief Structure summarizing the hop distances found by breadth-first searches.
+ */
+typedef struct {
+  long long nb_pairs; /**< Number of pairs (source, vertex) reached, the source excluded */
+  long long sum_hops; /**< Sum of the hop distances of these pairs */
+  int max_hops;       /**< Largest hop distance found */
+} hop_stats_s;
+
+/**
+ * @brief Structure representing a reusable multi-source BFS workspace.
+ */
+typedef struct {
+  int nb_vertices;      /**< Number of vertices of the graphs searched with this workspace */
+  msbfs_mask_s *seen;   /**< Sources that reached each vertex */
+  msbfs_mask_s *visit;  /**< Sources that reached each vertex at the current level */
+  msbfs_mask_s *next;   /**< Sources reaching each vertex at the next level */
+  hop_stats_s stats;    /**< Statistics of the last search */
+} msbfs_s;
+
+/**
+ * @brief Computes the hop distances from a source with a direction-optimizing BFS.
+ *
+ * @param out The graph.
+ * @param in The transpose of the graph (see `graph_csr_transpose`), or the graph
+ *           itself when it is undirected.
+ * @param src The source vertex.
+ * @param hops Array of `out->nb_vertices` hop distances, filled with -1 for the
+ *             vertices not reached.
+ * @param nb_bottom_up Address where the number of levels expanded bottom-up is
+ *                     stored (may be NULL).
+ * @return The number of levels (the largest hop distance).
+ */
+int bfs(const graph_csr_s *out, const graph_csr_s *in, int src, int *hops, int *nb_bottom_up);
+
+/**
+ * @brief Creates a multi-source BFS workspace for graphs of a given number of vertices.
+ *
+ * @param nb_vertices Number of vertices of the graphs.
+ * @return Pointer to the created workspace.
+ */
+msbfs_s *msbfs_create(int nb_vertices);
+
+/**
+ * @brief Deletes a multi-source BFS workspace and frees its memory.
+ *
+ * @param ms Pointer to the workspace.
+ */
+void msbfs_delete(msbfs_s *ms);
+
+/**
+ * @brief Computes the hop distances from up to MSBFS_SOURCES sources at once.
+ *
+ * The statistics of the search are left in `ms->stats`.
+ *
+ * @param ms The workspace.
+ * @param csr The graph.
+ * @param sources Array of source vertices.
+ * @param nb_sources Number of sources (at most MSBFS_SOURCES).
+ * @param hops Array of `nb_sources * csr->nb_vertices` hop distances, the distance
+ *             from `sources[i]` to v being at index `i * csr->nb_vertices + v`
+ *             (-1 if v is not reached), or NULL if only the statistics are needed.
+ */
+void bfs_multi(msbfs_s *ms, const graph_csr_s *csr, const int *sources, int nb_sources, int *hops);
+
+/**
+ * @brief Computes the statistics of the hop distances between all the pairs of vertices.
+ *
+ * @param csr The graph.
+ * @param pool The thread pool running the batches of sources (NULL for a sequential execution).
+ * @return The statistics over all the pairs.
+ */
+hop_stats_s bfs_all_pairs(const graph_csr_s *csr, thread_pool_s *pool);
+
+#endif // BFS_H
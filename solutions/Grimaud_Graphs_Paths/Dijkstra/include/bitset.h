@@ -0,0 +1,124 @@
+/**
+ * @file bitset.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Compact set of vertices stored as an array of bits.
+ *
+ * A bitset stores one bit per vertex in 64-bit words. Membership tests are a
+ * shift and a mask, and a set of V vertices only needs V/8 bytes, so it stays in
+ * cache far longer than an array of booleans.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Structure representing a set of bits.
+ */
+typedef struct {
+  int nb_bits;     /**< Number of bits of the set */
+  int nb_words;    /**< Number of 64-bit words used to store the bits */
+  uint64_t *words; /**< Array of words, bit i is the bit i%64 of the word i/64 */
+} bitset_s;
+
+/**
+ * @brief Creates an empty bitset.
+ *
+ * @param nb_bits Number of bits of the set.
+ * @return Pointer to the created bitset.
+ */
+bitset_s *bitset_create(int nb_bits);
+
+/**
+ * @brief Deletes a bitset and frees its memory.
+ *
+ * @param b Pointer to the bitset.
+ */
+void bitset_delete(bitset_s *b);
+
+/**
+ * @brief Clears all the bits of a bitset.
+ *
+ * @param b Pointer to the bitset.
+ */
+void bitset_clear_all(bitset_s *b);
+
+/**
+ * @brief Counts the bits set in a bitset.
+ *
+ * @param b Pointer to the bitset.
+ * @return The number of bits set.
+ */
+int bitset_count(const bitset_s *b);
+
+/**
+ * @brief Sets a bit.
+ *
+ * @param b Pointer to the bitset.
+ * @param i Index of the bit.
+ */
+static inline void bitset_set(bitset_s *b, int i) {
+  b->words[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+/**
+ * @brief Sets a bit, other threads possibly setting bits of the same word.
+ *
+ * @param b Pointer to the bitset.
+ * @param i Index of the bit.
+ */
+static inline void bitset_set_atomic(bitset_s *b, int i) {
+  __atomic_fetch_or(&b->words[i >> 6], (uint64_t)1 << (i & 63), __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Clears a bit.
+ *
+ * @param b Pointer to the bitset.
+ * @param i Index of the bit.
+ */
+static inline void bitset_clear(bitset_s *b, int i) {
+  b->words[i >> 6] &= ~((uint64_t)1 << (i & 63));
+}
+
+/**
+ * @brief Tests a bit.
+ *
+ * @param b Pointer to the bitset.
+ * @param i Index of the bit.
+ * @return true if the bit is set.
+ */
+static inline bool bitset_test(const bitset_s *b, int i) {
+  return (b->words[i >> 6] >> (i & 63)) & 1;
+}
+
+/**
+ * @brief Tests a bit, other threads possibly setting bits of the same word.
+ *
+ * @param b Pointer to the bitset.
+ * @param i Index of the bit.
+ * @return true if the bit is set.
+ */
+static inline bool bitset_test_atomic(const bitset_s *b, int i) {
+  return (__atomic_load_n(&b->words[i >> 6], __ATOMIC_RELAXED) >> (i & 63)) & 1;
+}
+
+#endif // BITSET_H
@@ -0,0 +1,134 @@
+/**
+ * @file crp.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Customizable route planning: multi-level overlays with a fast metric customization.
+ *
+ * This file declares a point-to-point query engine based on customizable route
+ * planning (Delling, Goldberg, Pajor and Werneck), which splits the preprocessing
+ * into two phases:
+ * - a metric-independent phase, run once on the topology: the vertices are
+ *   partitioned by recursive bisection (each half is a breadth-first search
+ *   half, grown from a pseudo-peripheral vertex) into 2^(CRP_FANOUT_BITS L) leaf
+ *   cells; the cells of the level l are the groups of 2^(CRP_FANOUT_BITS (l-1))
+ *   consecutive leaf cells, so the levels are nested. A boundary vertex of a
+ *   level has an edge to or from another cell of this level;
+ * - a customization, run again whenever the weights change: for each cell of each
+ *   level, a Dijkstra search from each of its boundary vertices, restricted to
+ *   the cell and running on the overlay of the level below, gives the clique of
+ *   shortest distances between its boundary vertices. The cells of a level are
+ *   customized in parallel on the thread pool.
+ *
+ * A query is a bidirectional Dijkstra search: at a vertex v, it uses the highest
+ * level whose cell of v contains neither the source nor the target, relaxing the
+ * clique of this cell and the edges leaving it (all the edges of v at the level 0).
+ *
+ * The weights are read from the CSR copy `csr->weight`: updating them and calling
+ * `crp_customize` again applies a new metric without touching the partition.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef CRP_H
+#define CRP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph_csr.h"
+#include "workspace.h"
+#include "thread_pool.h"
+
+/** @brief Number of bisections between two levels: each cell has 2^CRP_FANOUT_BITS subcells. */
+#define CRP_FANOUT_BITS 3
+
+/** @brief Largest number of overlay levels. */
+#define CRP_MAX_LEVELS 8
+
+/**
+ * @brief Structure representing an overlay level.
+ *
+ * The boundary vertices of the cell c are `vertex[first[c]]` ... up to `first[c+1]`,
+ * and the clique of the cell is the nb x nb matrix at `matrix + matrix_first[c]`
+ * (nb being its number of boundary vertices), by rows of sources.
+ */
+typedef struct {
+  int nb_cells;          /**< Number of cells */
+  int *first;            /**< First boundary vertex of each cell (nb_cells+1 entries) */
+  int *vertex;           /**< Boundary vertices, grouped by cell */
+  int *index;            /**< Index of each vertex among the boundary vertices of its cell (-1 if none) */
+  size_t *matrix_first;  /**< First weight of the clique of each cell (nb_cells+1 entries) */
+  double *matrix;        /**< Weights of the cliques (INFINITY for no path inside the cell) */
+} crp_level_s;
+
+/**
+ * @brief Structure representing a graph prepared for customizable route planning.
+ */
+typedef struct {
+  graph_csr_s *csr;                     /**< CSR copy of the graph, holding the current weights */
+  int *tfirst;                          /**< First edge entering each vertex (nb_vertices+1 entries) */
+  int *ttail;                           /**< Tail of each entering edge */
+  int *tedge;                           /**< Index in `csr` of each entering edge */
+  int nb_levels;                        /**< Number of overlay levels */
+  int *leaf;                            /**< Leaf cell of each vertex */
+  crp_level_s levels[CRP_MAX_LEVELS];   /**< Overlay levels 1 to nb_levels */
+} crp_s;
+
+/**
+ * @brief Partitions a graph and builds the topology of its overlays (metric-independent).
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param nb_levels The number of overlay levels (1 to CRP_MAX_LEVELS).
+ * @return Pointer to the prepared graph, to customize before the queries.
+ */
+crp_s *crp_create(graph_s *g, int nb_levels);
+
+/**
+ * @brief Computes the cliques of all the cells from the current weights.
+ *
+ * @param crp The prepared graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ */
+void crp_customize(crp_s *crp, thread_pool_s *pool);
+
+/**
+ * @brief Gets the number of shortcut weights of the overlays.
+ *
+ * @param crp The prepared graph.
+ * @return The number of entries of all the cliques.
+ */
+size_t crp_nb_shortcuts(const crp_s *crp);
+
+/**
+ * @brief Computes the distance between two vertices with a bidirectional search.
+ *
+ * @param crp The prepared graph, customized.
+ * @param src The source vertex.
+ * @param dst The target vertex.
+ * @param use_overlays Searches the overlays (false runs a plain bidirectional search, for comparison).
+ * @param fwd A workspace for the forward search (its `nb_settled` is updated).
+ * @param bwd A workspace for the backward search (its `nb_settled` is updated).
+ * @return The distance, INFINITY if the target is unreachable.
+ */
+double crp_query(const crp_s *crp, int src, int dst, bool use_overlays, workspace_s *fwd, workspace_s *bwd);
+
+/**
+ * @brief Deletes a prepared graph and frees its memory.
+ *
+ * @param crp Pointer to the prepared graph.
+ */
+void crp_delete(crp_s *crp);
+
+#endif // CRP_H
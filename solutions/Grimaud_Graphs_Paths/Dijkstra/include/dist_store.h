@@ -0,0 +1,154 @@
+/**
+ * @file dist_store.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Lock-free shared distance and parent labels.
+ *
+ * This file declares the labels of the vertices shared by the concurrent engines.
+ * The label of a vertex packs its distance (a 32-bit float) and its parent (a 32-bit
+ * integer) into one 64-bit word. A relaxation lowers the label with a compare and
+ * swap loop (an atomic min on the distance), so the threads never take a lock and
+ * the parent always matches the distance read with it.
+ *
+ * The distances are rounded to single precision: the engines compare and store the
+ * rounded values, so the results are consistent, but close to the double precision
+ * results rather than equal to them.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef DIST_STORE_H
+#define DIST_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Structure representing the labels of the vertices.
+ *
+ * The low 32 bits of a word hold the bits of the distance, the high 32 bits hold the parent.
+ */
+typedef struct {
+  int nb_vertices; /**< Number of vertices */
+  uint64_t *words; /**< Packed label of each vertex */
+} dist_store_s;
+
+/**
+ * @brief Creates the labels, all vertices being unreached (distance INFINITY, parent -1).
+ *
+ * @param nb_vertices Number of vertices.
+ * @return Pointer to the created labels.
+ */
+dist_store_s *dist_store_create(int nb_vertices);
+
+/**
+ * @brief Deletes the labels and frees their memory.
+ *
+ * @param s Pointer to the labels.
+ */
+void dist_store_delete(dist_store_s *s);
+
+/**
+ * @brief Packs a distance and a parent into a label.
+ *
+ * @param dist The distance.
+ * @param parent The parent.
+ * @return The label.
+ */
+static inline uint64_t dist_store_pack(float dist, int parent) {
+  uint32_t bits;
+  memcpy(&bits, &dist, sizeof(bits));
+  return ((uint64_t)(uint32_t)parent << 32) | bits;
+}
+
+/**
+ * @brief Gets the distance of a label.
+ *
+ * @param word The label.
+ * @return The distance.
+ */
+static inline float dist_store_unpack_dist(uint64_t word) {
+  uint32_t bits = (uint32_t)word;
+  float dist;
+  memcpy(&dist, &bits, sizeof(dist));
+  return dist;
+}
+
+/**
+ * @brief Gets the parent of a label.
+ *
+ * @param word The label.
+ * @return The parent.
+ */
+static inline int dist_store_unpack_parent(uint64_t word) {
+  return (int)(uint32_t)(word >> 32);
+}
+
+/**
+ * @brief Reads the label of a vertex atomically.
+ *
+ * @param s Pointer to the labels.
+ * @param v The vertex.
+ * @return The label of the vertex.
+ */
+static inline uint64_t dist_store_load(const dist_store_s *s, int v) {
+  return __atomic_load_n(&s->words[v], __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Reads the distance of a vertex atomically.
+ *
+ * @param s Pointer to the labels.
+ * @param v The vertex.
+ * @return The distance of the vertex.
+ */
+static inline float dist_store_dist(const dist_store_s *s, int v) {
+  return dist_store_unpack_dist(dist_store_load(s, v));
+}
+
+/**
+ * @brief Sets the label of a vertex (without concurrent relaxations).
+ *
+ * @param s Pointer to the labels.
+ * @param v The vertex.
+ * @param dist The distance.
+ * @param parent The parent.
+ */
+static inline void dist_store_set(dist_store_s *s, int v, float dist, int parent) {
+  __atomic_store_n(&s->words[v], dist_store_pack(dist, parent), __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Lowers the label of a vertex if the distance is shorter (atomic min).
+ *
+ * @param s Pointer to the labels.
+ * @param v The vertex.
+ * @param dist The new distance.
+ * @param parent The parent giving this distance.
+ * @return true if the label was lowered, false if its distance was already shorter or equal.
+ */
+static inline bool dist_store_min(dist_store_s *s, int v, float dist, int parent) {
+  uint64_t old = dist_store_load(s, v);
+  uint64_t word = dist_store_pack(dist, parent);
+  while (dist < dist_store_unpack_dist(old)) {
+    if (__atomic_compare_exchange_n(&s->words[v], &old, word, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      return true;
+  }
+  return false;
+}
+
+#endif // DIST_STORE_H
@@ -0,0 +1,133 @@
+/**
+ * @file graph_csr.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Compact (CSR) copy of a graph for the read-only engines.
+ *
+ * This file declares a compressed sparse row representation of a graph: the edges
+ * leaving each vertex are stored contiguously in two arrays (heads and weights),
+ * and the edges of the vertex v are the indices `first[v]` ... `first[v+1]-1`.
+ * Unlike the adjacency lists, the whole graph is held by three arrays, which can be
+ * placed on the memory nodes of the machine (see `numa_alloc.h`): the arrays are
+ * interleaved over all the nodes, and a replica can be placed on a given node.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+
+#include <stddef.h>
+#include "graph_list.h"
+
+/**
+ * @brief Structure representing a graph in compressed sparse row form.
+ */
+typedef struct {
+  int nb_vertices; /**< Number of vertices */
+  int nb_edges;    /**< Number of edges (each direction of an undirected edge counts) */
+  int *first;      /**< First edge of each vertex (nb_vertices+1 entries) */
+  int *head;       /**< Head of each edge */
+  double *weight;  /**< Weight of each edge */
+} graph_csr_s;
+
+/**
+ * @brief Iterates over the edges leaving a vertex (backend of `SSSP_ENGINE`).
+ *
+ * @param g Pointer to the CSR graph.
+ * @param u Index of the vertex.
+ * @param v Name of the int variable holding the head of each edge.
+ * @param w Name of the double variable holding the weight of each edge.
+ * @param ... The statement executed for each edge.
+ */
+#define GRAPH_CSR_FOREACH_EDGE(g, u, v, w, ...)                                      \
+  for (int e_ = (g)->first[u]; e_ < (g)->first[(u) + 1]; e_++) {                    \
+    int v = (g)->head[e_];                                                          \
+    double w = (g)->weight[e_];                                                     \
+    __VA_ARGS__                                                                     \
+  }
+
+/**
+ * @brief Creates the CSR copy of a graph, its arrays being interleaved over the nodes.
+ *
+ * The edges of each vertex are stored in the order of its adjacency list.
+ *
+ * @param g The graph.
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_create(graph_s *g);
+
+/**
+ * @brief Creates the CSR copy of a graph in parallel, its arrays being interleaved over the nodes.
+ *
+ * The degrees and then the edges of disjoint ranges of vertices are gathered by the
+ * tasks of the pool. The resulting graph is identical to the one built by
+ * `graph_csr_create`.
+ *
+ * @param g The graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_create_parallel(graph_s *g, thread_pool_s *pool);
+
+/**
+ * @brief Creates the transpose of a CSR graph, its arrays being interleaved over the nodes.
+ *
+ * The edges leaving a vertex in the transpose are the edges entering it in the graph,
+ * with the same weights, ordered by tail.
+ *
+ * @param csr The CSR graph.
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_transpose(const graph_csr_s *csr);
+
+/**
+ * @brief Creates the transpose of a CSR graph in parallel, its arrays being interleaved over the nodes.
+ *
+ * The index of incoming edges is built by the tasks of the pool. The resulting graph
+ * is identical to the one built by `graph_csr_transpose`.
+ *
+ * @param csr The CSR graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_transpose_parallel(const graph_csr_s *csr, thread_pool_s *pool);
+
+/**
+ * @brief Creates a replica of a CSR graph on a memory node.
+ *
+ * @param csr The CSR graph.
+ * @param node The index of the node.
+ * @return Pointer to the replica, NULL if the memory could not be allocated.
+ */
+graph_csr_s *graph_csr_replicate(const graph_csr_s *csr, int node);
+
+/**
+ * @brief Gets the memory used by the arrays of a CSR graph.
+ *
+ * @param csr The CSR graph.
+ * @return The size in bytes.
+ */
+size_t graph_csr_size(const graph_csr_s *csr);
+
+/**
+ * @brief Deletes a CSR graph and frees its memory.
+ *
+ * @param csr Pointer to the CSR graph (may be NULL).
+ */
+void graph_csr_delete(graph_csr_s *csr);
+
+#endif // GRAPH_CSR_H
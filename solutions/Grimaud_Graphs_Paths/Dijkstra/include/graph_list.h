@@ -30,6 +30,7 @@
 #define GRAPH_LIST_H
 
 #include <stdbool.h>
+#include "thread_pool.h"
 
 /**
  * @brief Structure representing a vertex in the graph.
@@ -56,6 +57,8 @@ typedef struct {
   int nb_edges;           /**< Number of edges in the graph */
   bool directed;          /**< Indicates if the graph is directed */
   adj_list_s **adj_lists; /**< Array of adjacency lists for each vertex */
+  adj_list_s *nodes;      /**< Nodes of all the lists when allocated in one array (NULL otherwise) */
+  int nb_nodes;           /**< Number of nodes of the `nodes` array */
 } graph_s;
 
 /**
@@ -79,6 +82,23 @@ typedef struct {
  */
 graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edges);
 
+/**
+ * @brief Creates a graph, building the adjacency lists in parallel.
+ *
+ * The edges are first dispatched by vertex, then the adjacency lists of disjoint
+ * ranges of vertices are built by the tasks of the pool. The resulting graph is
+ * identical to the one built by `create_graph`.
+ *
+ * @param nb_vertices Number of vertices in the graph
+ * @param nb_edges Number of edges in the graph
+ * @param directed Boolean indicating if the graph is directed
+ * @param edges Array of edges in the graph
+ * @param pool The thread pool (NULL for a sequential execution)
+ *
+ * @return Pointer to the created graph
+ */
+graph_s *create_graph_parallel(int nb_vertices, int nb_edges, bool directed, edge_s *edges, thread_pool_s *pool);
+
 /**
  * @brief Deletes a graph and frees its memory.
  * 
@@ -96,6 +116,22 @@ void delete_graph(graph_s *g);
  */
 adj_list_s *get_adj_list(graph_s *g, int ind);
 
+/**
+ * @brief Iterates over the edges leaving a vertex (backend of `SSSP_ENGINE`).
+ *
+ * @param g Pointer to the graph
+ * @param u Index of the vertex
+ * @param v Name of the int variable holding the head of each edge
+ * @param w Name of the double variable holding the weight of each edge
+ * @param ... The statement executed for each edge
+ */
+#define GRAPH_LIST_FOREACH_EDGE(g, u, v, w, ...)                                     \
+  for (adj_list_s *adj_ = (g)->adj_lists[u]; adj_ != NULL; adj_ = adj_->next) {     \
+    int v = adj_->vertex.ind;                                                       \
+    double w = adj_->vertex.weight;                                                 \
+    __VA_ARGS__                                                                     \
+  }
+
 /**
  * @brief Prints the details of the graph to the standard output.
  * 
@@ -0,0 +1,106 @@
+/**
+ * @file graph_shm.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief CSR graph built once in a named POSIX shared-memory segment.
+ *
+ * This file declares the layout of a CSR graph stored in a shared-memory object
+ * (`shm_open`), so that several query processes of a machine map the same pages
+ * read-only instead of each building its own adjacency lists. The segment begins
+ * with a header giving the offset of each array from the start of the segment:
+ * it holds no pointer and can be mapped at any address.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef GRAPH_SHM_H
+#define GRAPH_SHM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graph_csr.h"
+
+/** @brief Magic number of the graph segments ("GSH1"). */
+#define GRAPH_SHM_MAGIC 0x31485347u
+
+/**
+ * @brief Header of a graph segment (at the beginning of the segment).
+ */
+typedef struct {
+  uint32_t magic;       /**< GRAPH_SHM_MAGIC, written last (0 while the segment is filled) */
+  int32_t nb_vertices;  /**< Number of vertices */
+  int32_t nb_edges;     /**< Number of edges (each direction of an undirected edge counts) */
+  int32_t directed;     /**< 1 if the graph is directed */
+  uint64_t off_first;   /**< Offset of the first edge of each vertex (nb_vertices+1 int32) */
+  uint64_t off_head;    /**< Offset of the head of each edge (nb_edges int32) */
+  uint64_t off_weight;  /**< Offset of the weight of each edge (nb_edges double) */
+  uint64_t size;        /**< Size of the whole segment in bytes */
+} graph_shm_header_s;
+
+/**
+ * @brief Structure representing a graph segment mapped read-only.
+ *
+ * The arrays of `csr` point into the mapping: the CSR graph must not be modified nor
+ * deleted with `graph_csr_delete`.
+ */
+typedef struct {
+  graph_csr_s csr; /**< The graph, read in the segment */
+  bool directed;   /**< The graph is directed */
+  void *block;     /**< The mapping of the segment */
+  size_t size;     /**< Size of the mapping */
+} graph_shm_s;
+
+/**
+ * @brief Writes a CSR graph into a new shared-memory segment.
+ *
+ * An existing segment of the same name is replaced: the processes which mapped it
+ * keep their mapping until they detach.
+ *
+ * @param name The name of the segment ("/name").
+ * @param csr The CSR graph.
+ * @param directed The graph is directed.
+ * @return false if the segment could not be created.
+ */
+bool graph_shm_create(const char *name, const graph_csr_s *csr, bool directed);
+
+/**
+ * @brief Maps a graph segment, read-only.
+ *
+ * @param name The name of the segment.
+ * @return Pointer to the mapped graph, NULL if the segment does not exist, is not
+ * complete or is not a consistent graph segment.
+ */
+graph_shm_s *graph_shm_attach(const char *name);
+
+/**
+ * @brief Unmaps a graph segment.
+ *
+ * @param shm Pointer to the mapped graph (may be NULL).
+ */
+void graph_shm_detach(graph_shm_s *shm);
+
+/**
+ * @brief Removes the name of a graph segment.
+ *
+ * The memory is released when the last process detaches.
+ *
+ * @param name The name of the segment.
+ * @return false if the segment does not exist.
+ */
+bool graph_shm_unlink(const char *name);
+
+#endif // GRAPH_SHM_H
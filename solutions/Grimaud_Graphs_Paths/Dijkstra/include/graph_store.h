@@ -0,0 +1,146 @@
+/**
+ * @file graph_store.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Versions of a graph published atomically to concurrent readers.
+ *
+ * This file declares a store holding the current version of a graph for a
+ * long-running query process. A new version (for instance built with updated
+ * weights) is prepared by a writer while the queries go on, then published by
+ * swapping a single pointer. Queries started before the swap keep reading the
+ * previous version until they end: each reader announces the epoch in which it
+ * entered, and a retired version is freed only once every reader has left or
+ * entered a later epoch (grace period, as in read-copy-update).
+ *
+ * Entering and leaving a version take no lock and never wait for the writers;
+ * only the writers are serialized.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef GRAPH_STORE_H
+#define GRAPH_STORE_H
+
+#include "graph_list.h"
+#include "graph_csr.h"
+
+/**
+ * @brief Structure representing a published version of a graph.
+ *
+ * A version is immutable once published.
+ */
+typedef struct {
+  unsigned long id;  /**< Number of the version (0 for the first one) */
+  graph_s *g;        /**< The adjacency lists (may be NULL) */
+  graph_csr_s *csr;  /**< The CSR copy (may be NULL) */
+} graph_version_s;
+
+/**
+ * @brief Structure representing the counters of a store.
+ */
+typedef struct {
+  unsigned long nb_published; /**< Number of versions published after the first one */
+  unsigned long nb_reclaimed; /**< Number of retired versions freed */
+  int nb_pending;             /**< Number of retired versions waiting for their grace period */
+} graph_store_stats_s;
+
+/**
+ * @struct graph_store_s
+ * @brief Structure of the store.
+ */
+typedef struct graph_store graph_store_s;
+
+/**
+ * @brief Creates a store holding a first version.
+ *
+ * The store takes the ownership of the graphs of every version published to it.
+ *
+ * @param g The adjacency lists of the first version (may be NULL).
+ * @param csr The CSR copy of the first version (may be NULL).
+ * @param nb_readers Number of readers (a reader is one thread issuing queries).
+ * @return Pointer to the created store.
+ */
+graph_store_s *graph_store_create(graph_s *g, graph_csr_s *csr, int nb_readers);
+
+/**
+ * @brief Enters the current version.
+ *
+ * The version stays valid until the reader calls `graph_store_exit`. A reader
+ * holds at most one version at a time.
+ *
+ * @param s Pointer to the store.
+ * @param reader Index of the reader, in [0, nb_readers).
+ * @return The current version.
+ */
+const graph_version_s *graph_store_enter(graph_store_s *s, int reader);
+
+/**
+ * @brief Leaves the version entered by a reader.
+ *
+ * @param s Pointer to the store.
+ * @param reader Index of the reader.
+ */
+void graph_store_exit(graph_store_s *s, int reader);
+
+/**
+ * @brief Publishes a new version and retires the current one.
+ *
+ * The readers entering after the call get the new version. The retired version is
+ * freed by a later call of `graph_store_reclaim` (or of `graph_store_publish`) once
+ * its grace period is over; the call itself never waits for the readers.
+ *
+ * @param s Pointer to the store.
+ * @param g The adjacency lists of the new version (may be NULL).
+ * @param csr The CSR copy of the new version (may be NULL).
+ * @return The number of the new version.
+ */
+unsigned long graph_store_publish(graph_store_s *s, graph_s *g, graph_csr_s *csr);
+
+/**
+ * @brief Frees the retired versions that no reader can hold anymore.
+ *
+ * @param s Pointer to the store.
+ * @return The number of versions freed.
+ */
+int graph_store_reclaim(graph_store_s *s);
+
+/**
+ * @brief Waits until all the retired versions are freed.
+ *
+ * Only the caller waits; the readers are never blocked.
+ *
+ * @param s Pointer to the store.
+ */
+void graph_store_synchronize(graph_store_s *s);
+
+/**
+ * @brief Gets the counters of a store.
+ *
+ * @param s Pointer to the store.
+ * @return The counters.
+ */
+graph_store_stats_s graph_store_stats(graph_store_s *s);
+
+/**
+ * @brief Deletes a store and all its versions.
+ *
+ * No reader may hold a version.
+ *
+ * @param s Pointer to the store (may be NULL).
+ */
+void graph_store_delete(graph_store_s *s);
+
+#endif // GRAPH_STORE_H
@@ -0,0 +1,168 @@
+/**
+ * @file grid.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Implicit grid graphs built on a cost raster.
+ *
+ * This file declares a graph whose vertices are the cells of a 2D raster and whose
+ * edges are never stored: the neighbours of a cell are computed from its
+ * coordinates, so the memory is one cost per cell. The cell (x, y) is the vertex
+ * `y * width + x`.
+ *
+ * A cell of negative cost is an obstacle. With 4-connectivity a cell is linked to
+ * its horizontal and vertical neighbours; with 8-connectivity also to its diagonal
+ * neighbours, when both cells the diagonal move passes by are free (no corner
+ * cutting). Moving between two neighbours costs the mean of their costs, times
+ * √2 for a diagonal move.
+ *
+ * Three searches are provided:
+ * - Dijkstra's algorithm;
+ * - A*, guided by the octile (or Manhattan) distance times the smallest cost;
+ * - jump point search (Harabor and Grastien), which only pushes the cells where the
+ *   optimal paths may turn, skipping the long straight and diagonal runs. It is
+ *   exact on 8-connected grids whose free cells all have the same cost; on other
+ *   grids A* is run instead.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef GRID_H
+#define GRID_H
+
+#include <stdbool.h>
+#include "workspace.h"
+
+/**
+ * @brief Structure representing a grid graph.
+ */
+typedef struct {
+  int width;        /**< Number of columns */
+  int height;       /**< Number of rows */
+  int connectivity; /**< 4 or 8 */
+  float *cost;      /**< Cost of each cell, row by row (negative for an obstacle) */
+  float min_cost;   /**< Smallest cost of a free cell (see `grid_update`) */
+  bool uniform;     /**< All the free cells have the same cost (see `grid_update`) */
+} grid_s;
+
+/**
+ * @brief Searches available on a grid graph.
+ */
+typedef enum {
+  GRID_DIJKSTRA, /**< Dijkstra's algorithm */
+  GRID_ASTAR,    /**< A* with the octile (or Manhattan) distance */
+  GRID_JPS       /**< Jump point search (A* on grids it does not apply to) */
+} grid_search_e;
+
+/**
+ * @brief Creates a grid whose cells all cost 1.
+ *
+ * @param width Number of columns.
+ * @param height Number of rows.
+ * @param connectivity 4 or 8.
+ * @return Pointer to the created grid.
+ */
+grid_s *grid_create(int width, int height, int connectivity);
+
+/**
+ * @brief Reads a grid from a text file.
+ *
+ * The file starts with the width and the height, followed by the cost of each cell
+ * row by row; an obstacle is written `#` (or as a negative cost).
+ *
+ * @param path Path of the file.
+ * @param connectivity 4 or 8.
+ * @return Pointer to the created grid, NULL if the file cannot be read.
+ */
+grid_s *grid_load(const char *path, int connectivity);
+
+/**
+ * @brief Creates a grid of cost 1 with randomly placed obstacles.
+ *
+ * @param width Number of columns.
+ * @param height Number of rows.
+ * @param connectivity 4 or 8.
+ * @param obstacles Probability of a cell being an obstacle.
+ * @param seed Seed of the generator (the same seed gives the same grid).
+ * @return Pointer to the created grid.
+ */
+grid_s *grid_random(int width, int height, int connectivity, double obstacles, unsigned int seed);
+
+/**
+ * @brief Updates `min_cost` and `uniform` after the costs have been changed.
+ *
+ * @param g Pointer to the grid.
+ */
+void grid_update(grid_s *g);
+
+/**
+ * @brief Deletes a grid and frees its memory.
+ *
+ * @param g Pointer to the grid.
+ */
+void grid_delete(grid_s *g);
+
+/**
+ * @brief Tests if a cell is inside the grid and free.
+ *
+ * @param g The grid.
+ * @param x Column of the cell.
+ * @param y Row of the cell.
+ * @return true if the cell can be crossed.
+ */
+static inline bool grid_free(const grid_s *g, int x, int y) {
+  return x >= 0 && y >= 0 && x < g->width && y < g->height && g->cost[y * g->width + x] >= 0.0f;
+}
+
+/**
+ * @brief Tests if jump point search is exact on a grid.
+ *
+ * @param g The grid.
+ * @return true if the grid is 8-connected with a uniform cost.
+ */
+static inline bool grid_jps_exact(const grid_s *g) {
+  return g->connectivity == 8 && g->uniform;
+}
+
+/**
+ * @brief Computes the shortest path between two cells.
+ *
+ * The search stops when the target is settled. The cells settled are in
+ * `ws->settled_list` and the predecessors in `ws->prev` (for a jump point search,
+ * the predecessor of a cell is the previous jump point, see `grid_path`).
+ *
+ * @param g The grid.
+ * @param src The source cell.
+ * @param dst The target cell.
+ * @param search The search.
+ * @param ws A workspace created for `width * height` vertices, reset by the call.
+ * @return The cost of the path, INFINITY if there is no path.
+ */
+double grid_search(const grid_s *g, int src, int dst, grid_search_e search, workspace_s *ws);
+
+/**
+ * @brief Gets the cells of the path found by the last search.
+ *
+ * The segments between consecutive jump points are filled in.
+ *
+ * @param g The grid.
+ * @param ws The workspace of the search.
+ * @param dst The target cell.
+ * @param cells Array of at least `width * height` cells, filled from the source to the target.
+ * @return The number of cells of the path, 0 if the target was not reached.
+ */
+int grid_path(const grid_s *g, const workspace_s *ws, int dst, int *cells);
+
+#endif // GRID_H
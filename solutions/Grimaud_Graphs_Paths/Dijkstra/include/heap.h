@@ -60,6 +60,14 @@ heap_s *heap_add(vertex_s vertex, heap_s *heap);
  */
 bool heap_empty(heap_s *heap);
 
+/** 
+ * @brief Gets the number of elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The number of elements.
+ * @note Asserts that the heap is created.
+ */
+int heap_size(heap_s *heap);
+
 /** 
  * @brief Reads the head element without removing it.
  * @param heap The address of the current heap.
@@ -68,6 +76,14 @@ bool heap_empty(heap_s *heap);
  */
 vertex_s heap_peek(heap_s *heap);
 
+/** 
+ * @brief Hints the processor that the entry of a vertex will be accessed soon.
+ * @param heap The address of the current heap.
+ * @param ind The index of the vertex.
+ * @note Does not change the heap, and never faults.
+ */
+void heap_prefetch(heap_s *heap, int ind);
+
 /** 
  * @brief Removes the head element.
  * @param heap The address of the current heap.
@@ -76,6 +92,14 @@ vertex_s heap_peek(heap_s *heap);
  */
 heap_s *heap_remove(heap_s *heap);
 
+/** 
+ * @brief Removes all the elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The address of the updated heap.
+ * @note The cost is proportional to the number of elements left in the heap.
+ */
+heap_s *heap_clear(heap_s *heap);
+
 /** 
  * @brief Prints the heap elements from the head to the last element.
  * @param heap The address of the current heap.
@@ -0,0 +1,101 @@
+/**
+ * @file implicit_graph.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Graphs whose edges are generated on demand by a callback.
+ *
+ * This file declares a graph backend that never stores its edges: the edges leaving
+ * a vertex are produced by a function of the caller when the search reaches the
+ * vertex (for example the successor states computed by a simulator). Only the
+ * labels of the search take memory, so the searches run on state spaces far too
+ * large to build as a `graph_s`; a search stopping at its target only generates
+ * the part of the graph closer than the target.
+ *
+ * The callback is called once per settled vertex and writes all the edges of the
+ * vertex in buffers, which the engine then reads in a plain loop. When even this
+ * call matters, a caller can write its own iteration macro (see `sssp_engine.h`)
+ * and instantiate the engine with it, the generation being then inlined.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef IMPLICIT_GRAPH_H
+#define IMPLICIT_GRAPH_H
+
+#include <assert.h>
+
+/**
+ * @brief Function generating the edges leaving a vertex.
+ *
+ * @param ctx The context given to `implicit_graph_create`.
+ * @param u The vertex.
+ * @param heads Array where the heads of the edges are written.
+ * @param weights Array where the weights of the edges are written.
+ * @return The number of edges written (at most the maximum degree of the graph).
+ */
+typedef int (*neighbours_fn)(void *ctx, int u, int *heads, double *weights);
+
+/**
+ * @brief Structure representing a graph whose edges are generated by a callback.
+ */
+typedef struct {
+  int nb_vertices;          /**< Number of vertices */
+  int max_degree;           /**< Maximum number of edges leaving a vertex */
+  neighbours_fn neighbours; /**< Function generating the edges */
+  void *ctx;                /**< Context given to the function */
+  int *heads;               /**< Buffer of the heads of the edges of the current vertex */
+  double *weights;          /**< Buffer of the weights of the edges of the current vertex */
+} implicit_graph_s;
+
+/**
+ * @brief Creates a graph whose edges are generated by a callback.
+ *
+ * @param nb_vertices Number of vertices.
+ * @param max_degree Maximum number of edges leaving a vertex.
+ * @param neighbours Function generating the edges leaving a vertex.
+ * @param ctx Context given to the function.
+ * @return Pointer to the created graph.
+ */
+implicit_graph_s *implicit_graph_create(int nb_vertices, int max_degree, neighbours_fn neighbours, void *ctx);
+
+/**
+ * @brief Deletes a graph and frees its buffers (the context is left to the caller).
+ *
+ * @param ig Pointer to the graph.
+ */
+void implicit_graph_delete(implicit_graph_s *ig);
+
+/**
+ * @brief Iterates over the edges leaving a vertex (backend of `SSSP_ENGINE`).
+ *
+ * @param g Pointer to the graph.
+ * @param u Index of the vertex.
+ * @param v Name of the int variable holding the head of each edge.
+ * @param w Name of the double variable holding the weight of each edge.
+ * @param ... The statement executed for each edge.
+ *
+ * The number of edges returned by the callback is checked against the maximum
+ * degree, the size of the buffers.
+ */
+#define IMPLICIT_GRAPH_FOREACH_EDGE(g, u, v, w, ...)                                 \
+  for (int n_ = (g)->neighbours((g)->ctx, u, (g)->heads, (g)->weights), e_ = 0;    \
+       assert(n_ >= 0 && n_ <= (g)->max_degree), e_ < n_; e_++) {                 \
+    int v = (g)->heads[e_];                                                         \
+    double w = (g)->weights[e_];                                                    \
+    __VA_ARGS__                                                                     \
+  }
+
+#endif // IMPLICIT_GRAPH_H
@@ -0,0 +1,47 @@
+/**
+ * @file isochrone.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Bounded-radius Dijkstra search (isochrones).
+ *
+ * This file declares a Dijkstra search that stops expanding as soon as the
+ * distance budget is exhausted. Only the vertices within the radius are settled
+ * and they are returned as a compact list instead of a full V-length array.
+ * Combined with a reusable workspace, the cost of a query is proportional to the
+ * size of the ball.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef ISOCHRONE_H
+#define ISOCHRONE_H
+
+#include "graph_list.h"
+#include "workspace.h"
+
+/**
+ * @brief Settles all the vertices at distance at most `radius` from the source.
+ *
+ * @param g The graph.
+ * @param src The source vertex.
+ * @param radius The distance budget.
+ * @param ws A workspace created for `g->nb_vertices` vertices, reset by the call.
+ * @return The number of settled vertices. They are stored, ordered by increasing
+ *         distance, in `ws->settled_list` until the next use of the workspace.
+ */
+int dijkstra_within(graph_s *g, int src, double radius, workspace_s *ws);
+
+#endif // ISOCHRONE_H
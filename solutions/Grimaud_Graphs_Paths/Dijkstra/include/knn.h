@@ -0,0 +1,50 @@
+/**
+ * @file knn.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief k-nearest targets query with early termination.
+ *
+ * Given a source vertex and a set of target vertices (stores, facilities...), this
+ * query returns the k targets closest to the source. Dijkstra's algorithm settles
+ * vertices by increasing distance, so the search stops as soon as k targets are
+ * settled: it usually touches a tiny fraction of the graph.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef KNN_H
+#define KNN_H
+
+#include "graph_list.h"
+#include "bitset.h"
+#include "workspace.h"
+
+/**
+ * @brief Finds the k targets closest to the source.
+ *
+ * @param g The graph.
+ * @param src The source vertex.
+ * @param targets The set of target vertices (one bit per vertex of the graph).
+ * @param k The number of targets wanted.
+ * @param ws A workspace created for `g->nb_vertices` vertices, reset by the call.
+ * @param nearest Array of at least k vertices, filled with the targets found, ordered
+ *                by increasing distance (`prev` is the predecessor on the path, the full
+ *                path can be rebuilt from `ws->prev` until the next use of the workspace).
+ * @return The number of targets found (less than k if fewer targets are reachable).
+ */
+int dijkstra_knn(graph_s *g, int src, const bitset_s *targets, int k, workspace_s *ws, vertex_s *nearest);
+
+#endif // KNN_H
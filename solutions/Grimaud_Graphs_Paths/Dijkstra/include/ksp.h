@@ -0,0 +1,82 @@
+/**
+ * @file ksp.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief k-shortest loopless paths (Yen's algorithm).
+ *
+ * This file declares an engine computing the k shortest simple paths between two
+ * vertices, built on top of Dijkstra's algorithm. Yen's algorithm derives each new
+ * path from the previous one: for every vertex of the previous path (the spur
+ * vertex), it searches the shortest path which shares the same prefix (the root
+ * path) but leaves the spur vertex by an edge not used by an already found path.
+ * The spur searches of one iteration are independent and run in parallel on the
+ * thread pool, each task reusing its own Dijkstra workspace. The candidates are kept in a heap.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef KSP_H
+#define KSP_H
+
+#include "graph_list.h"
+#include "thread_pool.h"
+
+/**
+ * @brief Structure storing a set of paths in compact form.
+ *
+ * The vertices of the path i are `vertices[first[i]]` ... `vertices[first[i+1]-1]`,
+ * and `dist[j]` is the length of the path from its source to `vertices[j]`. The
+ * length of the path i is thus `dist[first[i+1]-1]`.
+ */
+typedef struct {
+  int nb_paths;   /**< Number of paths */
+  int *first;     /**< Index of the first vertex of each path (nb_paths+1 entries) */
+  int *vertices;  /**< Vertices of all the paths, one path after the other */
+  double *dist;   /**< Distance from the source along the path, for each vertex */
+} ksp_s;
+
+/**
+ * @brief Computes the k shortest loopless paths from src to dst.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param dst The destination vertex.
+ * @param k The number of paths wanted.
+ * @param pool The thread pool running the spur searches (NULL for a sequential execution).
+ * @return The paths found, ordered by increasing length (fewer than k if the graph
+ *         does not have k simple paths from src to dst).
+ */
+ksp_s *yen_ksp(graph_s *g, int src, int dst, int k, thread_pool_s *pool);
+
+/**
+ * @brief Deletes a set of paths and frees its memory.
+ *
+ * @param p Pointer to the set of paths.
+ */
+void ksp_delete(ksp_s *p);
+
+/**
+ * @brief Gets the length of a path.
+ *
+ * @param p Pointer to the set of paths.
+ * @param i Index of the path.
+ * @return The length of the path.
+ */
+static inline double ksp_length(const ksp_s *p, int i) {
+  return p->dist[p->first[i+1]-1];
+}
+
+#endif // KSP_H
@@ -0,0 +1,78 @@
+/**
+ * @file mst.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Minimum spanning forests of undirected graphs.
+ *
+ * This file declares two engines computing a minimum spanning forest (a minimum
+ * spanning tree of each connected component) of an undirected CSR graph (see
+ * `graph_csr.h`):
+ * - a parallel Borůvka: at each round, every component selects its lightest
+ *   leaving edge with a lock-free atomic minimum, then the selected edges merge
+ *   the components in a lock-free union-find with path compression. Each round at
+ *   least halves the number of components;
+ * - Prim's algorithm, growing one tree at a time with the decrease-key of the
+ *   heap (see `heap.h`), kept as a sequential reference.
+ *
+ * The edges are totally ordered by weight, then by their smallest and largest
+ * endpoints, so both engines find the same forest when the weights are distinct
+ * and forests of the same weight otherwise.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef MST_H
+#define MST_H
+
+#include "graph_list.h"
+#include "graph_csr.h"
+#include "thread_pool.h"
+
+/**
+ * @brief Structure representing a spanning forest.
+ */
+typedef struct {
+  int nb_edges;     /**< Number of edges of the forest */
+  int nb_trees;     /**< Number of trees (connected components, isolated vertices included) */
+  double weight;    /**< Total weight of the edges */
+  edge_s *edges;    /**< The edges, in the order they were added */
+} mst_s;
+
+/**
+ * @brief Computes a minimum spanning forest with a parallel Borůvka.
+ *
+ * @param csr The undirected graph (each edge stored in both directions).
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created forest.
+ */
+mst_s *mst_boruvka(const graph_csr_s *csr, thread_pool_s *pool);
+
+/**
+ * @brief Computes a minimum spanning forest with Prim's algorithm.
+ *
+ * @param csr The undirected graph (each edge stored in both directions).
+ * @return Pointer to the created forest.
+ */
+mst_s *mst_prim(const graph_csr_s *csr);
+
+/**
+ * @brief Deletes a spanning forest and frees its memory.
+ *
+ * @param mst Pointer to the forest.
+ */
+void mst_delete(mst_s *mst);
+
+#endif // MST_H
@@ -0,0 +1,92 @@
+/**
+ * @file multiqueue.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Relaxed concurrent priority queue (MultiQueue).
+ *
+ * This file declares a priority queue shared by several threads, made of several
+ * binary heaps, each one protected by its own lock. A push goes to a random heap; a
+ * pop looks at the heads of two random heaps and removes the better one. The queue
+ * is relaxed: a pop returns one of the smallest elements, not always the smallest
+ * one, but the threads rarely wait for each other.
+ *
+ * Locks are only taken with a try-lock: a thread finding a heap busy picks other
+ * random heaps instead of waiting.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+
+#include <stdbool.h>
+#include "graph_list.h"
+
+/**
+ * @struct multiqueue_s
+ * @brief Structure of the relaxed concurrent priority queue.
+ */
+typedef struct multiqueue multiqueue_s;
+
+/**
+ * @brief Creates a multiqueue.
+ *
+ * Each heap grows with its entries, so the memory does not depend on the size of
+ * the graph.
+ *
+ * @param nb_queues Number of heaps (usually twice the number of threads).
+ * @return Pointer to the created multiqueue.
+ */
+multiqueue_s *multiqueue_create(int nb_queues);
+
+/**
+ * @brief Adds a vertex to a random heap.
+ *
+ * The heaps have no index of their vertices: a vertex pushed again is a new
+ * entry, and the caller skips the outdated ones when they are popped.
+ *
+ * @param mq The multiqueue.
+ * @param vertex The vertex to add.
+ * @param seed The random seed of the calling thread.
+ */
+void multiqueue_push(multiqueue_s *mq, vertex_s vertex, unsigned int *seed);
+
+/**
+ * @brief Removes the head of the better of two random heaps.
+ *
+ * @param mq The multiqueue.
+ * @param vertex Receives the removed vertex.
+ * @param seed The random seed of the calling thread.
+ * @return true if a vertex was removed, false if the multiqueue was seen empty.
+ */
+bool multiqueue_pop(multiqueue_s *mq, vertex_s *vertex, unsigned int *seed);
+
+/**
+ * @brief Gets the number of elements of a multiqueue.
+ *
+ * @param mq The multiqueue.
+ * @return The number of elements (a snapshot while other threads are working).
+ */
+int multiqueue_size(multiqueue_s *mq);
+
+/**
+ * @brief Deletes a multiqueue and frees its memory.
+ *
+ * @param mq The multiqueue.
+ */
+void multiqueue_delete(multiqueue_s *mq);
+
+#endif // MULTIQUEUE_H
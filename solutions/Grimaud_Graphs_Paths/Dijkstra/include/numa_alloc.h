@@ -0,0 +1,152 @@
+/**
+ * @file numa_alloc.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Placement and page size of large arrays (NUMA nodes, huge pages).
+ *
+ * This file declares allocation functions controlling on which memory node the
+ * pages of an array are placed:
+ * - interleaved over all the nodes, for arrays read by every thread (the graph);
+ * - on a given node, for arrays mostly used by the threads of this node (the rows
+ *   owned by a worker, the replicas of a graph);
+ * - on the node of the first thread writing them (the search workspaces).
+ *
+ * The arrays of at least `NUMA_HUGE_PAGE_SIZE` bytes are mapped directly from the
+ * kernel, aligned on 2 MB, and backed by huge pages to save TLB entries: either
+ * transparent huge pages (`madvise(MADV_HUGEPAGE)`, the default) or reserved
+ * hugetlbfs pages (`MAP_HUGETLB`), falling back to transparent huge pages then to
+ * small pages when none are available. The placement is requested with the `mbind`
+ * system call; on a machine with a single node, or if the kernel refuses the
+ * request, the pages are simply placed by the first thread writing them. Smaller
+ * arrays come from `calloc`.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef NUMA_ALLOC_H
+#define NUMA_ALLOC_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Size of a huge page, arrays smaller than that use small pages. */
+#define NUMA_HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+/**
+ * @brief Kind of pages backing the large arrays.
+ */
+typedef enum {
+  HUGE_PAGES_NONE,        /**< Small pages only */
+  HUGE_PAGES_TRANSPARENT, /**< Transparent huge pages (madvise), the default */
+  HUGE_PAGES_HUGETLB      /**< Reserved hugetlbfs pages, then transparent huge pages */
+} huge_pages_e;
+
+/**
+ * @brief Selects the kind of pages backing the arrays allocated from now on.
+ *
+ * @param mode The kind of pages.
+ */
+void numa_set_huge_pages(huge_pages_e mode);
+
+/**
+ * @brief Enables the sampling of the huge pages when large arrays are freed.
+ *
+ * The sampling reads `/proc/self/smaps_rollup`, so it is off unless the huge pages
+ * are reported.
+ *
+ * @param enabled true to sample them for `numa_report`.
+ */
+void numa_set_report(bool enabled);
+
+/**
+ * @brief Parses the name of a kind of pages ("none", "thp" or "hugetlb").
+ *
+ * @param name The name.
+ * @param mode Receives the kind of pages.
+ * @return true if the name is valid.
+ */
+bool numa_parse_huge_pages(const char *name, huge_pages_e *mode);
+
+/**
+ * @brief Prints the amount of memory obtained with each kind of pages.
+ *
+ * The memory actually backed by transparent huge pages is read from the kernel
+ * (`/proc/self/smaps_rollup`) when reporting and, if `numa_set_report` enabled it,
+ * when a large array is freed; the peak is reported.
+ *
+ * @param f The output stream.
+ */
+void numa_report(FILE *f);
+
+/**
+ * @brief Gets the number of memory nodes of the machine.
+ *
+ * @return The number of nodes (1 if the machine is not NUMA).
+ */
+int numa_nb_nodes(void);
+
+/**
+ * @brief Gets the memory node of the processor running the calling thread.
+ *
+ * @return The index of the node (0 if unknown).
+ */
+int numa_current_node(void);
+
+/**
+ * @brief Gets the amount of free memory of a node.
+ *
+ * @param node The index of the node.
+ * @return The number of free bytes (0 if unknown).
+ */
+size_t numa_node_free(int node);
+
+/**
+ * @brief Allocates an array whose pages are interleaved over all the nodes.
+ *
+ * @param size The size of the array in bytes.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+void *numa_alloc_interleaved(size_t size);
+
+/**
+ * @brief Allocates an array whose pages are placed on a given node.
+ *
+ * The node is preferred: the pages go to another node if it is full.
+ *
+ * @param size The size of the array in bytes.
+ * @param node The index of the node.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+void *numa_alloc_onnode(size_t size, int node);
+
+/**
+ * @brief Allocates an array whose pages are placed by the first thread writing them.
+ *
+ * @param size The size of the array in bytes.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+void *numa_alloc_local(size_t size);
+
+/**
+ * @brief Frees an array allocated by one of the `numa_alloc` functions.
+ *
+ * @param ptr Pointer to the array (may be NULL).
+ * @param size The size given to the allocation.
+ */
+void numa_free(void *ptr, size_t size);
+
+#endif // NUMA_ALLOC_H
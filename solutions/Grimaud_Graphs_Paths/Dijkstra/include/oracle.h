@@ -0,0 +1,175 @@
+/**
+ * @file oracle.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Thorup–Zwick approximate distance oracles stored in mappable files.
+ *
+ * This file declares the distance oracle of Thorup and Zwick, which answers the
+ * distance between any two vertices of an undirected graph within a stretch of
+ * 2k-1 (the answer lies between the distance and 2k-1 times the distance) in O(k)
+ * time, after a preprocessing storing O(k n^(1+1/k)) entries on average.
+ *
+ * The preprocessing samples a hierarchy of vertex sets V = A_0 ⊇ A_1 ⊇ ... ⊇ A_k = ∅,
+ * each vertex of A_i being kept in A_(i+1) with probability n^(-1/k). For each level
+ * i, a multi-source Dijkstra from A_i gives the pivot p_i(v) of each vertex (its
+ * nearest vertex in A_i) and the distance d(A_i, v). The cluster of a vertex w of
+ * A_i \ A_(i+1) is the set of the vertices v with d(w, v) < d(A_(i+1), v); it is
+ * found by a Dijkstra search from w truncated at this bound. The bunch B(v) of a
+ * vertex is the set of the vertices whose cluster contains v, with their distances.
+ *
+ * A query for (u, v) climbs the levels: starting with w = u, while w is not in B(v)
+ * it swaps u and v and takes w as the pivot of u at the next level, then returns
+ * d(w, u) + d(w, v).
+ *
+ * The oracle is one contiguous block, saved as is in a file and mapped read-only by
+ * `oracle_load`, so a query process starts without any parsing (the arrays are
+ * only checked once, so that no query reads outside them): a header, the
+ * pivots and their distances by level, then the bunches. Each bunch is an open
+ * addressing hash table (at most half full) of vertices and distances, so
+ * a membership test usually reads a few consecutive slots of one cache line. The
+ * distances are stored in single precision.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef ORACLE_H
+#define ORACLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "graph_list.h"
+
+/** @brief Magic number of the oracle files ("TZO1"). */
+#define ORACLE_MAGIC 0x314f5a54u
+
+/**
+ * @brief Header of an oracle block (at the beginning of its file).
+ */
+typedef struct {
+  uint32_t magic;       /**< ORACLE_MAGIC */
+  int32_t k;            /**< Number of levels: the stretch is 2k-1 */
+  int32_t nb_vertices;  /**< Number of vertices */
+  int32_t reserved;     /**< Padding (0) */
+  uint64_t nb_slots;    /**< Number of slots of all the bunch hash tables */
+  uint64_t size;        /**< Size of the whole block in bytes */
+} oracle_header_s;
+
+/**
+ * @brief Structure representing a distance oracle, built in memory or mapped from a file.
+ *
+ * The pivot of the vertex v at the level i is `pivot[i * nb_vertices + v]` (-1 if no
+ * vertex of A_i is reachable). The hash table of the bunch of v is made of the slots
+ * `slot_vertex[bunch_first[v]]` ... up to `bunch_first[v+1]` (a power of 2 of them).
+ */
+typedef struct {
+  int k;                        /**< Number of levels */
+  int nb_vertices;              /**< Number of vertices */
+  const int32_t *pivot;         /**< Pivot of each vertex at each level */
+  const float *pivot_dist;      /**< Distance of each vertex to its pivot at each level */
+  const uint64_t *bunch_first;  /**< First slot of each bunch (nb_vertices+1 entries) */
+  const int32_t *slot_vertex;   /**< Vertex of each slot (-1 for an empty slot) */
+  const float *slot_dist;       /**< Distance of the vertex of each slot to the owner of the bunch */
+  void *block;                  /**< The block (header and arrays) */
+  size_t size;                  /**< Size of the block */
+  bool mapped;                  /**< The block is mapped from a file (otherwise allocated) */
+} oracle_s;
+
+/**
+ * @brief Builds the oracle of an undirected graph.
+ *
+ * @param g The graph (undirected, with positive weights).
+ * @param k The number of levels (at least 1): the stretch is 2k-1.
+ * @param seed The seed of the sampling of the levels.
+ * @return Pointer to the created oracle, NULL if the graph is directed.
+ */
+oracle_s *oracle_build(graph_s *g, int k, unsigned int seed);
+
+/**
+ * @brief Saves an oracle in a file.
+ *
+ * @param o The oracle.
+ * @param path The path of the file.
+ * @return false if the file could not be written.
+ */
+bool oracle_save(const oracle_s *o, const char *path);
+
+/**
+ * @brief Maps an oracle file in memory, read-only.
+ *
+ * @param path The path of the file.
+ * @return Pointer to the oracle, NULL if the file could not be mapped or is not a
+ *         consistent oracle.
+ */
+oracle_s *oracle_load(const char *path);
+
+/**
+ * @brief Gets the number of entries of the bunches of an oracle.
+ *
+ * @param o The oracle.
+ * @return The sum of the sizes of the bunches.
+ */
+uint64_t oracle_nb_entries(const oracle_s *o);
+
+/**
+ * @brief Looks for a vertex in the bunch of another one.
+ *
+ * @param o The oracle.
+ * @param v The owner of the bunch.
+ * @param w The vertex looked for.
+ * @return The distance between w and v, or a negative value if w is not in the bunch of v.
+ */
+static inline float oracle_bunch_dist(const oracle_s *o, int v, int w) {
+  uint64_t first = o->bunch_first[v];
+  uint32_t mask = (uint32_t)(o->bunch_first[v + 1] - first - 1);
+  uint32_t h = (uint32_t)w * 0x9e3779b1u;
+  for (uint32_t s = (h ^ (h >> 16)) & mask;; s = (s + 1) & mask) {
+    int32_t x = o->slot_vertex[first + s];
+    if (x == w) return o->slot_dist[first + s];
+    if (x == -1) return -1.0f;
+  }
+}
+
+/**
+ * @brief Estimates the distance between two vertices.
+ *
+ * @param o The oracle.
+ * @param u The first vertex.
+ * @param v The second vertex.
+ * @return A distance between d(u, v) and (2k-1) d(u, v), INFINITY if v is not reachable from u.
+ */
+static inline double oracle_query(const oracle_s *o, int u, int v) {
+  int i = 0, w = u;
+  float dv;
+  while ((dv = oracle_bunch_dist(o, v, w)) < 0.0f) {
+    if (++i == o->k) return INFINITY;
+    int t = u; u = v; v = t;
+    w = o->pivot[(size_t)i * o->nb_vertices + u];
+    if (w == -1) return INFINITY;
+  }
+  // w is the pivot of u at the level i (u itself at the level 0)
+  return (double)o->pivot_dist[(size_t)i * o->nb_vertices + u] + dv;
+}
+
+/**
+ * @brief Deletes an oracle: frees its block or unmaps its file.
+ *
+ * @param o Pointer to the oracle.
+ */
+void oracle_delete(oracle_s *o);
+
+#endif // ORACLE_H
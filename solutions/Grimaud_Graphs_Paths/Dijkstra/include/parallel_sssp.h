@@ -0,0 +1,47 @@
+/**
+ * @file parallel_sssp.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Parallel label-correcting Dijkstra on a relaxed priority queue.
+ *
+ * This file declares a single-source shortest path search where all the workers of
+ * the thread pool take vertices from a shared multiqueue (see `multiqueue.h`).
+ * Since the multiqueue is relaxed, a vertex may be processed before its final
+ * distance is known: it is then relaxed again later, when a shorter distance is
+ * found (label-correcting). The search ends when the multiqueue is empty and no
+ * worker is processing a vertex. The labels are lowered without locks (see
+ * `dist_store.h`), so the distances are computed in single precision.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef PARALLEL_SSSP_H
+#define PARALLEL_SSSP_H
+
+#include "graph_list.h"
+#include "thread_pool.h"
+
+/**
+ * @brief Performs a parallel label-correcting Dijkstra from a source vertex.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return An array of vertices with the shortest path information, as `dijkstra()`.
+ */
+vertex_s *dijkstra_parallel(graph_s *g, int src, thread_pool_s *pool);
+
+#endif // PARALLEL_SSSP_H
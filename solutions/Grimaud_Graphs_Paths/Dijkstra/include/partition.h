@@ -0,0 +1,128 @@
+/**
+ * @file partition.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Multilevel k-way graph partitioner, for sharding and cache blocking.
+ *
+ * This file declares a partitioner of the vertices into k parts of nearly equal
+ * sizes, cutting as few edges as possible, in the multilevel scheme of METIS
+ * (Karypis and Kumar):
+ * - coarsening: the graph is contracted along a heavy-edge matching, level after
+ *   level, until it has about PARTITION_COARSEST_PER_PART k vertices. The matching
+ *   (each vertex proposes its heaviest neighbour, mutual proposals are matched)
+ *   and the contraction run in parallel on the thread pool;
+ * - initial partition: the coarsest graph is split by recursive bisection, each
+ *   half being grown greedily from a seed, adding the neighbour that reduces the
+ *   cut the most (the best of several seeds);
+ * - uncoarsening: the partition is projected back level by level and refined at
+ *   each level, first by parallel greedy passes moving the boundary vertices with
+ *   a positive gain, then by a k-way Fiduccia-Mattheyses pass, which also accepts
+ *   negative gains to leave local minima and keeps the best partition seen.
+ *
+ * The partitioned graph is the underlying simple undirected graph: the direction,
+ * the weights and the multiplicity of the edges are ignored, and the edge cut
+ * counts the pairs of adjacent vertices lying in different parts.
+ *
+ * The partition vector gives the part of each vertex, for instance the shard of a
+ * process; `partition_permutation` numbers the vertices part by part, so that the
+ * vertices of a part are stored in one block.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include "graph_list.h"
+#include "thread_pool.h"
+
+/** @brief Number of vertices per part where the coarsening stops. */
+#define PARTITION_COARSEST_PER_PART 20
+
+/**
+ * @brief Structure representing a partition of the vertices.
+ */
+typedef struct {
+  int nb_vertices;     /**< Number of vertices */
+  int nb_parts;        /**< Number of parts */
+  int *part;           /**< Part of each vertex (nb_vertices entries) */
+  int *part_size;      /**< Number of vertices of each part (nb_parts entries) */
+  long long nb_edges;  /**< Number of edges of the underlying simple undirected graph */
+  long long edge_cut;  /**< Number of these edges between two parts */
+  int nb_boundary;     /**< Number of vertices having a neighbour in another part */
+  int nb_levels;       /**< Number of graphs of the multilevel hierarchy (1 without coarsening) */
+} partition_s;
+
+/**
+ * @brief Partitions the vertices of a graph into parts of nearly equal sizes.
+ *
+ * @param g The graph.
+ * @param nb_parts The number of parts (1 to the number of vertices).
+ * @param imbalance The tolerated imbalance: each part has at most
+ *        (1 + imbalance) nb_vertices / nb_parts vertices (rounded up).
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the partition.
+ */
+partition_s *partition_create(graph_s *g, int nb_parts, double imbalance, thread_pool_s *pool);
+
+/**
+ * @brief Computes the edge cut and the part sizes of a partition vector.
+ *
+ * Used to evaluate a given partition, such as a split into ranges of indices.
+ *
+ * @param g The graph.
+ * @param nb_parts The number of parts.
+ * @param part The part of each vertex (copied).
+ * @return Pointer to the partition (nb_levels is 0).
+ */
+partition_s *partition_from_vector(graph_s *g, int nb_parts, const int *part);
+
+/**
+ * @brief Gets the largest part size relative to the average one.
+ *
+ * @param p The partition.
+ * @return The ratio (1.0 for a perfectly balanced partition).
+ */
+double partition_imbalance(const partition_s *p);
+
+/**
+ * @brief Numbers the vertices part by part.
+ *
+ * The vertices of the part 0 come first, then those of the part 1, etc., in their
+ * original order inside each part.
+ *
+ * @param p The partition.
+ * @return The new index of each vertex (nb_vertices entries, to free).
+ */
+int *partition_permutation(const partition_s *p);
+
+/**
+ * @brief Writes the partition vector, one part per line (the format of METIS).
+ *
+ * @param p The partition.
+ * @param filename The file to write.
+ * @return false if the file cannot be written.
+ */
+bool partition_save(const partition_s *p, const char *filename);
+
+/**
+ * @brief Deletes a partition.
+ *
+ * @param p The partition.
+ */
+void partition_delete(partition_s *p);
+
+#endif // PARTITION_H
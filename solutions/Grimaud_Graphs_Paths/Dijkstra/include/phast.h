@@ -0,0 +1,89 @@
+/**
+ * @file phast.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief PHAST one-to-all shortest path distances on a vertex hierarchy.
+ *
+ * This file declares a one-to-all query engine based on PHAST (Delling, Goldberg,
+ * Nowatzyk and Werneck). A preprocessing step ranks the vertices by contracting
+ * them one after the other, adding shortcut edges that preserve the distances
+ * between the remaining vertices (a contraction hierarchy). A query then runs in
+ * two phases:
+ * - an upward Dijkstra search from the source, only following edges towards
+ *   higher ranked vertices (a small search space);
+ * - a linear top-down sweep over all the vertices by decreasing rank, relaxing
+ *   the edges coming from higher ranked vertices.
+ *
+ * The vertices are laid out contiguously by decreasing rank (their position), so
+ * the sweep is a streaming pass over arrays, without any heap.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef PHAST_H
+#define PHAST_H
+
+#include "graph_list.h"
+#include "workspace.h"
+
+/**
+ * @brief Structure representing a preprocessed vertex hierarchy.
+ *
+ * Positions are ranks in decreasing order: position 0 is the most important vertex.
+ * The upward edges leaving the position i are `up_head[up_first[i]]` ... up to
+ * `up_first[i+1]`, the downward edges entering the position i come from
+ * `down_tail[down_first[i]]` ... up to `down_first[i+1]`.
+ */
+typedef struct {
+  int nb_vertices;     /**< Number of vertices */
+  int nb_shortcuts;    /**< Number of shortcut edges added by the preprocessing */
+  int *position;       /**< Position of each vertex */
+  int *vertex;         /**< Vertex at each position */
+  int *up_first;       /**< First upward edge of each position (nb_vertices+1 entries) */
+  int *up_head;        /**< Position of the head of each upward edge */
+  double *up_weight;   /**< Weight of each upward edge */
+  int *down_first;     /**< First downward edge entering each position (nb_vertices+1 entries) */
+  int *down_tail;      /**< Position of the tail of each downward edge */
+  double *down_weight; /**< Weight of each downward edge */
+} phast_s;
+
+/**
+ * @brief Ranks the vertices of a graph and builds its hierarchy.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @return Pointer to the created hierarchy.
+ */
+phast_s *phast_create(graph_s *g);
+
+/**
+ * @brief Computes the distances from a source to all the vertices.
+ *
+ * @param ph The hierarchy.
+ * @param src The source vertex.
+ * @param ws A workspace created for `ph->nb_vertices` vertices (used by the upward search).
+ * @param dist Array of `ph->nb_vertices` distances, filled by position: the distance to
+ *             the vertex v is `dist[ph->position[v]]` (INFINITY if v is unreachable).
+ */
+void phast_query(const phast_s *ph, int src, workspace_s *ws, double *dist);
+
+/**
+ * @brief Deletes a hierarchy and frees its memory.
+ *
+ * @param ph Pointer to the hierarchy.
+ */
+void phast_delete(phast_s *ph);
+
+#endif // PHAST_H
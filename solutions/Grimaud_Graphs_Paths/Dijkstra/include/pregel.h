@@ -0,0 +1,198 @@
+/**
+ * @file pregel.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Vertex-centric bulk-synchronous graph engine (Pregel model).
+ *
+ * This file declares an engine running vertex programs in supersteps, after Pregel
+ * (Malewicz et al.). In each superstep, the compute function is called on every
+ * active vertex with the messages sent to it in the previous superstep; it may
+ * update the value of the vertex, send messages to any vertex (typically along
+ * its edges) and vote to halt. A halted vertex becomes active again when it
+ * receives a message; the run ends when all the vertices have halted and no
+ * message is in flight, or after a maximum number of supersteps.
+ *
+ * The messages sent to a vertex are merged on the fly by a combiner (minimum or
+ * sum), so that each vertex holds one message slot per superstep; the slots are
+ * combined with atomic operations. The active vertices and the vertices having a
+ * message are kept in bitsets, and the supersteps run on the thread pool, each
+ * task handling ranges of 64 vertices (one word of the bitsets). A global sum
+ * aggregator gathers a value over a superstep for the next one.
+ *
+ * The vertex programs of the shortest paths, the connected components and
+ * PageRank are given as examples, in a few lines each.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef PREGEL_H
+#define PREGEL_H
+
+#include <stdbool.h>
+#include "graph_list.h"
+#include "thread_pool.h"
+
+/**
+ * @brief Enumeration of the message combiners.
+ */
+typedef enum {
+  COMBINE_MIN, /**< A vertex receives the smallest of its messages */
+  COMBINE_SUM  /**< A vertex receives the sum of its messages */
+} combiner_e;
+
+/**
+ * @struct pregel_context_s
+ * @brief Structure of a running engine, given to the compute function.
+ */
+typedef struct pregel_context pregel_context_s;
+
+/**
+ * @brief Compute function of a vertex program.
+ *
+ * @param ctx The engine.
+ * @param v The vertex.
+ * @param value The value of the vertex (read and written by the function).
+ * @param message The combined message received (the identity of the combiner if none).
+ * @param has_message true if the vertex received at least one message.
+ * @param arg The argument given to `pregel_run`.
+ */
+typedef void (*pregel_compute_f)(pregel_context_s *ctx, int v, double *value, double message, bool has_message,
+                                 void *arg);
+
+/**
+ * @brief Structure reporting the work of a run.
+ */
+typedef struct {
+  int nb_supersteps;     /**< Number of supersteps run */
+  long long nb_messages; /**< Number of messages sent (before combination) */
+  long long nb_computes; /**< Number of calls of the compute function */
+} pregel_stats_s;
+
+/**
+ * @brief Runs a vertex program.
+ *
+ * All the vertices are active in the first superstep.
+ *
+ * @param g The graph.
+ * @param combiner The combiner of the messages.
+ * @param compute The compute function.
+ * @param arg The argument given to the compute function.
+ * @param values The value of each vertex, initialized by the caller (nb_vertices entries).
+ * @param max_supersteps The maximum number of supersteps.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_run(graph_s *g, combiner_e combiner, pregel_compute_f compute, void *arg, double *values,
+                int max_supersteps, thread_pool_s *pool, pregel_stats_s *stats);
+
+/**
+ * @brief Gets the graph of a running engine.
+ *
+ * @param ctx The engine.
+ * @return The graph.
+ */
+graph_s *pregel_graph(const pregel_context_s *ctx);
+
+/**
+ * @brief Gets the index of the current superstep (0 for the first one).
+ *
+ * @param ctx The engine.
+ * @return The superstep.
+ */
+int pregel_superstep(const pregel_context_s *ctx);
+
+/**
+ * @brief Gets the number of edges leaving a vertex.
+ *
+ * @param ctx The engine.
+ * @param v The vertex.
+ * @return The out-degree of the vertex.
+ */
+int pregel_out_degree(const pregel_context_s *ctx, int v);
+
+/**
+ * @brief Sends a message, received in the next superstep.
+ *
+ * @param ctx The engine.
+ * @param dst The vertex receiving the message.
+ * @param message The message.
+ */
+void pregel_send(pregel_context_s *ctx, int dst, double message);
+
+/**
+ * @brief Deactivates a vertex until it receives a message.
+ *
+ * @param ctx The engine.
+ * @param v The vertex (the one being computed).
+ */
+void pregel_vote_to_halt(pregel_context_s *ctx, int v);
+
+/**
+ * @brief Adds a value to the aggregator of the current superstep.
+ *
+ * @param ctx The engine.
+ * @param x The value.
+ */
+void pregel_aggregate(pregel_context_s *ctx, double x);
+
+/**
+ * @brief Gets the sum aggregated during the previous superstep.
+ *
+ * @param ctx The engine.
+ * @return The sum (0 in the first superstep).
+ */
+double pregel_aggregated(const pregel_context_s *ctx);
+
+/**
+ * @brief Computes the shortest path distances from a source (vertex program).
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param dist Receives the distance of each vertex (INFINITY if unreachable).
+ * @param pool The thread pool.
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_sssp(graph_s *g, int src, double *dist, thread_pool_s *pool, pregel_stats_s *stats);
+
+/**
+ * @brief Labels the connected components (vertex program).
+ *
+ * Each vertex gets the smallest index of its component. The labels only follow
+ * the out-edges, so the graph must be undirected.
+ *
+ * @param g The graph (undirected).
+ * @param label Receives the label of each vertex.
+ * @param pool The thread pool.
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_components(graph_s *g, double *label, thread_pool_s *pool, pregel_stats_s *stats);
+
+/**
+ * @brief Computes the PageRank of the vertices (vertex program).
+ *
+ * The rank of the vertices without out-edges is spread over all the vertices.
+ *
+ * @param g The graph.
+ * @param damping The damping factor (usually 0.85).
+ * @param nb_iterations The number of iterations.
+ * @param rank Receives the rank of each vertex (the ranks sum to 1).
+ * @param pool The thread pool.
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_pagerank(graph_s *g, double damping, int nb_iterations, double *rank, thread_pool_s *pool,
+                     pregel_stats_s *stats);
+
+#endif // PREGEL_H
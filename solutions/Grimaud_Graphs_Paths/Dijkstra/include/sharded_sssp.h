@@ -0,0 +1,101 @@
+/**
+ * @file sharded_sssp.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Shortest paths computed by processes owning shards of the graph.
+ *
+ * This file declares a distributed single-source shortest path search that runs
+ * entirely on one host: the vertices are split into shards (for instance by the
+ * partitioner of `partition.h`), and each shard is owned by a separate process,
+ * forked by the coordinator (the calling process). Right after the fork, a process
+ * frees the graph it inherited; the coordinator then streams to it, over its
+ * socket, its vertices, their edges and the ghosts (the vertices of other shards
+ * its edges point to). Once the shards are created, the caller may delete the
+ * graph: the coordinator only keeps the shard and the index in its shard of each
+ * vertex, and the processes only their shard.
+ *
+ * The search is a bulk-synchronous delta-stepping. At each step, the coordinator
+ * sends a bound to every process; each process settles its vertices below the
+ * bound with a local Dijkstra loop, relaxing its local edges at once and keeping,
+ * for each ghost, the best distance found. The improvements of the ghosts are then
+ * sent in one batch per pair of processes over Unix sockets, each process applies
+ * the batches it receives and reports its smallest pending distance. The bound
+ * stays the same while a pending distance lies below it, then moves to the bucket
+ * of width delta holding the smallest pending distance; the search stops when no
+ * distance is pending.
+ *
+ * The final distances and predecessors are written by the processes to a shared
+ * anonymous mapping.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef SHARDED_SSSP_H
+#define SHARDED_SSSP_H
+
+#include "graph_list.h"
+
+/**
+ * @brief Structure reporting the work of a sharded search.
+ */
+typedef struct {
+  int nb_steps;           /**< Number of bulk-synchronous steps */
+  long long nb_messages;  /**< Number of distance updates sent between the processes */
+  long long nb_bytes;     /**< Number of bytes sent between the processes (batch headers included) */
+  int largest_shard;      /**< Largest number of vertices of a shard */
+  int largest_ghosts;     /**< Largest number of ghosts of a shard */
+} sharded_stats_s;
+
+/**
+ * @struct sharded_s
+ * @brief Structure of the shard processes and of their coordinator.
+ */
+typedef struct sharded sharded_s;
+
+/**
+ * @brief Forks one process per shard and sends each one its part of the graph.
+ *
+ * The graph is not used anymore once the function returns.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param owner The shard of each vertex (0 to nb_shards-1).
+ * @param nb_shards The number of shards, hence of processes.
+ * @return Pointer to the shard processes, or NULL if a process or a socket could not
+ *         be created.
+ */
+sharded_s *sharded_create(graph_s *g, const int *owner, int nb_shards);
+
+/**
+ * @brief Computes the shortest paths from a source with the shard processes.
+ *
+ * @param sh The shard processes.
+ * @param src The source vertex.
+ * @param delta The width of the distance buckets (INFINITY: one bucket, the steps
+ *        then being rounds of a Bellman-Ford search).
+ * @param stats Receives the statistics of the search (may be NULL).
+ * @return An array of vertices with the shortest path information, as `dijkstra()`,
+ *         or NULL if a process failed.
+ */
+vertex_s *sharded_search(sharded_s *sh, int src, double delta, sharded_stats_s *stats);
+
+/**
+ * @brief Stops the shard processes and frees the coordinator.
+ *
+ * @param sh Pointer to the shard processes (may be NULL).
+ */
+void sharded_delete(sharded_s *sh);
+
+#endif // SHARDED_SSSP_H
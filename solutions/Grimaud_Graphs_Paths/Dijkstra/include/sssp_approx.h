@@ -0,0 +1,125 @@
+/**
+ * @file sssp_approx.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief (1+ε)-approximate shortest path distances with rounded weights and bucket queues.
+ *
+ * This file declares a one-to-all search trading a bounded error for speed. The
+ * weights of a CSR graph are rounded up once, so that each rounded weight w' of an
+ * edge of weight w satisfies w <= w' <= (1+ε) w, then the searches run Dijkstra's
+ * algorithm on the rounded weights with a bucket queue instead of a binary heap:
+ * - with the integer grid rounding, the weights are rounded up to multiples of the
+ *   unit ε times the smallest positive weight, and the queue is Dial's circular
+ *   array of buckets, one per unit of distance (O(1) per operation);
+ * - with the geometric rounding, the weights are rounded up to the smallest positive
+ *   weight times a power of (1+ε). The edges of the same rounded weight form a
+ *   bucket: a FIFO queue whose keys are sorted, since the vertices are settled by
+ *   increasing distance. The queue only compares the heads of the buckets, whose
+ *   number is logarithmic in the ratio of the largest to the smallest weight.
+ *
+ * The path found to each vertex is a shortest path for the rounded weights, so its
+ * length (reported with the original weights) is at most (1+ε) times the distance.
+ * The grid rounding needs (ε times the weight ratio) buckets, and is refused beyond
+ * SSSP_APPROX_MAX_BUCKETS; the geometric rounding suits the wide weight ranges.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef SSSP_APPROX_H
+#define SSSP_APPROX_H
+
+#include <stdbool.h>
+#include "graph_csr.h"
+#include "heap.h"
+
+/** @brief Largest number of buckets of the integer grid rounding. */
+#define SSSP_APPROX_MAX_BUCKETS (1 << 24)
+
+/**
+ * @brief Roundings of the weights of the approximate searches.
+ */
+typedef enum {
+  ROUND_GRID,     /**< Multiples of a unit, searched with Dial's circular buckets */
+  ROUND_GEOMETRIC /**< Powers of (1+ε), searched with one FIFO bucket per rounded weight */
+} rounding_e;
+
+/**
+ * @brief Structure representing a graph prepared for approximate searches.
+ *
+ * The rounded weight of the edge e is `level[e] * unit` with the grid rounding, and
+ * `class_weight[level[e]]` with the geometric rounding.
+ */
+typedef struct {
+  const graph_csr_s *csr; /**< The graph (not owned) */
+  rounding_e rounding;    /**< Rounding of the weights */
+  double epsilon;         /**< Bound of the relative error */
+  double unit;            /**< Unit of the grid rounding (ε times the smallest positive weight) */
+  int *level;             /**< Rounded weight of each edge: number of units or weight class */
+  int nb_buckets;         /**< Number of buckets: circular array or weight classes */
+  int *bucket;            /**< Grid: first vertex of each bucket (-1 if empty) */
+  int *next;              /**< Grid: next vertex in the bucket of each vertex */
+  int *previous;          /**< Grid: previous vertex in the bucket of each vertex (-1 for the first) */
+  double *class_weight;   /**< Geometric: rounded weight of each class */
+  int *class_first;       /**< Geometric: first entry of each class (nb_buckets+1 entries) */
+  int *class_head;        /**< Geometric: next entry to pop in each class */
+  int *class_tail;        /**< Geometric: next free entry in each class */
+  int *entry_vertex;      /**< Geometric: vertex of each queued entry (one per edge) */
+  double *entry_key;      /**< Geometric: rounded distance of each queued entry */
+  heap_s *classes;        /**< Geometric: non empty classes by the key of their head */
+  double *key;            /**< Rounded distance of each vertex (units for the grid rounding) */
+  bool *settled;          /**< Settled vertices */
+} sssp_approx_s;
+
+/**
+ * @brief Parses the name of a rounding.
+ *
+ * @param str The name: "grid" or "geometric".
+ * @param rounding Address where the rounding is stored.
+ * @return false if the name is unknown.
+ */
+bool sssp_approx_parse_rounding(const char *str, rounding_e *rounding);
+
+/**
+ * @brief Rounds the weights of a graph for approximate searches.
+ *
+ * @param csr The CSR graph (the weights must be non negative), kept until the deletion.
+ * @param epsilon The bound of the relative error (positive).
+ * @param rounding The rounding of the weights.
+ * @return Pointer to the prepared graph, NULL if the grid rounding needs more than
+ *         SSSP_APPROX_MAX_BUCKETS buckets.
+ */
+sssp_approx_s *sssp_approx_create(const graph_csr_s *csr, double epsilon, rounding_e rounding);
+
+/**
+ * @brief Computes (1+ε)-approximate distances from a source to all the vertices.
+ *
+ * The searches use the buffers of the prepared graph: they may not run concurrently.
+ *
+ * @param a The prepared graph.
+ * @param src The source vertex.
+ * @param dst Array of `csr->nb_vertices` vertices, filled with the length of the path
+ *            found to each vertex (INFINITY if unreachable) and its predecessor.
+ */
+void sssp_approx_query(sssp_approx_s *a, int src, vertex_s *dst);
+
+/**
+ * @brief Deletes a prepared graph and frees its memory (the CSR graph is kept).
+ *
+ * @param a Pointer to the prepared graph.
+ */
+void sssp_approx_delete(sssp_approx_s *a);
+
+#endif // SSSP_APPROX_H
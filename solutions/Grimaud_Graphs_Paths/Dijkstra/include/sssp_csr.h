@@ -0,0 +1,85 @@
+/**
+ * @file sssp_csr.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Dijkstra searches on a CSR graph with an optional prefetching relaxation loop.
+ *
+ * This file declares a Dijkstra search reading a CSR graph (see `graph_csr.h`) and
+ * keeping its labels in a workspace (see `workspace.h`). On large graphs the search
+ * is bound by memory latency: each edge leads to a random access to the labels of
+ * its head. The prefetching relaxation loop looks a few edges ahead and asks the
+ * processor to load the labels of the upcoming heads while the current edge is
+ * relaxed, and it loads the adjacency range of the vertex likely to be popped next
+ * (the top of the heap) before it is popped.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef SSSP_CSR_H
+#define SSSP_CSR_H
+
+#include <stdbool.h>
+#include "graph_csr.h"
+#include "workspace.h"
+
+/** @brief Number of edges the prefetching relaxation loop looks ahead. */
+#define PREFETCH_DISTANCE 8
+
+/**
+ * @brief Relaxation loops of the CSR Dijkstra search.
+ */
+typedef enum {
+  RELAX_PLAIN,   /**< Relaxes the edges in order, without any hint */
+  RELAX_PREFETCH /**< Prefetches the labels of the heads PREFETCH_DISTANCE edges ahead */
+} relax_e;
+
+/**
+ * @brief Parses the name of a relaxation loop.
+ *
+ * @param str The name: "plain" or "prefetch".
+ * @param relax Address where the relaxation loop is stored.
+ * @return false if the name is unknown.
+ */
+bool sssp_csr_parse_relax(const char *str, relax_e *relax);
+
+/**
+ * @brief Computes the distances from a source to all the vertices of a CSR graph.
+ *
+ * The distances and predecessors are left in the workspace (see `workspace_dist`).
+ *
+ * @param csr The CSR graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param relax The relaxation loop.
+ * @param ws A workspace created for `csr->nb_vertices` vertices.
+ */
+void dijkstra_csr(const graph_csr_s *csr, int src, relax_e relax, workspace_s *ws);
+
+/**
+ * @brief Computes the distances from all the vertices to a target (many-to-one).
+ *
+ * The search runs backward from the target on the transpose of the graph. The
+ * workspace then holds, for each vertex, its distance to the target and, as its
+ * predecessor, the next vertex of its shortest path to the target.
+ *
+ * @param transpose The transpose of the CSR graph (see `graph_csr_transpose_parallel`),
+ * or the graph itself if it is undirected.
+ * @param dst The target vertex.
+ * @param relax The relaxation loop.
+ * @param ws A workspace created for `transpose->nb_vertices` vertices.
+ */
+void dijkstra_csr_to(const graph_csr_s *transpose, int dst, relax_e relax, workspace_s *ws);
+
+#endif // SSSP_CSR_H
@@ -0,0 +1,108 @@
+/**
+ * @file sssp_engine.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Dijkstra engine written once and specialized for each graph backend.
+ *
+ * This file defines the macro `SSSP_ENGINE`, which generates a Dijkstra search for
+ * a graph backend. A backend is a graph type with a `nb_vertices` field and an
+ * edge iteration macro of the form
+ *
+ *     FOREACH_EDGE(g, u, v, w, body)
+ *
+ * executing `body` for each edge leaving the vertex `u` of the graph `g`, with
+ * its head in the int variable `v` and its weight in the double variable `w`.
+ * The backends are `GRAPH_LIST_FOREACH_EDGE` (adjacency lists, `graph_list.h`),
+ * `GRAPH_CSR_FOREACH_EDGE` (CSR graphs, `graph_csr.h`) and
+ * `IMPLICIT_GRAPH_FOREACH_EDGE` (neighbours generated by a callback,
+ * `implicit_graph.h`). As the iteration is expanded inside the loop of the
+ * engine, the compiler sees a plain loop over the edges of each backend: there is
+ * no call per edge.
+ *
+ * The macro `EDGE_COST(w)` turns an edge weight into the non negative cost added
+ * to the distance: `SSSP_WEIGHT` for plain weights, or `-log(w)` for the
+ * probabilities of a Markov chain (the most probable path is then the shortest).
+ *
+ * The generated function is static: instantiate the engine in the file using it.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef SSSP_ENGINE_H
+#define SSSP_ENGINE_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <assert.h>
+#include "graph_list.h"
+#include "heap.h"
+
+/** @brief Edge cost of the plain shortest paths: the weight itself. */
+#define SSSP_WEIGHT(w) (w)
+
+/**
+ * @brief Generates a Dijkstra search for a graph backend.
+ *
+ * The generated function has the prototype
+ *
+ *     static vertex_s *name(graph_t g, int src, int dst);
+ *
+ * It returns a dynamically allocated array of `g->nb_vertices` vertices holding the
+ * distance (sum of the edge costs, INFINITY if not reached) and the predecessor of
+ * each vertex. The search stops when the vertex `dst` is settled (-1 to settle all
+ * the vertices), so only the part of the graph closer than the target is generated.
+ * The distances, the settled flags and the heap are nevertheless allocated for all
+ * the `g->nb_vertices` vertices: on an implicit graph, the edges are saved, not the
+ * memory per vertex.
+ *
+ * @param name Name of the generated function.
+ * @param graph_t Type of the graph argument.
+ * @param FOREACH_EDGE Edge iteration macro of the backend.
+ * @param EDGE_COST Macro giving the cost of an edge from its weight.
+ */
+#define SSSP_ENGINE(name, graph_t, FOREACH_EDGE, EDGE_COST)                      \
+  static vertex_s *name(graph_t g, int src, int dst) {                             \
+    int nb_vertices_ = g->nb_vertices;                                             \
+    assert(src >= 0 && src < nb_vertices_);                                        \
+    vertex_s *dist_ = malloc(nb_vertices_*sizeof(vertex_s));                       \
+    bool *settled_ = calloc(nb_vertices_, sizeof(bool));                           \
+    assert(dist_!=NULL && settled_!=NULL);                                         \
+    for (int i_ = 0; i_ < nb_vertices_; i_++)                                      \
+      dist_[i_] = (vertex_s){.ind = i_, .weight = INFINITY, .prev = -1};           \
+    heap_s *q_ = heap_create(nb_vertices_);                                        \
+    dist_[src].weight = 0.0;                                                       \
+    q_ = heap_add(dist_[src], q_);                                                 \
+    while (!heap_empty(q_)) {                                                      \
+      vertex_s u_ = heap_peek(q_);                                                 \
+      q_ = heap_remove(q_);                                                        \
+      settled_[u_.ind] = true;                                                     \
+      if (u_.ind == dst) break;                                                    \
+      FOREACH_EDGE(g, u_.ind, v_, w_, {                                            \
+        double d_ = u_.weight + EDGE_COST(w_);                                     \
+        if (!settled_[v_] && d_ < dist_[v_].weight) {                              \
+          dist_[v_].weight = d_;                                                   \
+          dist_[v_].prev = u_.ind;                                                 \
+          q_ = heap_add(dist_[v_], q_);                                            \
+        }                                                                          \
+      });                                                                          \
+    }                                                                              \
+    heap_delete(q_);                                                               \
+    free(settled_);                                                                \
+    return dist_;                                                                  \
+  }
+
+#endif // SSSP_ENGINE_H
@@ -0,0 +1,50 @@
+/**
+ * @file voronoi.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Multi-source Dijkstra and graph Voronoi partitioning.
+ *
+ * This file declares a multi-source variant of Dijkstra's algorithm: a set of seed
+ * vertices all start at distance 0 in the same heap. A single pass assigns to every
+ * vertex its nearest seed, its distance to that seed and its predecessor on the
+ * corresponding shortest path. The cells of vertices sharing the same nearest seed
+ * form the Voronoi partition of the graph.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef VORONOI_H
+#define VORONOI_H
+
+#include "graph_list.h"
+
+/**
+ * @brief Performs Dijkstra's algorithm from several seed vertices at once.
+ *
+ * Every seed starts at distance 0 in one heap, so the whole graph is processed in
+ * a single O(E log V) pass instead of one `dijkstra()` per seed.
+ *
+ * @param g The graph.
+ * @param seeds Array of seed vertices.
+ * @param nb_seeds Number of seed vertices.
+ * @param nearest Array of `g->nb_vertices` integers filled with the nearest seed of
+ *                each vertex (-1 if no seed reaches the vertex), may be NULL.
+ * @return An array of vertices with the shortest path information (the `prev` of a
+ *         seed is -1, so `print_path` stops on the nearest seed).
+ */
+vertex_s *dijkstra_multi(graph_s *g, const int *seeds, int nb_seeds, int *nearest);
+
+#endif // VORONOI_H
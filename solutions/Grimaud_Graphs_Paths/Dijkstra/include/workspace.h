@@ -0,0 +1,141 @@
+/**
+ * @file workspace.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Reusable workspace for repeated Dijkstra searches.
+ *
+ * A workspace gathers the arrays needed by a Dijkstra search (tentative distances,
+ * predecessors, heap and list of settled vertices). It is allocated once for a graph
+ * and reused from one search to the next: instead of clearing V entries, each entry
+ * is stamped with the epoch of the search that wrote it, so a reset costs O(1) plus
+ * the size of the heap left by an interrupted search. The cost of a bounded search
+ * is then proportional to the part of the graph it explores.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <stdbool.h>
+#include <math.h>
+#include "graph_list.h"
+#include "heap.h"
+
+/**
+ * @brief Structure representing a reusable Dijkstra workspace.
+ */
+typedef struct {
+  int nb_vertices;        /**< Number of vertices of the graphs searched with this workspace */
+  unsigned int epoch;     /**< Identifier of the current search */
+  unsigned int *reached;  /**< Epoch of the last search that reached each vertex */
+  unsigned int *settled;  /**< Epoch of the last search that settled each vertex */
+  double *dist;           /**< Tentative distances (valid if reached[v] == epoch) */
+  int *prev;              /**< Tentative predecessors (valid if reached[v] == epoch) */
+  heap_s *q;              /**< Heap of the vertices to visit */
+  vertex_s *settled_list; /**< Vertices settled by the current search, in settling order */
+  int nb_settled;         /**< Number of vertices settled by the current search */
+} workspace_s;
+
+/**
+ * @brief Creates a workspace for graphs of a given number of vertices.
+ *
+ * @param nb_vertices Number of vertices of the graphs.
+ * @return Pointer to the created workspace.
+ */
+workspace_s *workspace_create(int nb_vertices);
+
+/**
+ * @brief Prepares the workspace for a new search.
+ *
+ * @param ws Pointer to the workspace.
+ */
+void workspace_reset(workspace_s *ws);
+
+/**
+ * @brief Deletes a workspace and frees its memory.
+ *
+ * @param ws Pointer to the workspace.
+ */
+void workspace_delete(workspace_s *ws);
+
+/**
+ * @brief Gets the tentative distance of a vertex in the current search.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Index of the vertex.
+ * @return The distance, or INFINITY if the vertex was not reached.
+ */
+static inline double workspace_dist(const workspace_s *ws, int v) {
+  return (ws->reached[v] == ws->epoch) ? ws->dist[v] : INFINITY;
+}
+
+/**
+ * @brief Tests if a vertex is settled in the current search.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Index of the vertex.
+ * @return true if the vertex is settled.
+ */
+static inline bool workspace_is_settled(const workspace_s *ws, int v) {
+  return ws->settled[v] == ws->epoch;
+}
+
+/**
+ * @brief Records a tentative distance and predecessor for a vertex and pushes it in the heap.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Index of the vertex.
+ * @param weight Tentative distance of the vertex.
+ * @param prev Predecessor of the vertex (-1 for the source).
+ */
+void workspace_push(workspace_s *ws, int v, double weight, int prev);
+
+/**
+ * @brief Records a tentative distance for a vertex and pushes it in the heap with another key.
+ *
+ * Used by goal-directed searches (A*), whose heap is ordered by the distance plus an
+ * estimate of the remaining distance. The key of a vertex must grow with its distance.
+ * The vertices popped then carry their key: their distance is `ws->dist[v.ind]`.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Index of the vertex.
+ * @param weight Tentative distance of the vertex.
+ * @param key Key of the vertex in the heap.
+ * @param prev Predecessor of the vertex (-1 for the source).
+ */
+void workspace_push_keyed(workspace_s *ws, int v, double weight, double key, int prev);
+
+/**
+ * @brief Reads the distance of the next vertex to settle without settling it.
+ *
+ * @param ws Pointer to the workspace.
+ * @return The distance of the closest unsettled vertex, or INFINITY if none remains.
+ */
+static inline double workspace_next_weight(workspace_s *ws) {
+  return heap_empty(ws->q) ? INFINITY : heap_peek(ws->q).weight;
+}
+
+/**
+ * @brief Pops the closest unsettled vertex and settles it.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Address where the settled vertex is stored.
+ * @return false if no vertex remains to visit.
+ */
+bool workspace_pop(workspace_s *ws, vertex_s *v);
+
+#endif // WORKSPACE_H
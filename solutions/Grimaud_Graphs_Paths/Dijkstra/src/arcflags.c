@@ -0,0 +1,196 @@
+/**
+ * @file arcflags.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Arc flags for goal-directed point-to-point searches.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "arcflags.h"
+#include "voronoi.h"
+#include "sssp_csr.h"
+#include "numa_alloc.h"
+
+/** @brief Relative tolerance of the test of an edge on a shortest path (extra flags are harmless). */
+#define ARCFLAGS_TOLERANCE 1e-12
+
+/**
+ * @brief Structure shared by the backward searches of the preprocessing.
+ */
+typedef struct {
+  const arcflags_s *af;         /**< The arc flags being computed */
+  const graph_csr_s *transpose; /**< The transpose graph */
+  const int *boundary;          /**< The boundary vertices */
+  workspace_s **ws;             /**< One workspace per worker */
+} flags_task_s;
+
+/**
+ * @brief Flags the edges of the shortest paths to the boundary vertices [lo, hi).
+ *
+ * After the backward search from b, the edge (u, v) is on a shortest path to b when
+ * d(u, b) = w(u, v) + d(v, b).
+ */
+static void flags_body(int lo, int hi, void *arg) {
+  flags_task_s *t = arg;
+  const graph_csr_s *csr = t->af->csr;
+  int id = thread_pool_worker_id();
+  workspace_s *ws = t->ws[id < 0 ? 0 : id];
+  for (int i = lo; i < hi; i++) {
+    int b = t->boundary[i];
+    uint64_t bit = 1ULL << t->af->region[b];
+    dijkstra_csr(t->transpose, b, RELAX_PREFETCH, ws);
+    for (int j = 0; j < ws->nb_settled; j++) {
+      int u = ws->settled_list[j].ind;
+      double du = ws->settled_list[j].weight;
+      for (int e = csr->first[u]; e < csr->first[u + 1]; e++) {
+        if (__atomic_load_n(&t->af->flags[e], __ATOMIC_RELAXED) & bit) continue;
+        if (csr->weight[e] + workspace_dist(ws, csr->head[e]) <= du * (1.0 + ARCFLAGS_TOLERANCE))
+          __atomic_fetch_or(&t->af->flags[e], bit, __ATOMIC_RELAXED);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Partitions a graph into regions and computes its arc flags.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param nb_regions The number of regions (1 to ARCFLAGS_MAX_REGIONS, at most the number of vertices).
+ * @param pool The thread pool running the backward searches (NULL for a sequential execution).
+ * @return Pointer to the created arc flags.
+ */
+arcflags_s *arcflags_create(graph_s *g, int nb_regions, thread_pool_s *pool) {
+  assert(g!=NULL && nb_regions >= 1 && nb_regions <= ARCFLAGS_MAX_REGIONS && nb_regions <= g->nb_vertices);
+  int n = g->nb_vertices;
+  arcflags_s *af = malloc(sizeof(arcflags_s));
+  assert(af!=NULL);
+  af->csr = graph_csr_create(g);
+  af->nb_regions = nb_regions;
+  af->region = malloc(n * sizeof(int));
+  af->flags = numa_alloc_interleaved(((size_t)af->csr->nb_edges + 1) * sizeof(uint64_t));
+  assert(af->region!=NULL && af->flags!=NULL);
+  // Regions: the Voronoi cells of distinct pseudo-random seeds
+  int *seeds = malloc(nb_regions * sizeof(int));
+  int *seed_region = malloc(n * sizeof(int));
+  assert(seeds!=NULL && seed_region!=NULL);
+  for (int v = 0; v < n; v++)
+    seed_region[v] = -1;
+  unsigned int seed = 1;
+  for (int r = 0; r < nb_regions; r++) {
+    do seeds[r] = rand_r(&seed) % n; while (seed_region[seeds[r]] != -1);
+    seed_region[seeds[r]] = r;
+  }
+  int *nearest = malloc(n * sizeof(int));
+  assert(nearest!=NULL);
+  free(dijkstra_multi(g, seeds, nb_regions, nearest));
+  for (int v = 0; v < n; v++)
+    af->region[v] = (nearest[v] == -1) ? 0 : seed_region[nearest[v]]; // unreachable vertices join the region 0
+  free(nearest);
+  free(seed_region);
+  free(seeds);
+  // The edges inside a region carry its flag, and their heads are not boundary vertices
+  const graph_csr_s *csr = af->csr;
+  bool *is_boundary = calloc(n, sizeof(bool));
+  assert(is_boundary!=NULL);
+  for (int u = 0; u < n; u++) {
+    for (int e = csr->first[u]; e < csr->first[u + 1]; e++) {
+      int v = csr->head[e];
+      if (af->region[u] == af->region[v]) af->flags[e] = 1ULL << af->region[v];
+      else {
+        af->flags[e] = 0;
+        is_boundary[v] = true;
+      }
+    }
+  }
+  int *boundary = malloc(n * sizeof(int));
+  assert(boundary!=NULL);
+  af->nb_boundary = 0;
+  for (int v = 0; v < n; v++)
+    if (is_boundary[v]) boundary[af->nb_boundary++] = v;
+  free(is_boundary);
+  // One backward search per boundary vertex
+  int nb_workers = thread_pool_size(pool);
+  flags_task_s t = {.af = af, .boundary = boundary};
+  graph_csr_s *transpose = graph_csr_transpose_parallel(csr, pool);
+  t.transpose = transpose;
+  t.ws = malloc(nb_workers * sizeof(workspace_s *));
+  assert(t.ws!=NULL);
+  for (int w = 0; w < nb_workers; w++)
+    t.ws[w] = workspace_create(n);
+  thread_pool_parallel_for(pool, 0, af->nb_boundary, 1, flags_body, &t);
+  for (int w = 0; w < nb_workers; w++)
+    workspace_delete(t.ws[w]);
+  free(t.ws);
+  graph_csr_delete(transpose);
+  free(boundary);
+  return af;
+}
+
+/**
+ * @brief Gets the proportion of the flags set.
+ *
+ * @param af The arc flags.
+ * @return The number of bits set divided by the number of edges times the number of regions.
+ */
+double arcflags_density(const arcflags_s *af) {
+  assert(af!=NULL);
+  if (af->csr->nb_edges == 0) return 0.0;
+  double nb_set = 0.0;
+  for (int e = 0; e < af->csr->nb_edges; e++)
+    nb_set += __builtin_popcountll(af->flags[e]);
+  return nb_set / ((double)af->csr->nb_edges * af->nb_regions);
+}
+
+/**
+ * @brief Computes the distance between two vertices with a Dijkstra search stopped at the target.
+ *
+ * @param af The arc flags.
+ * @param src The source vertex.
+ * @param dst The target vertex.
+ * @param prune Only relaxes the edges flagged for the region of the target.
+ * @param ws A workspace created for the vertices of the graph.
+ * @return The distance, INFINITY if the target is unreachable.
+ */
+double arcflags_query(const arcflags_s *af, int src, int dst, bool prune, workspace_s *ws) {
+  assert(af!=NULL && ws!=NULL && ws->nb_vertices >= af->csr->nb_vertices);
+  assert(src >= 0 && src < af->csr->nb_vertices && dst >= 0 && dst < af->csr->nb_vertices);
+  const graph_csr_s *csr = af->csr;
+  uint64_t mask = prune ? 1ULL << af->region[dst] : ~0ULL;
+  workspace_reset(ws);
+  workspace_push(ws, src, 0.0, -1);
+  vertex_s v;
+  while (workspace_pop(ws, &v) && v.ind != dst)
+    for (int e = csr->first[v.ind]; e < csr->first[v.ind + 1]; e++)
+      if (af->flags[e] & mask)
+        workspace_push(ws, csr->head[e], v.weight + csr->weight[e], v.ind);
+  return workspace_dist(ws, dst);
+}
+
+/**
+ * @brief Deletes arc flags and frees their memory.
+ *
+ * @param af Pointer to the arc flags.
+ */
+void arcflags_delete(arcflags_s *af) {
+  assert(af!=NULL);
+  numa_free(af->flags, ((size_t)af->csr->nb_edges + 1) * sizeof(uint64_t));
+  graph_csr_delete(af->csr);
+  free(af->region);
+  free(af);
+}
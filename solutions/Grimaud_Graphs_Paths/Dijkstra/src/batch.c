@@ -0,0 +1,102 @@
+/**
+ * @file batch.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Batch of Dijkstra searches running on the thread pool.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "batch.h"
+#include "workspace.h"
+#include "graph_csr.h"
+#include "sssp_csr.h"
+#include "numa_alloc.h"
+
+/**
+ * @brief Structure shared by the tasks of a batch.
+ */
+typedef struct {
+  const graph_csr_s *csr;      /**< The graph, interleaved over the nodes */
+  graph_csr_s **replicas;      /**< Replica of the graph on each node (NULL if none) */
+  const int *sources;          /**< The sources */
+  relax_e relax;               /**< The relaxation loop of the searches */
+  workspace_s **ws;            /**< One workspace per worker */
+  double *dist;                /**< The resulting distances */
+} batch_s;
+
+/**
+ * @brief Runs the Dijkstra searches of the sources [lo, hi).
+ *
+ * The searches read the replica of the graph placed on the node of the worker, if any.
+ */
+static void batch_body(int lo, int hi, void *arg) {
+  batch_s *b = arg;
+  int id = thread_pool_worker_id();
+  workspace_s *ws = b->ws[id < 0 ? 0 : id];
+  const graph_csr_s *csr = b->replicas[numa_current_node()];
+  if (csr == NULL) csr = b->csr;
+  int n = csr->nb_vertices;
+  for (int i = lo; i < hi; i++) {
+    dijkstra_csr(csr, b->sources[i], b->relax, ws);
+    double *row = b->dist + (size_t)i * n;
+    for (int w = 0; w < n; w++)
+      row[w] = workspace_dist(ws, w);
+  }
+}
+
+/**
+ * @brief Computes the distances from several sources to all the vertices.
+ *
+ * The searches run on a CSR copy of the graph interleaved over the memory nodes. On
+ * a NUMA machine, a replica of the copy is also placed on each node having at least
+ * twice its size of free memory, and the workers of a node read their own replica.
+ *
+ * @param g The graph.
+ * @param sources Array of source vertices.
+ * @param nb_sources Number of sources.
+ * @param relax The relaxation loop of the searches.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return A dynamically allocated array of `nb_sources * g->nb_vertices` distances.
+ */
+double *dijkstra_batch(graph_s *g, const int *sources, int nb_sources, relax_e relax, thread_pool_s *pool) {
+  assert(g!=NULL && (sources!=NULL || nb_sources==0));
+  int nb_workers = thread_pool_size(pool);
+  int nb_nodes = numa_nb_nodes();
+  batch_s b = {.sources = sources, .relax = relax};
+  graph_csr_s *csr = graph_csr_create(g);
+  b.csr = csr;
+  b.replicas = calloc(nb_nodes, sizeof(graph_csr_s *));
+  b.dist = malloc(((size_t)nb_sources * g->nb_vertices + 1)*sizeof(double));
+  b.ws = malloc(nb_workers*sizeof(workspace_s *));
+  assert(b.replicas!=NULL && b.dist!=NULL && b.ws!=NULL);
+  for (int node = 0; nb_nodes > 1 && node < nb_nodes; node++)
+    if (numa_node_free(node) >= 2 * graph_csr_size(csr))
+      b.replicas[node] = graph_csr_replicate(csr, node); // NULL if it does not fit after all
+  for (int w = 0; w < nb_workers; w++)
+    b.ws[w] = workspace_create(g->nb_vertices);
+  thread_pool_parallel_for(pool, 0, nb_sources, 1, batch_body, &b);
+  for (int w = 0; w < nb_workers; w++)
+    workspace_delete(b.ws[w]);
+  for (int node = 0; node < nb_nodes; node++)
+    graph_csr_delete(b.replicas[node]);
+  graph_csr_delete(csr);
+  free(b.replicas);
+  free(b.ws);
+  return b.dist;
+}
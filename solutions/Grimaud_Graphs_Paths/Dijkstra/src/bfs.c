@@ -0,0 +1,286 @@
+/**
+ * @file bfs.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Direction-optimizing and multi-source bit-parallel breadth-first searches.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "bfs.h"
+#include "bitset.h"
+#include "numa_alloc.h"
+
+/** @brief A level is expanded bottom-up when its frontier has more than 1/BFS_ALPHA of the unexplored edges. */
+#define BFS_ALPHA 14
+
+/** @brief Back to top-down when the frontier has less than 1/BFS_BETA of the vertices. */
+#define BFS_BETA 24
+
+/**
+ * @brief Computes the hop distances from a source with a direction-optimizing BFS.
+ *
+ * The frontier is kept in a queue. A bottom-up level first copies it in a bitset,
+ * so that each unvisited vertex tests its in-neighbours in constant time.
+ *
+ * @param out The graph.
+ * @param in The transpose of the graph, or the graph itself when it is undirected.
+ * @param src The source vertex.
+ * @param hops Array of `out->nb_vertices` hop distances (-1 for the vertices not reached).
+ * @param nb_bottom_up Address where the number of levels expanded bottom-up is stored (may be NULL).
+ * @return The number of levels (the largest hop distance).
+ */
+int bfs(const graph_csr_s *out, const graph_csr_s *in, int src, int *hops, int *nb_bottom_up) {
+  assert(out!=NULL && in!=NULL && in->nb_vertices==out->nb_vertices && hops!=NULL);
+  int n = out->nb_vertices;
+  assert(src >= 0 && src < n);
+  int *frontier = malloc(n*sizeof(int));
+  int *next = malloc(n*sizeof(int));
+  bitset_s *in_frontier = bitset_create(n);
+  assert(frontier!=NULL && next!=NULL);
+  for (int v = 0; v < n; v++)
+    hops[v] = -1;
+  hops[src] = 0;
+  frontier[0] = src;
+  int nb_frontier = 1;
+  long long edges_frontier = out->first[src + 1] - out->first[src];
+  long long edges_unexplored = out->nb_edges - edges_frontier;
+  bool top_down = true;
+  int level = 0, bottom_up = 0;
+  while (nb_frontier > 0) {
+    if (top_down && edges_frontier > edges_unexplored / BFS_ALPHA)
+      top_down = false;
+    else if (!top_down && nb_frontier < n / BFS_BETA)
+      top_down = true;
+    level++;
+    int nb_next = 0;
+    edges_frontier = 0;
+    if (top_down) {
+      for (int i = 0; i < nb_frontier; i++) {
+        int u = frontier[i];
+        for (int e = out->first[u]; e < out->first[u + 1]; e++) {
+          int w = out->head[e];
+          if (hops[w] < 0) {
+            hops[w] = level;
+            next[nb_next++] = w;
+            edges_frontier += out->first[w + 1] - out->first[w];
+          }
+        }
+      }
+    } else {
+      bitset_clear_all(in_frontier);
+      for (int i = 0; i < nb_frontier; i++)
+        bitset_set(in_frontier, frontier[i]);
+      for (int w = 0; w < n; w++) {
+        if (hops[w] >= 0) continue;
+        for (int e = in->first[w]; e < in->first[w + 1]; e++)
+          if (bitset_test(in_frontier, in->head[e])) {
+            hops[w] = level;
+            next[nb_next++] = w;
+            edges_frontier += out->first[w + 1] - out->first[w];
+            break;
+          }
+      }
+    }
+    if (!top_down && nb_next > 0) bottom_up++;
+    edges_unexplored -= edges_frontier;
+    int *tmp = frontier; frontier = next; next = tmp;
+    nb_frontier = nb_next;
+  }
+  bitset_delete(in_frontier);
+  free(frontier);
+  free(next);
+  if (nb_bottom_up) *nb_bottom_up = bottom_up;
+  return level - 1;
+}
+
+/**
+ * @brief Creates a multi-source BFS workspace for graphs of a given number of vertices.
+ *
+ * @param nb_vertices Number of vertices of the graphs.
+ * @return Pointer to the created workspace.
+ */
+msbfs_s *msbfs_create(int nb_vertices) {
+  msbfs_s *ms = malloc(sizeof(msbfs_s));
+  assert(ms!=NULL);
+  ms->nb_vertices = nb_vertices;
+  // large random access arrays: huge pages on the node of the first search
+  ms->seen = numa_alloc_local((size_t)nb_vertices*sizeof(msbfs_mask_s));
+  ms->visit = numa_alloc_local((size_t)nb_vertices*sizeof(msbfs_mask_s));
+  ms->next = numa_alloc_local((size_t)nb_vertices*sizeof(msbfs_mask_s));
+  assert(ms->seen!=NULL && ms->visit!=NULL && ms->next!=NULL);
+  ms->stats = (hop_stats_s){0, 0, 0};
+  return ms;
+}
+
+/**
+ * @brief Deletes a multi-source BFS workspace and frees its memory.
+ *
+ * @param ms Pointer to the workspace.
+ */
+void msbfs_delete(msbfs_s *ms) {
+  if (!ms) return;
+  numa_free(ms->seen, (size_t)ms->nb_vertices*sizeof(msbfs_mask_s));
+  numa_free(ms->visit, (size_t)ms->nb_vertices*sizeof(msbfs_mask_s));
+  numa_free(ms->next, (size_t)ms->nb_vertices*sizeof(msbfs_mask_s));
+  free(ms);
+}
+
+/**
+ * @brief Tests if a mask has no bit set.
+ *
+ * @param m The mask.
+ * @return true if no bit is set.
+ */
+static inline bool mask_empty(const msbfs_mask_s *m) {
+  uint64_t any = 0;
+  for (int k = 0; k < MSBFS_WORDS; k++)
+    any |= m->w[k];
+  return any == 0;
+}
+
+/**
+ * @brief Computes the hop distances from up to MSBFS_SOURCES sources at once.
+ *
+ * At each level, every vertex reached at the previous level (`visit` not empty)
+ * ors its `visit` mask into the `next` mask of its out-neighbours. Then the bits
+ * of `next` not yet in `seen` are the sources reaching the vertex at this level:
+ * they become its new `visit` mask.
+ *
+ * @param ms The workspace.
+ * @param csr The graph.
+ * @param sources Array of source vertices.
+ * @param nb_sources Number of sources (at most MSBFS_SOURCES).
+ * @param hops Array of `nb_sources * csr->nb_vertices` hop distances, or NULL.
+ */
+void bfs_multi(msbfs_s *ms, const graph_csr_s *csr, const int *sources, int nb_sources, int *hops) {
+  assert(ms!=NULL && csr!=NULL && ms->nb_vertices >= csr->nb_vertices);
+  assert(nb_sources >= 0 && nb_sources <= MSBFS_SOURCES);
+  int n = csr->nb_vertices;
+  msbfs_mask_s *seen = ms->seen, *visit = ms->visit, *next = ms->next;
+  memset(seen, 0, (size_t)n*sizeof(msbfs_mask_s));
+  memset(visit, 0, (size_t)n*sizeof(msbfs_mask_s));
+  memset(next, 0, (size_t)n*sizeof(msbfs_mask_s));
+  if (hops)
+    for (size_t i = 0; i < (size_t)nb_sources * n; i++)
+      hops[i] = -1;
+  for (int i = 0; i < nb_sources; i++) {
+    assert(sources[i] >= 0 && sources[i] < n);
+    seen[sources[i]].w[i >> 6] |= (uint64_t)1 << (i & 63);
+    visit[sources[i]].w[i >> 6] |= (uint64_t)1 << (i & 63);
+    if (hops) hops[(size_t)i * n + sources[i]] = 0;
+  }
+  hop_stats_s stats = {0, 0, 0};
+  bool active = nb_sources > 0;
+  for (int level = 1; active; level++) {
+    for (int v = 0; v < n; v++) {
+      if (mask_empty(&visit[v])) continue;
+      for (int e = csr->first[v]; e < csr->first[v + 1]; e++) {
+        msbfs_mask_s *m = &next[csr->head[e]];
+        for (int k = 0; k < MSBFS_WORDS; k++)
+          m->w[k] |= visit[v].w[k];
+      }
+    }
+    active = false;
+    for (int w = 0; w < n; w++) {
+      msbfs_mask_s fresh;
+      for (int k = 0; k < MSBFS_WORDS; k++) {
+        fresh.w[k] = next[w].w[k] & ~seen[w].w[k];
+        seen[w].w[k] |= fresh.w[k];
+        next[w].w[k] = 0;
+      }
+      visit[w] = fresh;
+      if (mask_empty(&fresh)) continue;
+      active = true;
+      stats.max_hops = level;
+      for (int k = 0; k < MSBFS_WORDS; k++) {
+        int count = __builtin_popcountll(fresh.w[k]);
+        stats.nb_pairs += count;
+        stats.sum_hops += (long long)count * level;
+        for (uint64_t bits = fresh.w[k]; hops && bits; bits &= bits - 1)
+          hops[(size_t)(64 * k + __builtin_ctzll(bits)) * n + w] = level;
+      }
+    }
+  }
+  ms->stats = stats;
+}
+
+/**
+ * @brief Structure shared by the batches of an all-pairs computation.
+ */
+typedef struct {
+  const graph_csr_s *csr; /**< The graph */
+  msbfs_s **ms;           /**< One workspace per worker */
+  hop_stats_s *stats;     /**< Statistics accumulated by each worker */
+} all_pairs_s;
+
+/**
+ * @brief Runs the multi-source searches of the batches [lo, hi).
+ */
+static void all_pairs_body(int lo, int hi, void *arg) {
+  all_pairs_s *a = arg;
+  int id = thread_pool_worker_id();
+  if (id < 0) id = 0;
+  int n = a->csr->nb_vertices;
+  int sources[MSBFS_SOURCES];
+  for (int b = lo; b < hi; b++) {
+    int nb_sources = 0;
+    for (int s = b * MSBFS_SOURCES; s < n && nb_sources < MSBFS_SOURCES; s++)
+      sources[nb_sources++] = s;
+    bfs_multi(a->ms[id], a->csr, sources, nb_sources, NULL);
+    hop_stats_s *acc = &a->stats[id];
+    acc->nb_pairs += a->ms[id]->stats.nb_pairs;
+    acc->sum_hops += a->ms[id]->stats.sum_hops;
+    if (a->ms[id]->stats.max_hops > acc->max_hops) acc->max_hops = a->ms[id]->stats.max_hops;
+  }
+}
+
+/**
+ * @brief Computes the statistics of the hop distances between all the pairs of vertices.
+ *
+ * The sources are cut in batches of MSBFS_SOURCES consecutive vertices, each batch
+ * being a task running one multi-source BFS with the workspace of its worker.
+ *
+ * @param csr The graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return The statistics over all the pairs.
+ */
+hop_stats_s bfs_all_pairs(const graph_csr_s *csr, thread_pool_s *pool) {
+  assert(csr!=NULL);
+  int nb_workers = thread_pool_size(pool);
+  int nb_batches = (csr->nb_vertices + MSBFS_SOURCES - 1) / MSBFS_SOURCES;
+  all_pairs_s a = {.csr = csr};
+  a.ms = malloc(nb_workers*sizeof(msbfs_s *));
+  a.stats = calloc(nb_workers, sizeof(hop_stats_s));
+  assert(a.ms!=NULL && a.stats!=NULL);
+  for (int w = 0; w < nb_workers; w++)
+    a.ms[w] = msbfs_create(csr->nb_vertices);
+  thread_pool_parallel_for(pool, 0, nb_batches, 1, all_pairs_body, &a);
+  hop_stats_s total = {0, 0, 0};
+  for (int w = 0; w < nb_workers; w++) {
+    total.nb_pairs += a.stats[w].nb_pairs;
+    total.sum_hops += a.stats[w].sum_hops;
+    if (a.stats[w].max_hops > total.max_hops) total.max_hops = a.stats[w].max_hops;
+    msbfs_delete(a.ms[w]);
+  }
+  free(a.ms);
+  free(a.stats);
+  return total;
+}
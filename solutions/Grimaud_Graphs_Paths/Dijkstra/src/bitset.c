@@ -0,0 +1,75 @@
+/**
+ * @file bitset.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Compact set of vertices stored as an array of bits.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "bitset.h"
+
+/**
+ * @brief Creates an empty bitset.
+ *
+ * @param nb_bits Number of bits of the set.
+ * @return Pointer to the created bitset.
+ */
+bitset_s *bitset_create(int nb_bits) {
+  bitset_s *b = malloc(sizeof(bitset_s));
+  assert(b!=NULL);
+  b->nb_bits = nb_bits;
+  b->nb_words = (nb_bits + 63) / 64;
+  b->words = calloc(b->nb_words > 0 ? b->nb_words : 1, sizeof(uint64_t));
+  assert(b->words!=NULL);
+  return b;
+}
+
+/**
+ * @brief Deletes a bitset and frees its memory.
+ *
+ * @param b Pointer to the bitset.
+ */
+void bitset_delete(bitset_s *b) {
+  if (!b) return;
+  free(b->words);
+  free(b);
+}
+
+/**
+ * @brief Clears all the bits of a bitset.
+ *
+ * @param b Pointer to the bitset.
+ */
+void bitset_clear_all(bitset_s *b) {
+  memset(b->words, 0, b->nb_words*sizeof(uint64_t));
+}
+
+/**
+ * @brief Counts the bits set in a bitset.
+ *
+ * @param b Pointer to the bitset.
+ * @return The number of bits set.
+ */
+int bitset_count(const bitset_s *b) {
+  int count = 0;
+  for (int i = 0; i < b->nb_words; i++)
+    count += __builtin_popcountll(b->words[i]);
+  return count;
+}
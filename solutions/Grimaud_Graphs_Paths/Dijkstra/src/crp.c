@@ -0,0 +1,420 @@
+/**
+ * @file crp.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Customizable route planning: multi-level overlays with a fast metric customization.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "crp.h"
+#include "numa_alloc.h"
+
+/**
+ * @brief Gets the cell of a vertex at a level.
+ *
+ * @param crp The prepared graph.
+ * @param v The vertex.
+ * @param level The level (at least 1).
+ * @return The index of the cell.
+ */
+static inline int crp_cell(const crp_s *crp, int v, int level) {
+  return crp->leaf[v] >> (CRP_FANOUT_BITS * (level - 1));
+}
+
+/**
+ * @brief Gets the highest level whose cells separate two vertices.
+ *
+ * @param crp The prepared graph.
+ * @param u The first vertex.
+ * @param v The second vertex.
+ * @return The level, 0 if u and v share their leaf cell.
+ */
+static inline int crp_level_apart(const crp_s *crp, int u, int v) {
+  unsigned int x = (unsigned int)(crp->leaf[u] ^ crp->leaf[v]);
+  if (x == 0) return 0;
+  return (31 - __builtin_clz(x)) / CRP_FANOUT_BITS + 1;
+}
+
+/**
+ * @brief Structure holding the buffers of the recursive bisection.
+ */
+typedef struct {
+  crp_s *crp;     /**< The graph being partitioned */
+  int *member;    /**< Identifier of the set being split containing each vertex */
+  int *seen;      /**< Identifier of the last breadth-first search visiting each vertex */
+  int *order;     /**< Visiting order of the last breadth-first search */
+  int nb_sets;    /**< Number of identifiers given to the sets */
+  int nb_visits;  /**< Number of identifiers given to the searches */
+} bisection_s;
+
+/**
+ * @brief Visits a set of vertices in breadth-first order, ignoring the directions of the edges.
+ *
+ * The search starts from a vertex and restarts from the first unvisited vertex of the
+ * set while some remain, so the whole set is ordered in `b->order`.
+ *
+ * @param b The bisection buffers.
+ * @param set The vertices of the set (marked with the identifier `id` in `b->member`).
+ * @param size The number of vertices of the set.
+ * @param start The first vertex visited.
+ * @param id The identifier of the set.
+ */
+static void bfs_order(bisection_s *b, const int *set, int size, int start, int id) {
+  const crp_s *crp = b->crp;
+  const graph_csr_s *csr = crp->csr;
+  int visit = ++b->nb_visits, head = 0, tail = 0, next = 0;
+  b->seen[start] = visit;
+  b->order[tail++] = start;
+  while (head < size) {
+    if (head == tail) {
+      while (b->seen[set[next]] == visit) next++;
+      b->seen[set[next]] = visit;
+      b->order[tail++] = set[next];
+    }
+    int u = b->order[head++];
+    for (int e = csr->first[u]; e < csr->first[u + 1]; e++) {
+      int v = csr->head[e];
+      if (b->member[v] == id && b->seen[v] != visit) {
+        b->seen[v] = visit;
+        b->order[tail++] = v;
+      }
+    }
+    for (int a = crp->tfirst[u]; a < crp->tfirst[u + 1]; a++) {
+      int v = crp->ttail[a];
+      if (b->member[v] == id && b->seen[v] != visit) {
+        b->seen[v] = visit;
+        b->order[tail++] = v;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Splits a set of vertices recursively and numbers the leaf cells.
+ *
+ * Each split orders the set by a breadth-first search from a pseudo-peripheral
+ * vertex (the last one visited by a first search) and cuts the order in halves.
+ *
+ * @param b The bisection buffers.
+ * @param set The vertices of the set, reordered in place.
+ * @param size The number of vertices of the set.
+ * @param depth The number of splits left.
+ * @param leaf The index of the set among the sets of its depth.
+ */
+static void bisect(bisection_s *b, int *set, int size, int depth, int leaf) {
+  if (depth == 0 || size <= 1) {
+    // A set too small to split fills its first leaf cell, the others stay empty
+    for (int i = 0; i < size; i++)
+      b->crp->leaf[set[i]] = leaf << depth;
+    return;
+  }
+  int id = ++b->nb_sets;
+  for (int i = 0; i < size; i++)
+    b->member[set[i]] = id;
+  bfs_order(b, set, size, set[0], id);
+  bfs_order(b, set, size, b->order[size - 1], id);
+  memcpy(set, b->order, size * sizeof(int));
+  bisect(b, set, size / 2, depth - 1, 2 * leaf);
+  bisect(b, set + size / 2, size - size / 2, depth - 1, 2 * leaf + 1);
+}
+
+/**
+ * @brief Finds the boundary vertices of the cells of a level and allocates their cliques.
+ *
+ * @param crp The prepared graph, partitioned.
+ * @param l The level (at least 1).
+ */
+static void build_level(crp_s *crp, int l) {
+  const graph_csr_s *csr = crp->csr;
+  int n = csr->nb_vertices;
+  crp_level_s *level = &crp->levels[l - 1];
+  level->nb_cells = 1 << (CRP_FANOUT_BITS * (crp->nb_levels - l + 1));
+  level->first = calloc(level->nb_cells + 1, sizeof(int));
+  level->index = malloc(n * sizeof(int));
+  assert(level->first!=NULL && level->index!=NULL);
+  for (int u = 0; u < n; u++) {
+    int c = crp_cell(crp, u, l);
+    bool boundary = false;
+    for (int e = csr->first[u]; !boundary && e < csr->first[u + 1]; e++)
+      boundary = crp_cell(crp, csr->head[e], l) != c;
+    for (int a = crp->tfirst[u]; !boundary && a < crp->tfirst[u + 1]; a++)
+      boundary = crp_cell(crp, crp->ttail[a], l) != c;
+    // index[u] temporarily flags the boundary vertices
+    level->index[u] = boundary ? 0 : -1;
+    if (boundary) level->first[c + 1]++;
+  }
+  for (int c = 0; c < level->nb_cells; c++)
+    level->first[c + 1] += level->first[c];
+  level->vertex = malloc((level->first[level->nb_cells] + 1) * sizeof(int));
+  int *next = malloc(level->nb_cells * sizeof(int));
+  assert(level->vertex!=NULL && next!=NULL);
+  memcpy(next, level->first, level->nb_cells * sizeof(int));
+  for (int u = 0; u < n; u++) {
+    if (level->index[u] == -1) continue;
+    int c = crp_cell(crp, u, l);
+    level->index[u] = next[c] - level->first[c];
+    level->vertex[next[c]++] = u;
+  }
+  free(next);
+  level->matrix_first = malloc((level->nb_cells + 1) * sizeof(size_t));
+  assert(level->matrix_first!=NULL);
+  level->matrix_first[0] = 0;
+  for (int c = 0; c < level->nb_cells; c++) {
+    size_t nb = level->first[c + 1] - level->first[c];
+    level->matrix_first[c + 1] = level->matrix_first[c] + nb * nb;
+  }
+  level->matrix = numa_alloc_interleaved((level->matrix_first[level->nb_cells] + 1) * sizeof(double));
+  assert(level->matrix!=NULL);
+}
+
+/**
+ * @brief Partitions a graph and builds the topology of its overlays (metric-independent).
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param nb_levels The number of overlay levels (1 to CRP_MAX_LEVELS).
+ * @return Pointer to the prepared graph, to customize before the queries.
+ */
+crp_s *crp_create(graph_s *g, int nb_levels) {
+  assert(g!=NULL && nb_levels >= 1 && nb_levels <= CRP_MAX_LEVELS);
+  crp_s *crp = calloc(1, sizeof(crp_s));
+  assert(crp!=NULL);
+  crp->csr = graph_csr_create(g);
+  crp->nb_levels = nb_levels;
+  const graph_csr_s *csr = crp->csr;
+  int n = csr->nb_vertices;
+  // Entering edges, pointing to the weights of the CSR copy
+  crp->tfirst = calloc(n + 1, sizeof(int));
+  crp->ttail = malloc((csr->nb_edges + 1) * sizeof(int));
+  crp->tedge = malloc((csr->nb_edges + 1) * sizeof(int));
+  assert(crp->tfirst!=NULL && crp->ttail!=NULL && crp->tedge!=NULL);
+  for (int e = 0; e < csr->nb_edges; e++)
+    crp->tfirst[csr->head[e] + 1]++;
+  for (int v = 0; v < n; v++)
+    crp->tfirst[v + 1] += crp->tfirst[v];
+  int *next = malloc((n + 1) * sizeof(int));
+  assert(next!=NULL);
+  memcpy(next, crp->tfirst, (n + 1) * sizeof(int));
+  for (int u = 0; u < n; u++)
+    for (int e = csr->first[u]; e < csr->first[u + 1]; e++) {
+      int pos = next[csr->head[e]]++;
+      crp->ttail[pos] = u;
+      crp->tedge[pos] = e;
+    }
+  free(next);
+  // Nested partition by recursive bisection
+  crp->leaf = malloc(n * sizeof(int));
+  bisection_s b = {.crp = crp};
+  b.member = calloc(n + 1, sizeof(int));
+  b.seen = calloc(n + 1, sizeof(int));
+  b.order = malloc(n * sizeof(int));
+  int *set = malloc(n * sizeof(int));
+  assert(crp->leaf!=NULL && b.member!=NULL && b.seen!=NULL && b.order!=NULL && set!=NULL);
+  for (int v = 0; v < n; v++)
+    set[v] = v;
+  bisect(&b, set, n, CRP_FANOUT_BITS * nb_levels, 0);
+  free(set);
+  free(b.order);
+  free(b.seen);
+  free(b.member);
+  for (int l = 1; l <= nb_levels; l++)
+    build_level(crp, l);
+  return crp;
+}
+
+/**
+ * @brief Relaxes the arcs of a vertex in the overlay of a level.
+ *
+ * At the level 0, the arcs are the edges of the vertex. At a level k > 0, they are the
+ * clique of its cell (the vertex being a boundary vertex of the level) and its edges
+ * leaving the cell. The clique is skipped when the vertex was reached through the
+ * clique: the cliques hold shortest distances inside the cell, so the predecessor
+ * already reached the other boundary vertices as well.
+ *
+ * @param crp The prepared graph.
+ * @param k The level of the overlay.
+ * @param u The vertex, just settled.
+ * @param du The distance of the vertex.
+ * @param prev The predecessor of the vertex (-1 for the source).
+ * @param backward Follows the arcs backwards.
+ * @param outer The level of the cell the search is restricted to (0 for none).
+ * @param outer_cell The cell the search is restricted to.
+ * @param ws The workspace of the search.
+ */
+static void relax(const crp_s *crp, int k, int u, double du, int prev, bool backward, int outer, int outer_cell, workspace_s *ws) {
+  const graph_csr_s *csr = crp->csr;
+  int lo = backward ? crp->tfirst[u] : csr->first[u];
+  int hi = backward ? crp->tfirst[u + 1] : csr->first[u + 1];
+  int cell = (k > 0) ? crp_cell(crp, u, k) : 0;
+  for (int a = lo; a < hi; a++) {
+    int v = backward ? crp->ttail[a] : csr->head[a];
+    if (k > 0 && crp_cell(crp, v, k) == cell) continue;
+    if (outer > 0 && crp_cell(crp, v, outer) != outer_cell) continue;
+    workspace_push(ws, v, du + csr->weight[backward ? crp->tedge[a] : a], u);
+  }
+  if (k == 0 || (prev != -1 && crp_cell(crp, prev, k) == cell)) return;
+  const crp_level_s *level = &crp->levels[k - 1];
+  int i = level->index[u], nb = level->first[cell + 1] - level->first[cell];
+  assert(i >= 0);
+  const double *m = level->matrix + level->matrix_first[cell];
+  const int *boundary = level->vertex + level->first[cell];
+  for (int j = 0; j < nb; j++) {
+    double w = backward ? m[(size_t)j * nb + i] : m[(size_t)i * nb + j];
+    if (j != i && w != INFINITY)
+      workspace_push(ws, boundary[j], du + w, u);
+  }
+}
+
+/**
+ * @brief Structure shared by the customization tasks of a level.
+ */
+typedef struct {
+  crp_s *crp;       /**< The prepared graph */
+  int l;            /**< The level being customized */
+  workspace_s **ws; /**< One workspace per worker */
+} customize_s;
+
+/**
+ * @brief Computes the cliques of the cells [lo, hi) of a level.
+ *
+ * The searches run on the overlay of the level below, restricted to the cell.
+ */
+static void customize_body(int lo, int hi, void *arg) {
+  customize_s *t = arg;
+  const crp_s *crp = t->crp;
+  crp_level_s *level = &t->crp->levels[t->l - 1];
+  int id = thread_pool_worker_id();
+  workspace_s *ws = t->ws[id < 0 ? 0 : id];
+  for (int c = lo; c < hi; c++) {
+    int nb = level->first[c + 1] - level->first[c];
+    const int *boundary = level->vertex + level->first[c];
+    double *m = level->matrix + level->matrix_first[c];
+    for (int i = 0; i < nb; i++) {
+      workspace_reset(ws);
+      workspace_push(ws, boundary[i], 0.0, -1);
+      vertex_s u;
+      while (workspace_pop(ws, &u))
+        relax(crp, t->l - 1, u.ind, u.weight, u.prev, false, t->l, c, ws);
+      for (int j = 0; j < nb; j++)
+        m[(size_t)i * nb + j] = workspace_dist(ws, boundary[j]);
+    }
+  }
+}
+
+/**
+ * @brief Computes the cliques of all the cells from the current weights.
+ *
+ * @param crp The prepared graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ */
+void crp_customize(crp_s *crp, thread_pool_s *pool) {
+  assert(crp!=NULL);
+  int nb_workers = thread_pool_size(pool);
+  customize_s t = {.crp = crp};
+  t.ws = malloc(nb_workers * sizeof(workspace_s *));
+  assert(t.ws!=NULL);
+  for (int w = 0; w < nb_workers; w++)
+    t.ws[w] = workspace_create(crp->csr->nb_vertices);
+  // Each level is built on the cliques of the level below
+  for (t.l = 1; t.l <= crp->nb_levels; t.l++)
+    thread_pool_parallel_for(pool, 0, crp->levels[t.l - 1].nb_cells, 1, customize_body, &t);
+  for (int w = 0; w < nb_workers; w++)
+    workspace_delete(t.ws[w]);
+  free(t.ws);
+}
+
+/**
+ * @brief Gets the number of shortcut weights of the overlays.
+ *
+ * @param crp The prepared graph.
+ * @return The number of entries of all the cliques.
+ */
+size_t crp_nb_shortcuts(const crp_s *crp) {
+  assert(crp!=NULL);
+  size_t nb = 0;
+  for (int l = 0; l < crp->nb_levels; l++)
+    nb += crp->levels[l].matrix_first[crp->levels[l].nb_cells];
+  return nb;
+}
+
+/**
+ * @brief Computes the distance between two vertices with a bidirectional search.
+ *
+ * The searches alternate by smallest key. A vertex settled by one search and reached
+ * by the other gives a path; the searches stop when the sum of their smallest keys
+ * reaches the shortest of these paths.
+ *
+ * @param crp The prepared graph, customized.
+ * @param src The source vertex.
+ * @param dst The target vertex.
+ * @param use_overlays Searches the overlays.
+ * @param fwd A workspace for the forward search.
+ * @param bwd A workspace for the backward search.
+ * @return The distance, INFINITY if the target is unreachable.
+ */
+double crp_query(const crp_s *crp, int src, int dst, bool use_overlays, workspace_s *fwd, workspace_s *bwd) {
+  assert(crp!=NULL && fwd!=NULL && bwd!=NULL);
+  assert(src >= 0 && src < crp->csr->nb_vertices && dst >= 0 && dst < crp->csr->nb_vertices);
+  workspace_reset(fwd);
+  workspace_reset(bwd);
+  workspace_push(fwd, src, 0.0, -1);
+  workspace_push(bwd, dst, 0.0, -1);
+  double best = (src == dst) ? 0.0 : INFINITY;
+  for (;;) {
+    double kf = workspace_next_weight(fwd), kb = workspace_next_weight(bwd);
+    if (kf + kb >= best) break;
+    bool forward = kf <= kb;
+    workspace_s *ws = forward ? fwd : bwd;
+    const workspace_s *other = forward ? bwd : fwd;
+    vertex_s u;
+    workspace_pop(ws, &u);
+    double through = u.weight + workspace_dist(other, u.ind);
+    if (through < best) best = through;
+    int k = 0;
+    if (use_overlays) {
+      int ks = crp_level_apart(crp, u.ind, src), kt = crp_level_apart(crp, u.ind, dst);
+      k = (ks < kt) ? ks : kt;
+    }
+    relax(crp, k, u.ind, u.weight, u.prev, !forward, 0, 0, ws);
+  }
+  return best;
+}
+
+/**
+ * @brief Deletes a prepared graph and frees its memory.
+ *
+ * @param crp Pointer to the prepared graph.
+ */
+void crp_delete(crp_s *crp) {
+  assert(crp!=NULL);
+  for (int l = 0; l < crp->nb_levels; l++) {
+    crp_level_s *level = &crp->levels[l];
+    numa_free(level->matrix, (level->matrix_first[level->nb_cells] + 1) * sizeof(double));
+    free(level->matrix_first);
+    free(level->vertex);
+    free(level->index);
+    free(level->first);
+  }
+  free(crp->leaf);
+  free(crp->tedge);
+  free(crp->ttail);
+  free(crp->tfirst);
+  graph_csr_delete(crp->csr);
+  free(crp);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file dist_store.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Lock-free shared distance and parent labels.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "dist_store.h"
+
+/**
+ * @brief Creates the labels, all vertices being unreached (distance INFINITY, parent -1).
+ *
+ * @param nb_vertices Number of vertices.
+ * @return Pointer to the created labels.
+ */
+dist_store_s *dist_store_create(int nb_vertices) {
+  dist_store_s *s = malloc(sizeof(dist_store_s));
+  assert(s!=NULL);
+  s->nb_vertices = nb_vertices;
+  s->words = malloc((nb_vertices > 0 ? nb_vertices : 1)*sizeof(uint64_t));
+  assert(s->words!=NULL);
+  uint64_t unreached = dist_store_pack(INFINITY, -1);
+  for (int v = 0; v < nb_vertices; v++)
+    s->words[v] = unreached;
+  return s;
+}
+
+/**
+ * @brief Deletes the labels and frees their memory.
+ *
+ * @param s Pointer to the labels.
+ */
+void dist_store_delete(dist_store_s *s) {
+  if (!s) return;
+  free(s->words);
+  free(s);
+}
@@ -0,0 +1,398 @@
+/**
+ * @file graph_csr.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Compact (CSR) copy of a graph for the read-only engines.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "graph_csr.h"
+#include "numa_alloc.h"
+
+/**
+ * @brief Allocates the arrays of a CSR graph with the given allocator.
+ *
+ * @param nb_vertices Number of vertices.
+ * @param nb_edges Number of edges.
+ * @param node The node of the arrays, or -1 to interleave them.
+ * @return Pointer to the CSR graph, NULL if the memory could not be allocated.
+ */
+static graph_csr_s *graph_csr_alloc(int nb_vertices, int nb_edges, int node) {
+  graph_csr_s *csr = malloc(sizeof(graph_csr_s));
+  assert(csr!=NULL);
+  csr->nb_vertices = nb_vertices;
+  csr->nb_edges = nb_edges;
+  size_t first_size = (size_t)(nb_vertices + 1)*sizeof(int);
+  size_t head_size = (size_t)nb_edges*sizeof(int);
+  size_t weight_size = (size_t)nb_edges*sizeof(double);
+  if (node < 0) {
+    csr->first = numa_alloc_interleaved(first_size);
+    csr->head = numa_alloc_interleaved(head_size);
+    csr->weight = numa_alloc_interleaved(weight_size);
+  } else {
+    csr->first = numa_alloc_onnode(first_size, node);
+    csr->head = numa_alloc_onnode(head_size, node);
+    csr->weight = numa_alloc_onnode(weight_size, node);
+  }
+  if (!csr->first || !csr->head || !csr->weight) {
+    graph_csr_delete(csr);
+    return NULL;
+  }
+  return csr;
+}
+
+/**
+ * @brief Creates the CSR copy of a graph, its arrays being interleaved over the nodes.
+ *
+ * @param g The graph.
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_create(graph_s *g) {
+  assert(g!=NULL);
+  int nb_edges = 0;
+  for (int v = 0; v < g->nb_vertices; v++)
+    for (adj_list_s *adj = get_adj_list(g, v); adj != NULL; adj = adj->next)
+      nb_edges++;
+  graph_csr_s *csr = graph_csr_alloc(g->nb_vertices, nb_edges, -1);
+  assert(csr!=NULL);
+  int e = 0;
+  for (int v = 0; v < g->nb_vertices; v++) {
+    csr->first[v] = e;
+    for (adj_list_s *adj = get_adj_list(g, v); adj != NULL; adj = adj->next) {
+      csr->head[e] = adj->vertex.ind;
+      csr->weight[e] = adj->vertex.weight;
+      e++;
+    }
+  }
+  csr->first[g->nb_vertices] = e;
+  return csr;
+}
+
+/**
+ * @brief Structure shared by the tasks of `graph_csr_create_parallel` and `graph_csr_transpose_parallel`.
+ */
+typedef struct {
+  graph_s *g;             /**< The graph (creation) */
+  const graph_csr_s *csr; /**< The CSR graph (transposition) */
+  graph_csr_s *out;       /**< The CSR graph being built */
+  int *next;              /**< Next free position of the edges entering each vertex (transposition) */
+  int *pos;               /**< Position of each edge of the CSR graph in the transpose (transposition) */
+} csr_build_s;
+
+/**
+ * @brief Counts the edges leaving a range of vertices (task of `graph_csr_create_parallel`).
+ *
+ * @param lo The first vertex.
+ * @param hi The vertex after the last one.
+ * @param arg The csr_build_s structure.
+ */
+static void count_degrees(int lo, int hi, void *arg) {
+  csr_build_s *b = arg;
+  for (int v = lo; v < hi; v++) {
+    int degree = 0;
+    for (adj_list_s *adj = get_adj_list(b->g, v); adj != NULL; adj = adj->next)
+      degree++;
+    b->out->first[v + 1] = degree;
+  }
+}
+
+/**
+ * @brief Copies the edges leaving a range of vertices (task of `graph_csr_create_parallel`).
+ *
+ * @param lo The first vertex.
+ * @param hi The vertex after the last one.
+ * @param arg The csr_build_s structure.
+ */
+static void copy_edges(int lo, int hi, void *arg) {
+  csr_build_s *b = arg;
+  for (int v = lo; v < hi; v++) {
+    int e = b->out->first[v];
+    for (adj_list_s *adj = get_adj_list(b->g, v); adj != NULL; adj = adj->next) {
+      b->out->head[e] = adj->vertex.ind;
+      b->out->weight[e] = adj->vertex.weight;
+      e++;
+    }
+  }
+}
+
+/**
+ * @brief Creates the CSR copy of a graph in parallel, its arrays being interleaved over the nodes.
+ *
+ * @param g The graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_create_parallel(graph_s *g, thread_pool_s *pool) {
+  assert(g!=NULL);
+  int n = g->nb_vertices;
+  int *first = malloc((n + 1)*sizeof(int));
+  assert(first!=NULL);
+  csr_build_s b = {.g = g, .out = &(graph_csr_s){.first = first}};
+  int grain = n / (8 * thread_pool_size(pool)) + 1;
+  first[0] = 0;
+  thread_pool_parallel_for(pool, 0, n, grain, count_degrees, &b);
+  for (int v = 0; v < n; v++)
+    first[v + 1] += first[v];
+  graph_csr_s *csr = graph_csr_alloc(n, first[n], -1);
+  assert(csr!=NULL);
+  memcpy(csr->first, first, (size_t)(n + 1)*sizeof(int));
+  free(first);
+  b.out = csr;
+  thread_pool_parallel_for(pool, 0, n, grain, copy_edges, &b);
+  return csr;
+}
+
+/**
+ * @brief Creates the transpose of a CSR graph, its arrays being interleaved over the nodes.
+ *
+ * The edges are placed by a counting sort on their heads.
+ *
+ * @param csr The CSR graph.
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_transpose(const graph_csr_s *csr) {
+  assert(csr!=NULL);
+  int n = csr->nb_vertices;
+  graph_csr_s *t = graph_csr_alloc(n, csr->nb_edges, -1);
+  assert(t!=NULL);
+  // t->first[w+1] counts the edges entering w, then becomes the position of the next one
+  memset(t->first, 0, (size_t)(n + 1)*sizeof(int));
+  for (int e = 0; e < csr->nb_edges; e++)
+    t->first[csr->head[e] + 1]++;
+  for (int v = 0; v < n; v++)
+    t->first[v + 1] += t->first[v];
+  int *next = malloc((n + 1)*sizeof(int));
+  assert(next!=NULL);
+  memcpy(next, t->first, (size_t)(n + 1)*sizeof(int));
+  for (int v = 0; v < n; v++)
+    for (int e = csr->first[v]; e < csr->first[v + 1]; e++) {
+      int pos = next[csr->head[e]]++;
+      t->head[pos] = v;
+      t->weight[pos] = csr->weight[e];
+    }
+  free(next);
+  return t;
+}
+
+/**
+ * @brief Counts the edges entering the heads of the edges leaving a range of vertices
+ * (task of `graph_csr_transpose_parallel`).
+ *
+ * @param lo The first vertex.
+ * @param hi The vertex after the last one.
+ * @param arg The csr_build_s structure.
+ */
+static void count_in_degrees(int lo, int hi, void *arg) {
+  csr_build_s *b = arg;
+  for (int e = b->csr->first[lo]; e < b->csr->first[hi]; e++)
+    __atomic_fetch_add(&b->out->first[b->csr->head[e] + 1], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Reserves the positions of the edges leaving a range of vertices in the lists
+ * of their heads (task of `graph_csr_transpose_parallel`).
+ *
+ * The positions are taken atomically, so a list is filled in any order. They are
+ * only recorded here: an atomic increment waits for the pending stores, which would
+ * be the random stores of the edges if they were placed in the same loop.
+ *
+ * @param lo The first vertex.
+ * @param hi The vertex after the last one.
+ * @param arg The csr_build_s structure.
+ */
+static void reserve_positions(int lo, int hi, void *arg) {
+  csr_build_s *b = arg;
+  for (int e = b->csr->first[lo]; e < b->csr->first[hi]; e++)
+    b->pos[e] = __atomic_fetch_add(&b->next[b->csr->head[e]], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Places the edges leaving a range of vertices at their positions
+ * (task of `graph_csr_transpose_parallel`).
+ *
+ * @param lo The first vertex.
+ * @param hi The vertex after the last one.
+ * @param arg The csr_build_s structure.
+ */
+static void scatter_edges(int lo, int hi, void *arg) {
+  csr_build_s *b = arg;
+  for (int v = lo; v < hi; v++)
+    for (int e = b->csr->first[v]; e < b->csr->first[v + 1]; e++) {
+      b->out->head[b->pos[e]] = v;
+      b->out->weight[b->pos[e]] = b->csr->weight[e];
+    }
+}
+
+/**
+ * @brief Structure representing an incoming edge, when a long list is sorted.
+ */
+typedef struct {
+  int tail;      /**< Tail of the edge */
+  int rank;      /**< Position of the edge in the list before the sort */
+  double weight; /**< Weight of the edge */
+} in_edge_s;
+
+/**
+ * @brief Compares two incoming edges by tail, then by rank (for qsort).
+ *
+ * @param a Pointer to the first edge.
+ * @param b Pointer to the second edge.
+ * @return A negative, zero or positive value.
+ */
+static int compare_in_edges(const void *a, const void *b) {
+  const in_edge_s *x = a, *y = b;
+  if (x->tail != y->tail) return (x->tail > y->tail) - (x->tail < y->tail);
+  return (x->rank > y->rank) - (x->rank < y->rank);
+}
+
+/**
+ * @brief Sorts a list of incoming edges by tail, keeping the order of the edges of a
+ * same tail (stable sort).
+ *
+ * The lists are usually short and partly sorted: they are sorted by insertion, the
+ * long ones (hubs) by qsort.
+ *
+ * @param tail The tails of the edges.
+ * @param weight The weights of the edges.
+ * @param len The length of the list.
+ */
+static void sort_in_list(int *tail, double *weight, int len) {
+  if (len > 32) {
+    in_edge_s *list = malloc(len * sizeof(in_edge_s));
+    assert(list!=NULL);
+    for (int i = 0; i < len; i++)
+      list[i] = (in_edge_s){tail[i], i, weight[i]};
+    qsort(list, len, sizeof(in_edge_s), compare_in_edges);
+    for (int i = 0; i < len; i++) {
+      tail[i] = list[i].tail;
+      weight[i] = list[i].weight;
+    }
+    free(list);
+    return;
+  }
+  for (int i = 1; i < len; i++) {
+    int x = tail[i], j = i;
+    double w = weight[i];
+    for (; j > 0 && tail[j - 1] > x; j--) {
+      tail[j] = tail[j - 1];
+      weight[j] = weight[j - 1];
+    }
+    tail[j] = x;
+    weight[j] = w;
+  }
+}
+
+/**
+ * @brief Puts the lists of incoming edges of a range of vertices in the order of
+ * `graph_csr_transpose` (task of `graph_csr_transpose_parallel`).
+ *
+ * All the edges of a tail are placed by the same task, in order: a stable sort by
+ * tail restores the order of the sequential counting sort. The lists filled by a
+ * single task are already sorted.
+ *
+ * @param lo The first vertex.
+ * @param hi The vertex after the last one.
+ * @param arg The csr_build_s structure.
+ */
+static void sort_in_edges(int lo, int hi, void *arg) {
+  graph_csr_s *t = ((csr_build_s *)arg)->out;
+  for (int v = lo; v < hi; v++) {
+    int first = t->first[v], len = t->first[v + 1] - first;
+    bool sorted = true;
+    for (int i = 1; sorted && i < len; i++)
+      sorted = t->head[first + i - 1] <= t->head[first + i];
+    if (!sorted)
+      sort_in_list(&t->head[first], &t->weight[first], len);
+  }
+}
+
+/**
+ * @brief Creates the transpose of a CSR graph in parallel, its arrays being interleaved over the nodes.
+ *
+ * The in-degrees are counted and the positions of the edges reserved with atomic
+ * increments, the edges are placed, then the list of each vertex is sorted to get the
+ * same order as the sequential counting sort.
+ *
+ * @param csr The CSR graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created CSR graph.
+ */
+graph_csr_s *graph_csr_transpose_parallel(const graph_csr_s *csr, thread_pool_s *pool) {
+  assert(csr!=NULL);
+  int n = csr->nb_vertices;
+  graph_csr_s *t = graph_csr_alloc(n, csr->nb_edges, -1);
+  assert(t!=NULL);
+  csr_build_s b = {.csr = csr, .out = t};
+  b.next = malloc((n + 1)*sizeof(int));
+  b.pos = malloc((size_t)csr->nb_edges*sizeof(int) + 1);
+  assert(b.next!=NULL && b.pos!=NULL);
+  int grain = n / (8 * thread_pool_size(pool)) + 1;
+  memset(t->first, 0, (size_t)(n + 1)*sizeof(int));
+  thread_pool_parallel_for(pool, 0, n, grain, count_in_degrees, &b);
+  for (int v = 0; v < n; v++)
+    t->first[v + 1] += t->first[v];
+  memcpy(b.next, t->first, (size_t)(n + 1)*sizeof(int));
+  thread_pool_parallel_for(pool, 0, n, grain, reserve_positions, &b);
+  thread_pool_parallel_for(pool, 0, n, grain, scatter_edges, &b);
+  thread_pool_parallel_for(pool, 0, n, grain, sort_in_edges, &b);
+  free(b.pos);
+  free(b.next);
+  return t;
+}
+
+/**
+ * @brief Creates a replica of a CSR graph on a memory node.
+ *
+ * @param csr The CSR graph.
+ * @param node The index of the node.
+ * @return Pointer to the replica, NULL if the memory could not be allocated.
+ */
+graph_csr_s *graph_csr_replicate(const graph_csr_s *csr, int node) {
+  assert(csr!=NULL && node>=0);
+  graph_csr_s *copy = graph_csr_alloc(csr->nb_vertices, csr->nb_edges, node);
+  if (!copy) return NULL;
+  memcpy(copy->first, csr->first, (size_t)(csr->nb_vertices + 1)*sizeof(int));
+  memcpy(copy->head, csr->head, (size_t)csr->nb_edges*sizeof(int));
+  memcpy(copy->weight, csr->weight, (size_t)csr->nb_edges*sizeof(double));
+  return copy;
+}
+
+/**
+ * @brief Gets the memory used by the arrays of a CSR graph.
+ *
+ * @param csr The CSR graph.
+ * @return The size in bytes.
+ */
+size_t graph_csr_size(const graph_csr_s *csr) {
+  return (size_t)(csr->nb_vertices + 1)*sizeof(int) + (size_t)csr->nb_edges*(sizeof(int) + sizeof(double));
+}
+
+/**
+ * @brief Deletes a CSR graph and frees its memory.
+ *
+ * @param csr Pointer to the CSR graph (may be NULL).
+ */
+void graph_csr_delete(graph_csr_s *csr) {
+  if (!csr) return;
+  numa_free(csr->first, (size_t)(csr->nb_vertices + 1)*sizeof(int));
+  numa_free(csr->head, (size_t)csr->nb_edges*sizeof(int));
+  numa_free(csr->weight, (size_t)csr->nb_edges*sizeof(double));
+  free(csr);
+}
@@ -29,6 +29,8 @@
 #include "graph_list.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <assert.h>
+#include "numa_alloc.h"
 
 /**
  * @brief Creates a graph.
@@ -46,6 +48,8 @@ graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edge
   g->nb_vertices = nb_vertices;
   g->nb_edges = nb_edges;
   g->directed = directed;
+  g->nodes = NULL;
+  g->nb_nodes = 0;
   g->adj_lists = (adj_list_s **)malloc(nb_vertices * sizeof(adj_list_s *));
   if (!g->adj_lists) {
     free(g);
@@ -80,6 +84,94 @@ graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edge
   return g;
 }
 
+/**
+ * @brief Structure shared by the tasks building a graph in parallel.
+ */
+typedef struct {
+  graph_s *g;         /**< The graph being built */
+  edge_s *edges;      /**< The edges */
+  int *first;         /**< First entry of each vertex in `entries` */
+  int *entries;       /**< Edge index times 2, plus 1 for the reverse of an undirected edge */
+} graph_build_s;
+
+/**
+ * @brief Builds the adjacency lists of the vertices [lo, hi).
+ */
+static void build_lists(int lo, int hi, void *arg) {
+  graph_build_s *b = arg;
+  for (int v = lo; v < hi; v++)
+    for (int k = b->first[v]; k < b->first[v+1]; k++) {
+      edge_s *e = &b->edges[b->entries[k] / 2];
+      bool reverse = b->entries[k] % 2;
+      adj_list_s *new_node = &b->g->nodes[k];
+      new_node->vertex.ind = reverse ? e->src : e->dst;
+      new_node->vertex.weight = e->weight;
+      new_node->vertex.prev = v;
+      new_node->next = b->g->adj_lists[v];
+      b->g->adj_lists[v] = new_node;
+    }
+}
+
+/**
+ * @brief Creates a graph, building the adjacency lists in parallel.
+ * 
+ * The nodes of all the lists are allocated in one array, interleaved over the
+ * memory nodes and backed by huge pages when it is large (see numa_alloc.h). The
+ * nodes of a vertex are contiguous in this array.
+ * 
+ * @param nb_vertices Number of vertices in the graph
+ * @param nb_edges Number of edges in the graph
+ * @param directed Boolean indicating if the graph is directed
+ * @param edges Array of edges in the graph
+ * @param pool The thread pool (NULL for a sequential execution)
+ * 
+ * @return Pointer to the created graph
+ */
+graph_s *create_graph_parallel(int nb_vertices, int nb_edges, bool directed, edge_s *edges, thread_pool_s *pool) {
+  graph_s *g = (graph_s *)malloc(sizeof(graph_s));
+  if (!g) return NULL; // Memory allocation failed
+  g->nb_vertices = nb_vertices;
+  g->nb_edges = nb_edges;
+  g->directed = directed;
+  g->adj_lists = (adj_list_s **)calloc(nb_vertices, sizeof(adj_list_s *));
+  int nb_entries = directed ? nb_edges : 2 * nb_edges;
+  g->nb_nodes = nb_entries;
+  g->nodes = numa_alloc_interleaved(nb_entries * sizeof(adj_list_s));
+  graph_build_s b = {.g = g, .edges = edges};
+  b.first = (int *)calloc(nb_vertices + 1, sizeof(int));
+  b.entries = (int *)malloc((nb_entries + 1) * sizeof(int));
+  if (!g->adj_lists || !g->nodes || !b.first || !b.entries) {
+    free(b.first);
+    free(b.entries);
+    free(g->adj_lists);
+    numa_free(g->nodes, nb_entries * sizeof(adj_list_s));
+    free(g);
+    return NULL; // Memory allocation failed
+  }
+  // Dispatch the edges by vertex, in the order in which create_graph inserts them
+  for (int i = 0; i < nb_edges; i++) {
+    b.first[edges[i].src + 1]++;
+    if (!directed) b.first[edges[i].dst + 1]++;
+  }
+  for (int v = 0; v < nb_vertices; v++)
+    b.first[v + 1] += b.first[v];
+  int *next = (int *)malloc((nb_vertices + 1) * sizeof(int));
+  assert(next!=NULL);
+  for (int v = 0; v < nb_vertices; v++)
+    next[v] = b.first[v];
+  for (int i = 0; i < nb_edges; i++) {
+    b.entries[next[edges[i].src]++] = 2 * i;
+    if (!directed) b.entries[next[edges[i].dst]++] = 2 * i + 1;
+  }
+  free(next);
+  // Build the lists of disjoint ranges of vertices in parallel
+  int grain = nb_vertices / (8 * thread_pool_size(pool)) + 1;
+  thread_pool_parallel_for(pool, 0, nb_vertices, grain, build_lists, &b);
+  free(b.first);
+  free(b.entries);
+  return g;
+}
+
 /**
  * @brief Deletes a graph and frees its memory.
  * 
@@ -87,6 +179,13 @@ graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edge
  */
 void delete_graph(graph_s *g) {
   if (!g) return;
+  if (g->nodes) {
+    // all the nodes are in one array
+    numa_free(g->nodes, g->nb_nodes * sizeof(adj_list_s));
+    free(g->adj_lists);
+    free(g);
+    return;
+  }
   for (int i = 0; i < g->nb_vertices; i++) {
     adj_list_s *current = g->adj_lists[i];
     while (current) {
@@ -0,0 +1,177 @@
+/**
+ * @file graph_shm.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief CSR graph built once in a named POSIX shared-memory segment.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "graph_shm.h"
+
+/** @brief Rounds a size up to a multiple of 64 bytes (one cache line). */
+#define ALIGN64(size) (((size) + 63) & ~(size_t)63)
+
+/**
+ * @brief Computes the layout of a segment.
+ *
+ * Each array begins on a cache line.
+ *
+ * @param h The header, whose numbers of vertices and edges are set; the offsets and
+ * the size are filled in.
+ */
+static void graph_shm_layout(graph_shm_header_s *h) {
+  h->off_first = ALIGN64(sizeof(graph_shm_header_s));
+  h->off_head = ALIGN64(h->off_first + ((size_t)h->nb_vertices + 1) * sizeof(int32_t));
+  h->off_weight = ALIGN64(h->off_head + (size_t)h->nb_edges * sizeof(int32_t));
+  h->size = h->off_weight + (size_t)h->nb_edges * sizeof(double);
+}
+
+/**
+ * @brief Writes a CSR graph into a new shared-memory segment.
+ *
+ * The segment is created under the name, sized and filled; its magic number is
+ * written last, so that a process attaching meanwhile rejects it.
+ *
+ * @param name The name of the segment ("/name").
+ * @param csr The CSR graph.
+ * @param directed The graph is directed.
+ * @return false if the segment could not be created.
+ */
+bool graph_shm_create(const char *name, const graph_csr_s *csr, bool directed) {
+  assert(name!=NULL && csr!=NULL);
+  graph_shm_header_s h = {0, csr->nb_vertices, csr->nb_edges, directed, 0, 0, 0, 0};
+  graph_shm_layout(&h);
+  shm_unlink(name);
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd == -1) return false;
+  if (ftruncate(fd, (off_t)h.size) == -1) {
+    close(fd);
+    shm_unlink(name);
+    return false;
+  }
+  char *base = mmap(NULL, h.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    shm_unlink(name);
+    return false;
+  }
+  memcpy(base + h.off_first, csr->first, ((size_t)csr->nb_vertices + 1) * sizeof(int32_t));
+  memcpy(base + h.off_head, csr->head, (size_t)csr->nb_edges * sizeof(int32_t));
+  memcpy(base + h.off_weight, csr->weight, (size_t)csr->nb_edges * sizeof(double));
+  memcpy(base, &h, sizeof(h));
+  __atomic_store_n(&((graph_shm_header_s *)base)->magic, GRAPH_SHM_MAGIC, __ATOMIC_RELEASE);
+  munmap(base, h.size);
+  return true;
+}
+
+/**
+ * @brief Checks the arrays of a mapped graph before it is searched.
+ *
+ * @param csr The graph bound to the mapping.
+ * @return false if the first edges are not increasing from 0 to the number of
+ *         edges, or if a head is not a vertex.
+ */
+static bool graph_shm_check(const graph_csr_s *csr) {
+  if (csr->first[0] != 0 || csr->first[csr->nb_vertices] != csr->nb_edges) return false;
+  for (int u = 0; u < csr->nb_vertices; u++)
+    if (csr->first[u + 1] < csr->first[u]) return false;
+  for (int e = 0; e < csr->nb_edges; e++)
+    if (csr->head[e] < 0 || csr->head[e] >= csr->nb_vertices) return false;
+  return true;
+}
+
+/**
+ * @brief Maps a graph segment, read-only.
+ *
+ * The header is checked against the size of the segment before the arrays are
+ * bound to the mapping, then the arrays are checked once so that no search reads
+ * outside them.
+ *
+ * @param name The name of the segment.
+ * @return Pointer to the mapped graph, NULL if the segment does not exist, is not
+ * complete or is not a consistent graph segment.
+ */
+graph_shm_s *graph_shm_attach(const char *name) {
+  assert(name!=NULL);
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd == -1) return NULL;
+  struct stat st;
+  if (fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof(graph_shm_header_s)) {
+    close(fd);
+    return NULL;
+  }
+  size_t size = (size_t)st.st_size;
+  char *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) return NULL;
+  const graph_shm_header_s *h = (const graph_shm_header_s *)base;
+  graph_shm_header_s expected = {0, h->nb_vertices, h->nb_edges, h->directed, 0, 0, 0, 0};
+  if (__atomic_load_n(&h->magic, __ATOMIC_ACQUIRE) != GRAPH_SHM_MAGIC || h->nb_vertices < 0 || h->nb_edges < 0) {
+    munmap(base, size);
+    return NULL;
+  }
+  graph_shm_layout(&expected);
+  if (h->off_first != expected.off_first || h->off_head != expected.off_head ||
+      h->off_weight != expected.off_weight || h->size != size || expected.size != size) {
+    munmap(base, size);
+    return NULL;
+  }
+  graph_shm_s *shm = malloc(sizeof(graph_shm_s));
+  assert(shm!=NULL);
+  shm->csr.nb_vertices = h->nb_vertices;
+  shm->csr.nb_edges = h->nb_edges;
+  shm->csr.first = (int *)(base + h->off_first);
+  shm->csr.head = (int *)(base + h->off_head);
+  shm->csr.weight = (double *)(base + h->off_weight);
+  shm->directed = h->directed != 0;
+  shm->block = base;
+  shm->size = size;
+  if (!graph_shm_check(&shm->csr)) {
+    graph_shm_detach(shm);
+    return NULL;
+  }
+  return shm;
+}
+
+/**
+ * @brief Unmaps a graph segment.
+ *
+ * @param shm Pointer to the mapped graph (may be NULL).
+ */
+void graph_shm_detach(graph_shm_s *shm) {
+  if (!shm) return;
+  munmap(shm->block, shm->size);
+  free(shm);
+}
+
+/**
+ * @brief Removes the name of a graph segment.
+ *
+ * @param name The name of the segment.
+ * @return false if the segment does not exist.
+ */
+bool graph_shm_unlink(const char *name) {
+  assert(name!=NULL);
+  return shm_unlink(name) == 0;
+}
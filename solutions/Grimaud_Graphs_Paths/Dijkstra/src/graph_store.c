@@ -0,0 +1,256 @@
+/**
+ * @file graph_store.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Versions of a graph published atomically to concurrent readers.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include <pthread.h>
+#include <assert.h>
+#include "graph_store.h"
+
+/**
+ * @brief Structure of the announcement of a reader, alone on its cache line.
+ */
+typedef struct {
+  _Alignas(64) uint64_t epoch; /**< Epoch in which the reader entered, 0 if it holds no version */
+} reader_slot_s;
+
+/**
+ * @brief Structure of a retired version waiting for its grace period.
+ */
+typedef struct retired {
+  graph_version_s *version; /**< The retired version */
+  uint64_t epoch;           /**< First epoch in which no reader can get the version */
+  struct retired *next;     /**< Next retired version */
+} retired_s;
+
+/**
+ * @brief Structure of the store.
+ */
+struct graph_store {
+  graph_version_s *current; /**< The current version (swapped atomically) */
+  _Alignas(64) uint64_t epoch; /**< Current epoch, incremented by each publication */
+  int nb_readers;           /**< Number of readers */
+  reader_slot_s *readers;   /**< Announcement of each reader */
+  pthread_mutex_t lock;     /**< Lock serializing the writers */
+  retired_s *retired;       /**< Retired versions not freed yet */
+  graph_store_stats_s stats; /**< Counters (updated by the writers) */
+};
+
+/**
+ * @brief Creates a version.
+ *
+ * @param id The number of the version.
+ * @param g The adjacency lists.
+ * @param csr The CSR copy.
+ * @return Pointer to the created version.
+ */
+static graph_version_s *version_create(unsigned long id, graph_s *g, graph_csr_s *csr) {
+  graph_version_s *v = malloc(sizeof(graph_version_s));
+  assert(v!=NULL);
+  *v = (graph_version_s){id, g, csr};
+  return v;
+}
+
+/**
+ * @brief Deletes a version and its graphs.
+ *
+ * @param v Pointer to the version.
+ */
+static void version_delete(graph_version_s *v) {
+  delete_graph(v->g);
+  graph_csr_delete(v->csr);
+  free(v);
+}
+
+/**
+ * @brief Creates a store holding a first version.
+ *
+ * @param g The adjacency lists of the first version (may be NULL).
+ * @param csr The CSR copy of the first version (may be NULL).
+ * @param nb_readers Number of readers (a reader is one thread issuing queries).
+ * @return Pointer to the created store.
+ */
+graph_store_s *graph_store_create(graph_s *g, graph_csr_s *csr, int nb_readers) {
+  assert(nb_readers>0);
+  graph_store_s *s = aligned_alloc(64, sizeof(graph_store_s));
+  assert(s!=NULL);
+  s->current = version_create(0, g, csr);
+  s->epoch = 1;
+  s->nb_readers = nb_readers;
+  s->readers = aligned_alloc(64, nb_readers * sizeof(reader_slot_s));
+  assert(s->readers!=NULL);
+  for (int r = 0; r < nb_readers; r++)
+    s->readers[r].epoch = 0;
+  pthread_mutex_init(&s->lock, NULL);
+  s->retired = NULL;
+  s->stats = (graph_store_stats_s){0, 0, 0};
+  return s;
+}
+
+/**
+ * @brief Enters the current version.
+ *
+ * The reader reads the epoch, announces it, then reads the version. If a writer
+ * swapped the version in between, it either sees the announcement and waits for
+ * the reader, or missed it and then the reader reads the new version: the
+ * announcement and the swap are both sequentially consistent.
+ *
+ * @param s Pointer to the store.
+ * @param reader Index of the reader, in [0, nb_readers).
+ * @return The current version.
+ */
+const graph_version_s *graph_store_enter(graph_store_s *s, int reader) {
+  assert(reader>=0 && reader<s->nb_readers);
+  uint64_t epoch = __atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST);
+  __atomic_store_n(&s->readers[reader].epoch, epoch, __ATOMIC_SEQ_CST);
+  return __atomic_load_n(&s->current, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Leaves the version entered by a reader.
+ *
+ * @param s Pointer to the store.
+ * @param reader Index of the reader.
+ */
+void graph_store_exit(graph_store_s *s, int reader) {
+  __atomic_store_n(&s->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Frees the retired versions whose grace period is over (writer lock held).
+ *
+ * A version retired before the epoch e cannot be held by a reader which left, or
+ * which entered in the epoch e or later.
+ *
+ * @param s Pointer to the store.
+ * @return The number of versions freed.
+ */
+static int reclaim_locked(graph_store_s *s) {
+  uint64_t oldest = UINT64_MAX;
+  for (int r = 0; r < s->nb_readers; r++) {
+    uint64_t epoch = __atomic_load_n(&s->readers[r].epoch, __ATOMIC_SEQ_CST);
+    if (epoch != 0 && epoch < oldest) oldest = epoch;
+  }
+  int nb_freed = 0;
+  retired_s **link = &s->retired;
+  while (*link != NULL) {
+    retired_s *r = *link;
+    if (r->epoch <= oldest) {
+      *link = r->next;
+      version_delete(r->version);
+      free(r);
+      nb_freed++;
+    } else {
+      link = &r->next;
+    }
+  }
+  s->stats.nb_reclaimed += nb_freed;
+  s->stats.nb_pending -= nb_freed;
+  return nb_freed;
+}
+
+/**
+ * @brief Publishes a new version and retires the current one.
+ *
+ * @param s Pointer to the store.
+ * @param g The adjacency lists of the new version (may be NULL).
+ * @param csr The CSR copy of the new version (may be NULL).
+ * @return The number of the new version.
+ */
+unsigned long graph_store_publish(graph_store_s *s, graph_s *g, graph_csr_s *csr) {
+  pthread_mutex_lock(&s->lock);
+  unsigned long id = s->current->id + 1;
+  graph_version_s *old = __atomic_exchange_n(&s->current, version_create(id, g, csr), __ATOMIC_SEQ_CST);
+  retired_s *r = malloc(sizeof(retired_s));
+  assert(r!=NULL);
+  r->version = old;
+  r->epoch = __atomic_add_fetch(&s->epoch, 1, __ATOMIC_SEQ_CST);
+  r->next = s->retired;
+  s->retired = r;
+  s->stats.nb_published++;
+  s->stats.nb_pending++;
+  reclaim_locked(s);
+  pthread_mutex_unlock(&s->lock);
+  return id;
+}
+
+/**
+ * @brief Frees the retired versions that no reader can hold anymore.
+ *
+ * @param s Pointer to the store.
+ * @return The number of versions freed.
+ */
+int graph_store_reclaim(graph_store_s *s) {
+  pthread_mutex_lock(&s->lock);
+  int nb_freed = reclaim_locked(s);
+  pthread_mutex_unlock(&s->lock);
+  return nb_freed;
+}
+
+/**
+ * @brief Waits until all the retired versions are freed.
+ *
+ * @param s Pointer to the store.
+ */
+void graph_store_synchronize(graph_store_s *s) {
+  for (;;) {
+    pthread_mutex_lock(&s->lock);
+    reclaim_locked(s);
+    bool done = (s->retired == NULL);
+    pthread_mutex_unlock(&s->lock);
+    if (done) return;
+    sched_yield();
+  }
+}
+
+/**
+ * @brief Gets the counters of a store.
+ *
+ * @param s Pointer to the store.
+ * @return The counters.
+ */
+graph_store_stats_s graph_store_stats(graph_store_s *s) {
+  pthread_mutex_lock(&s->lock);
+  graph_store_stats_s stats = s->stats;
+  pthread_mutex_unlock(&s->lock);
+  return stats;
+}
+
+/**
+ * @brief Deletes a store and all its versions.
+ *
+ * @param s Pointer to the store (may be NULL).
+ */
+void graph_store_delete(graph_store_s *s) {
+  if (!s) return;
+  while (s->retired != NULL) {
+    retired_s *r = s->retired;
+    s->retired = r->next;
+    version_delete(r->version);
+    free(r);
+  }
+  version_delete(s->current);
+  pthread_mutex_destroy(&s->lock);
+  free(s->readers);
+  free(s);
+}
@@ -0,0 +1,373 @@
+/**
+ * @file grid.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Implicit grid graphs with Dijkstra, A* and jump point searches.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "grid.h"
+#include "numa_alloc.h"
+
+/** @brief Length of a diagonal move. */
+#define GRID_SQRT2 1.41421356237309504880
+
+/** @brief Column offsets of the neighbours: the 4 straight ones, then the 4 diagonal ones. */
+static const int GRID_DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+
+/** @brief Row offsets of the neighbours, in the order of GRID_DX. */
+static const int GRID_DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+/**
+ * @brief Creates a grid whose cells all cost 1.
+ *
+ * @param width Number of columns.
+ * @param height Number of rows.
+ * @param connectivity 4 or 8.
+ * @return Pointer to the created grid.
+ */
+grid_s *grid_create(int width, int height, int connectivity) {
+  assert(width > 0 && height > 0 && (connectivity == 4 || connectivity == 8));
+  grid_s *g = malloc(sizeof(grid_s));
+  assert(g!=NULL);
+  g->width = width;
+  g->height = height;
+  g->connectivity = connectivity;
+  g->cost = numa_alloc_interleaved((size_t)width * height * sizeof(float));
+  assert(g->cost!=NULL);
+  for (size_t c = 0; c < (size_t)width * height; c++)
+    g->cost[c] = 1.0f;
+  g->min_cost = 1.0f;
+  g->uniform = true;
+  return g;
+}
+
+/**
+ * @brief Reads a grid from a text file.
+ *
+ * @param path Path of the file.
+ * @param connectivity 4 or 8.
+ * @return Pointer to the created grid, NULL if the file cannot be read.
+ */
+grid_s *grid_load(const char *path, int connectivity) {
+  FILE *f = fopen(path, "r");
+  if (!f) return NULL;
+  int width, height;
+  if (fscanf(f, "%d %d", &width, &height) != 2 || width <= 0 || height <= 0) {
+    fclose(f);
+    return NULL;
+  }
+  grid_s *g = grid_create(width, height, connectivity);
+  char token[32];
+  for (size_t c = 0; c < (size_t)width * height; c++) {
+    char *end;
+    if (fscanf(f, "%31s", token) != 1) {
+      grid_delete(g);
+      fclose(f);
+      return NULL;
+    }
+    if (token[0] == '#' && token[1] == '\0') {
+      g->cost[c] = -1.0f;
+    } else {
+      g->cost[c] = strtof(token, &end);
+      if (*end != '\0') {
+        grid_delete(g);
+        fclose(f);
+        return NULL;
+      }
+    }
+  }
+  fclose(f);
+  grid_update(g);
+  return g;
+}
+
+/**
+ * @brief Creates a grid of cost 1 with randomly placed obstacles.
+ *
+ * @param width Number of columns.
+ * @param height Number of rows.
+ * @param connectivity 4 or 8.
+ * @param obstacles Probability of a cell being an obstacle.
+ * @param seed Seed of the generator.
+ * @return Pointer to the created grid.
+ */
+grid_s *grid_random(int width, int height, int connectivity, double obstacles, unsigned int seed) {
+  grid_s *g = grid_create(width, height, connectivity);
+  for (size_t c = 0; c < (size_t)width * height; c++)
+    if (rand_r(&seed) < obstacles * RAND_MAX)
+      g->cost[c] = -1.0f;
+  return g;
+}
+
+/**
+ * @brief Updates `min_cost` and `uniform` after the costs have been changed.
+ *
+ * @param g Pointer to the grid.
+ */
+void grid_update(grid_s *g) {
+  assert(g!=NULL);
+  float min_cost = INFINITY, max_cost = -1.0f;
+  for (size_t c = 0; c < (size_t)g->width * g->height; c++) {
+    if (g->cost[c] < 0.0f) continue;
+    if (g->cost[c] < min_cost) min_cost = g->cost[c];
+    if (g->cost[c] > max_cost) max_cost = g->cost[c];
+  }
+  g->min_cost = (max_cost < 0.0f) ? 1.0f : min_cost;
+  g->uniform = (max_cost < 0.0f) || min_cost == max_cost;
+}
+
+/**
+ * @brief Deletes a grid and frees its memory.
+ *
+ * @param g Pointer to the grid.
+ */
+void grid_delete(grid_s *g) {
+  if (!g) return;
+  numa_free(g->cost, (size_t)g->width * g->height * sizeof(float));
+  free(g);
+}
+
+/**
+ * @brief Gets the cost of the move between two neighbour cells.
+ *
+ * @param g The grid.
+ * @param a The first cell.
+ * @param b The second cell.
+ * @param diagonal true for a diagonal move.
+ * @return The cost of the move.
+ */
+static inline double grid_step(const grid_s *g, int a, int b, bool diagonal) {
+  double cost = 0.5 * ((double)g->cost[a] + g->cost[b]);
+  return diagonal ? GRID_SQRT2 * cost : cost;
+}
+
+/**
+ * @brief Gets the length of the shortest obstacle-free path between two cells, in moves.
+ *
+ * @param g The grid.
+ * @param a The first cell.
+ * @param b The second cell.
+ * @return The octile distance on an 8-connected grid, the Manhattan distance otherwise.
+ */
+static inline double grid_moves(const grid_s *g, int a, int b) {
+  int dx = abs(a % g->width - b % g->width), dy = abs(a / g->width - b / g->width);
+  if (g->connectivity == 4) return dx + dy;
+  return (dx > dy) ? dx + (GRID_SQRT2 - 1.0) * dy : dy + (GRID_SQRT2 - 1.0) * dx;
+}
+
+/**
+ * @brief Tests if a diagonal move does not cut a corner.
+ *
+ * @param g The grid.
+ * @param x Column of the starting cell.
+ * @param y Row of the starting cell.
+ * @param dx Column offset of the move.
+ * @param dy Row offset of the move.
+ * @return true if both cells the move passes by are free.
+ */
+static inline bool grid_diagonal_free(const grid_s *g, int x, int y, int dx, int dy) {
+  return grid_free(g, x + dx, y) && grid_free(g, x, y + dy);
+}
+
+/**
+ * @brief Jumps straight from a cell until a jump point, an obstacle or the target.
+ *
+ * A cell is a jump point when one of its side neighbours is free while the cell
+ * behind it is an obstacle: the optimal paths may turn there.
+ *
+ * @param g The grid.
+ * @param x Column of the first cell of the jump.
+ * @param y Row of the first cell of the jump.
+ * @param dx Column offset of the direction (0 for a vertical jump).
+ * @param dy Row offset of the direction (0 for a horizontal jump).
+ * @param dst The target cell.
+ * @return The jump point reached, -1 if the jump is blocked.
+ */
+static int jump_straight(const grid_s *g, int x, int y, int dx, int dy, int dst) {
+  for (;; x += dx, y += dy) {
+    if (!grid_free(g, x, y)) return -1;
+    int cell = y * g->width + x;
+    if (cell == dst) return cell;
+    if (dx != 0) {
+      if ((grid_free(g, x, y - 1) && !grid_free(g, x - dx, y - 1)) ||
+          (grid_free(g, x, y + 1) && !grid_free(g, x - dx, y + 1)))
+        return cell;
+    } else {
+      if ((grid_free(g, x - 1, y) && !grid_free(g, x - 1, y - dy)) ||
+          (grid_free(g, x + 1, y) && !grid_free(g, x + 1, y - dy)))
+        return cell;
+    }
+  }
+}
+
+/**
+ * @brief Jumps from a cell in a direction until a jump point, an obstacle or the target.
+ *
+ * A diagonal jump stops at a cell from which one of the two straight jumps along its
+ * components reaches a jump point.
+ *
+ * @param g The grid.
+ * @param x Column of the first cell of the jump.
+ * @param y Row of the first cell of the jump.
+ * @param dx Column offset of the direction.
+ * @param dy Row offset of the direction.
+ * @param dst The target cell.
+ * @return The jump point reached, -1 if the jump is blocked.
+ */
+static int jump(const grid_s *g, int x, int y, int dx, int dy, int dst) {
+  if (dx == 0 || dy == 0) return jump_straight(g, x, y, dx, dy, dst);
+  for (;; x += dx, y += dy) {
+    if (!grid_free(g, x, y)) return -1;
+    int cell = y * g->width + x;
+    if (cell == dst) return cell;
+    if (jump_straight(g, x + dx, y, dx, 0, dst) >= 0 || jump_straight(g, x, y + dy, 0, dy, dst) >= 0)
+      return cell;
+    if (!grid_diagonal_free(g, x, y, dx, dy)) return -1;
+  }
+}
+
+/**
+ * @brief Pushes the jump points reached from a settled cell.
+ *
+ * The directions followed are the natural and forced neighbours of the move that
+ * reached the cell (all the directions from the source).
+ *
+ * @param g The grid (8-connected, of uniform cost).
+ * @param ws The workspace.
+ * @param cell The settled cell.
+ * @param dist Its distance.
+ * @param dst The target cell.
+ */
+static void jps_expand(const grid_s *g, workspace_s *ws, int cell, double dist, int dst) {
+  int x = cell % g->width, y = cell / g->width;
+  int dirs[8][2], nb_dirs = 0;
+  int prev = ws->prev[cell];
+  if (prev < 0) {
+    for (int k = 0; k < 8; k++)
+      if (k < 4 || grid_diagonal_free(g, x, y, GRID_DX[k], GRID_DY[k])) {
+        dirs[nb_dirs][0] = GRID_DX[k];
+        dirs[nb_dirs++][1] = GRID_DY[k];
+      }
+  } else {
+    int px = prev % g->width, py = prev / g->width;
+    int dx = (x > px) - (x < px), dy = (y > py) - (y < py);
+    bool ahead_x = grid_free(g, x + dx, y), ahead_y = grid_free(g, x, y + dy);
+    if (dx != 0 && dy != 0) {
+      if (ahead_y) { dirs[nb_dirs][0] = 0; dirs[nb_dirs++][1] = dy; }
+      if (ahead_x) { dirs[nb_dirs][0] = dx; dirs[nb_dirs++][1] = 0; }
+      if (ahead_x && ahead_y) { dirs[nb_dirs][0] = dx; dirs[nb_dirs++][1] = dy; }
+    } else {
+      // side offsets of the straight move
+      int sx = (dx == 0), sy = (dy == 0);
+      bool ahead = (dx != 0) ? ahead_x : ahead_y;
+      bool side1 = grid_free(g, x + sx, y + sy), side2 = grid_free(g, x - sx, y - sy);
+      if (ahead) {
+        dirs[nb_dirs][0] = dx; dirs[nb_dirs++][1] = dy;
+        if (side1) { dirs[nb_dirs][0] = dx + sx; dirs[nb_dirs++][1] = dy + sy; }
+        if (side2) { dirs[nb_dirs][0] = dx - sx; dirs[nb_dirs++][1] = dy - sy; }
+      }
+      if (side1) { dirs[nb_dirs][0] = sx; dirs[nb_dirs++][1] = sy; }
+      if (side2) { dirs[nb_dirs][0] = -sx; dirs[nb_dirs++][1] = -sy; }
+    }
+  }
+  for (int k = 0; k < nb_dirs; k++) {
+    int next = jump(g, x + dirs[k][0], y + dirs[k][1], dirs[k][0], dirs[k][1], dst);
+    if (next < 0) continue;
+    double weight = dist + g->min_cost * grid_moves(g, cell, next);
+    workspace_push_keyed(ws, next, weight, weight + g->min_cost * grid_moves(g, next, dst), cell);
+  }
+}
+
+/**
+ * @brief Computes the shortest path between two cells.
+ *
+ * The heap is ordered by the distance plus `min_cost` times the number of moves
+ * left (zero for Dijkstra's algorithm), which never overestimates the remaining cost
+ * and is consistent, so a settled cell is never reopened.
+ *
+ * @param g The grid.
+ * @param src The source cell.
+ * @param dst The target cell.
+ * @param search The search.
+ * @param ws A workspace created for `width * height` vertices, reset by the call.
+ * @return The cost of the path, INFINITY if there is no path.
+ */
+double grid_search(const grid_s *g, int src, int dst, grid_search_e search, workspace_s *ws) {
+  assert(g!=NULL && ws!=NULL && ws->nb_vertices >= g->width * g->height);
+  assert(src >= 0 && src < g->width * g->height && dst >= 0 && dst < g->width * g->height);
+  workspace_reset(ws);
+  if (g->cost[src] < 0.0f || g->cost[dst] < 0.0f) return INFINITY;
+  if (search == GRID_JPS && !grid_jps_exact(g)) search = GRID_ASTAR;
+  double scale = (search == GRID_DIJKSTRA) ? 0.0 : g->min_cost;
+  workspace_push_keyed(ws, src, 0.0, scale * grid_moves(g, src, dst), -1);
+  vertex_s v;
+  while (workspace_pop(ws, &v)) {
+    double dist = ws->dist[v.ind];
+    if (v.ind == dst) return dist;
+    if (search == GRID_JPS) {
+      jps_expand(g, ws, v.ind, dist, dst);
+      continue;
+    }
+    int x = v.ind % g->width, y = v.ind / g->width;
+    for (int k = 0; k < g->connectivity; k++) {
+      int dx = GRID_DX[k], dy = GRID_DY[k];
+      if (!grid_free(g, x + dx, y + dy) || (k >= 4 && !grid_diagonal_free(g, x, y, dx, dy))) continue;
+      int next = v.ind + dy * g->width + dx;
+      double weight = dist + grid_step(g, v.ind, next, k >= 4);
+      workspace_push_keyed(ws, next, weight, weight + scale * grid_moves(g, next, dst), v.ind);
+    }
+  }
+  return INFINITY;
+}
+
+/**
+ * @brief Gets the cells of the path found by the last search.
+ *
+ * @param g The grid.
+ * @param ws The workspace of the search.
+ * @param dst The target cell.
+ * @param cells Array of at least `width * height` cells, filled from the source to the target.
+ * @return The number of cells of the path, 0 if the target was not reached.
+ */
+int grid_path(const grid_s *g, const workspace_s *ws, int dst, int *cells) {
+  assert(g!=NULL && ws!=NULL && cells!=NULL);
+  if (!workspace_is_settled(ws, dst)) return 0;
+  int n = 0;
+  cells[n++] = dst;
+  // walk back along the straight or diagonal segments between the jump points
+  for (int cell = dst; ws->prev[cell] >= 0; cell = ws->prev[cell]) {
+    int x = cell % g->width, y = cell / g->width;
+    int px = ws->prev[cell] % g->width, py = ws->prev[cell] / g->width;
+    int dx = (px > x) - (px < x), dy = (py > y) - (py < y);
+    while (x != px || y != py) {
+      x += dx;
+      y += dy;
+      cells[n++] = y * g->width + x;
+    }
+  }
+  for (int i = 0; i < n / 2; i++) {
+    int tmp = cells[i];
+    cells[i] = cells[n - 1 - i];
+    cells[n - 1 - i] = tmp;
+  }
+  return n;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file implicit_graph.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Graphs whose edges are generated on demand by a callback.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "implicit_graph.h"
+
+/**
+ * @brief Creates a graph whose edges are generated by a callback.
+ *
+ * @param nb_vertices Number of vertices.
+ * @param max_degree Maximum number of edges leaving a vertex.
+ * @param neighbours Function generating the edges leaving a vertex.
+ * @param ctx Context given to the function.
+ * @return Pointer to the created graph.
+ */
+implicit_graph_s *implicit_graph_create(int nb_vertices, int max_degree, neighbours_fn neighbours, void *ctx) {
+  assert(nb_vertices > 0 && max_degree >= 0 && neighbours != NULL);
+  implicit_graph_s *ig = malloc(sizeof(implicit_graph_s));
+  assert(ig!=NULL);
+  ig->nb_vertices = nb_vertices;
+  ig->max_degree = max_degree;
+  ig->neighbours = neighbours;
+  ig->ctx = ctx;
+  ig->heads = malloc((max_degree + 1)*sizeof(int));
+  ig->weights = malloc((max_degree + 1)*sizeof(double));
+  assert(ig->heads!=NULL && ig->weights!=NULL);
+  return ig;
+}
+
+/**
+ * @brief Deletes a graph and frees its buffers (the context is left to the caller).
+ *
+ * @param ig Pointer to the graph.
+ */
+void implicit_graph_delete(implicit_graph_s *ig) {
+  if (!ig) return;
+  free(ig->heads);
+  free(ig->weights);
+  free(ig);
+}
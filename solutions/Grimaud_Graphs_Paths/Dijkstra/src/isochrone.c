@@ -0,0 +1,53 @@
+/**
+ * @file isochrone.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Bounded-radius Dijkstra search (isochrones).
+ *
+ * The search never looks at a vertex farther than the first vertex beyond the
+ * radius: once the head of the heap exceeds the budget, the search stops and
+ * the remaining heap is dropped by the next reset of the workspace.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include "isochrone.h"
+
+/**
+ * @brief Settles all the vertices at distance at most `radius` from the source.
+ *
+ * @param g The graph.
+ * @param src The source vertex.
+ * @param radius The distance budget.
+ * @param ws A workspace created for `g->nb_vertices` vertices, reset by the call.
+ * @return The number of settled vertices, stored in `ws->settled_list`.
+ */
+int dijkstra_within(graph_s *g, int src, double radius, workspace_s *ws) {
+  assert(g!=NULL && ws!=NULL && ws->nb_vertices >= g->nb_vertices);
+  assert(src >= 0 && src < g->nb_vertices);
+  workspace_reset(ws);
+  if (radius < 0.0) return 0;
+  workspace_push(ws, src, 0.0, -1);
+  while (workspace_next_weight(ws) <= radius) {
+    vertex_s v;
+    workspace_pop(ws, &v);
+    for (adj_list_s *adj = get_adj_list(g, v.ind); adj != NULL; adj = adj->next)
+      workspace_push(ws, adj->vertex.ind, v.weight + adj->vertex.weight, v.ind);
+  }
+  return ws->nb_settled;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file knn.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief k-nearest targets query with early termination.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include "knn.h"
+
+/**
+ * @brief Finds the k targets closest to the source.
+ *
+ * @param g The graph.
+ * @param src The source vertex.
+ * @param targets The set of target vertices.
+ * @param k The number of targets wanted.
+ * @param ws A workspace created for `g->nb_vertices` vertices, reset by the call.
+ * @param nearest Array of at least k vertices, filled with the targets found.
+ * @return The number of targets found.
+ */
+int dijkstra_knn(graph_s *g, int src, const bitset_s *targets, int k, workspace_s *ws, vertex_s *nearest) {
+  assert(g!=NULL && targets!=NULL && ws!=NULL && ws->nb_vertices >= g->nb_vertices);
+  assert(targets->nb_bits >= g->nb_vertices && src >= 0 && src < g->nb_vertices);
+  workspace_reset(ws);
+  int found = 0;
+  if (k <= 0) return 0;
+  workspace_push(ws, src, 0.0, -1);
+  vertex_s v;
+  while (workspace_pop(ws, &v)) {
+    if (bitset_test(targets, v.ind)) {
+      nearest[found++] = v;
+      if (found == k) break; // the k closest targets are settled
+    }
+    for (adj_list_s *adj = get_adj_list(g, v.ind); adj != NULL; adj = adj->next)
+      workspace_push(ws, adj->vertex.ind, v.weight + adj->vertex.weight, v.ind);
+  }
+  return found;
+}
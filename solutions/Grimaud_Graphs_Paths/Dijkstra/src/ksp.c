@@ -0,0 +1,335 @@
+/**
+ * @file ksp.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief k-shortest loopless paths (Yen's algorithm).
+ *
+ * Each spur search is a Dijkstra search from the spur vertex to the destination,
+ * started at the length of the root path, which avoids the vertices of the root
+ * path (so that the resulting path stays simple) and the edges leaving the spur
+ * vertex along the already found paths sharing the same root. The spur vertices
+ * of one iteration are distributed over the tasks of the thread pool; each task owns a
+ * workspace and an array of blocked vertices stamped like the workspace, so that
+ * nothing of size V is cleared between two spur searches.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include "ksp.h"
+#include "workspace.h"
+
+/**
+ * @brief Structure representing one path during the computation.
+ */
+typedef struct {
+  int length;     /**< Number of vertices of the path */
+  int *vertices;  /**< Vertices of the path */
+  double *dist;   /**< Distance from the source along the path */
+  uint64_t hash;  /**< Hash of the sequence of vertices */
+} path_s;
+
+/**
+ * @brief Structure of the state of one spur search worker.
+ */
+typedef struct {
+  graph_s *g;             /**< The graph */
+  int dst;                /**< The destination vertex */
+  const path_s *last;     /**< The last path found, spur vertices are taken along it */
+  path_s **found;         /**< The paths already found */
+  int nb_found;           /**< Number of paths already found */
+  int worker;             /**< Index of the worker */
+  int nb_workers;         /**< Number of workers */
+  workspace_s *ws;        /**< Dijkstra workspace of the worker */
+  unsigned int *blocked;  /**< Blocked vertices (blocked[v] == stamp) */
+  unsigned int stamp;     /**< Stamp of the current spur search */
+  path_s **spurs;         /**< Output: candidate path of each spur vertex (or NULL) */
+} spur_worker_s;
+
+/**
+ * @brief Allocates a path of a given number of vertices.
+ */
+static path_s *path_create(int length) {
+  path_s *p = malloc(sizeof(path_s));
+  assert(p!=NULL);
+  p->length = length;
+  p->vertices = malloc(length*sizeof(int));
+  p->dist = malloc(length*sizeof(double));
+  assert(p->vertices!=NULL && p->dist!=NULL);
+  p->hash = 0;
+  return p;
+}
+
+/**
+ * @brief Frees a path.
+ */
+static void path_delete(path_s *p) {
+  if (!p) return;
+  free(p->vertices);
+  free(p->dist);
+  free(p);
+}
+
+/**
+ * @brief Computes the FNV-1a hash of the sequence of vertices of a path.
+ */
+static uint64_t path_hash(const path_s *p) {
+  uint64_t h = 14695981039346656037ULL;
+  for (int i = 0; i < p->length; i++) {
+    h ^= (uint64_t)(unsigned int)p->vertices[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/**
+ * @brief Tests if two paths have the same sequence of vertices.
+ */
+static bool path_equal(const path_s *a, const path_s *b) {
+  return a->hash == b->hash && a->length == b->length
+    && memcmp(a->vertices, b->vertices, a->length*sizeof(int)) == 0;
+}
+
+/**
+ * @brief Compares two paths by length, then by number of vertices.
+ */
+static bool path_less(const path_s *a, const path_s *b) {
+  double la = a->dist[a->length-1], lb = b->dist[b->length-1];
+  return la < lb || (la == lb && a->length < b->length);
+}
+
+/**
+ * @brief Searches the spur path leaving the vertex i of the last path.
+ *
+ * @param sw The state of the worker.
+ * @param i The index of the spur vertex in the last path.
+ * @return The root path followed by the spur path, or NULL if there is none.
+ */
+static path_s *spur_search(spur_worker_s *sw, int i) {
+  const path_s *last = sw->last;
+  int spur = last->vertices[i];
+  workspace_s *ws = sw->ws;
+  // Block the vertices of the root path, the resulting path stays simple
+  sw->stamp++;
+  for (int j = 0; j < i; j++)
+    sw->blocked[last->vertices[j]] = sw->stamp;
+  // Block the edges leaving the spur vertex along the paths sharing the same root
+  int blocked_succ[sw->nb_found > 0 ? sw->nb_found : 1];
+  int nb_blocked_succ = 0;
+  for (int p = 0; p < sw->nb_found; p++) {
+    const path_s *a = sw->found[p];
+    if (a->length > i + 1 && memcmp(a->vertices, last->vertices, (i+1)*sizeof(int)) == 0)
+      blocked_succ[nb_blocked_succ++] = a->vertices[i+1];
+  }
+  // Dijkstra from the spur vertex, starting at the length of the root path
+  workspace_reset(ws);
+  workspace_push(ws, spur, last->dist[i], -1);
+  vertex_s v;
+  bool reached = false;
+  while (workspace_pop(ws, &v)) {
+    if (v.ind == sw->dst) {
+      reached = true;
+      break;
+    }
+    for (adj_list_s *adj = get_adj_list(sw->g, v.ind); adj != NULL; adj = adj->next) {
+      int x = adj->vertex.ind;
+      if (sw->blocked[x] == sw->stamp) continue;
+      if (v.ind == spur) {
+        bool skip = false;
+        for (int b = 0; b < nb_blocked_succ && !skip; b++)
+          skip = (blocked_succ[b] == x);
+        if (skip) continue;
+      }
+      workspace_push(ws, x, v.weight + adj->vertex.weight, v.ind);
+    }
+  }
+  if (!reached) return NULL;
+  // Root path followed by the spur path
+  int spur_length = 0;
+  for (int x = sw->dst; x != -1; x = ws->prev[x])
+    spur_length++;
+  path_s *p = path_create(i + spur_length);
+  memcpy(p->vertices, last->vertices, i*sizeof(int));
+  memcpy(p->dist, last->dist, i*sizeof(double));
+  int j = p->length - 1;
+  for (int x = sw->dst; x != -1; x = ws->prev[x], j--) {
+    p->vertices[j] = x;
+    p->dist[j] = ws->dist[x];
+  }
+  p->hash = path_hash(p);
+  return p;
+}
+
+/**
+ * @brief Runs the spur searches assigned to one worker.
+ */
+static void spur_worker(void *arg) {
+  spur_worker_s *sw = arg;
+  for (int i = sw->worker; i < sw->last->length - 1; i += sw->nb_workers)
+    sw->spurs[i] = spur_search(sw, i);
+}
+
+/**
+ * @brief Pushes a candidate path in the heap of candidates.
+ */
+static void candidates_push(path_s ***heap, int *nb, int *capacity, path_s *p) {
+  if (*nb == *capacity) {
+    *capacity = 2 * *capacity + 16;
+    *heap = realloc(*heap, *capacity * sizeof(path_s *));
+    assert(*heap!=NULL);
+  }
+  path_s **h = *heap;
+  int i = (*nb)++;
+  h[i] = p;
+  while (i > 0 && path_less(h[i], h[(i-1)/2])) {
+    path_s *tmp = h[i]; h[i] = h[(i-1)/2]; h[(i-1)/2] = tmp;
+    i = (i-1)/2;
+  }
+}
+
+/**
+ * @brief Pops the shortest candidate path from the heap of candidates.
+ */
+static path_s *candidates_pop(path_s **h, int *nb) {
+  path_s *res = h[0];
+  h[0] = h[--(*nb)];
+  int i = 0;
+  while (true) {
+    int l = 2*i+1, r = 2*i+2, m = i;
+    if (l < *nb && path_less(h[l], h[m])) m = l;
+    if (r < *nb && path_less(h[r], h[m])) m = r;
+    if (m == i) break;
+    path_s *tmp = h[i]; h[i] = h[m]; h[m] = tmp;
+    i = m;
+  }
+  return res;
+}
+
+/**
+ * @brief Computes the k shortest loopless paths from src to dst.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param dst The destination vertex.
+ * @param k The number of paths wanted.
+ * @param pool The thread pool running the spur searches (NULL for a sequential execution).
+ * @return The paths found, ordered by increasing length.
+ */
+ksp_s *yen_ksp(graph_s *g, int src, int dst, int k, thread_pool_s *pool) {
+  assert(g!=NULL && src >= 0 && src < g->nb_vertices && dst >= 0 && dst < g->nb_vertices);
+  int nb_threads = thread_pool_size(pool);
+  if (k < 0) k = 0;
+  path_s **found = malloc((k > 0 ? k : 1)*sizeof(path_s *));
+  assert(found!=NULL);
+  int nb_found = 0;
+  path_s **candidates = NULL;
+  int nb_candidates = 0, capacity = 0;
+  // One workspace and one array of blocked vertices per task
+  spur_worker_s workers[nb_threads];
+  for (int w = 0; w < nb_threads; w++) {
+    workers[w] = (spur_worker_s){.g = g, .dst = dst, .worker = w, .nb_workers = nb_threads,
+                                 .ws = workspace_create(g->nb_vertices),
+                                 .blocked = calloc(g->nb_vertices, sizeof(unsigned int)),
+                                 .stamp = 0};
+    assert(workers[w].blocked!=NULL);
+  }
+  // The first path is the shortest path, i.e. the spur path of the trivial path (src)
+  path_s *start = path_create(1);
+  start->vertices[0] = src;
+  start->dist[0] = 0.0;
+  workers[0].last = start;
+  workers[0].found = found;
+  workers[0].nb_found = 0;
+  path_s *first = (k > 0) ? spur_search(&workers[0], 0) : NULL;
+  path_delete(start);
+  if (first != NULL) found[nb_found++] = first;
+  while (nb_found > 0 && nb_found < k) {
+    const path_s *last = found[nb_found-1];
+    int nb_spurs = last->length - 1;
+    path_s **spurs = calloc(nb_spurs > 0 ? nb_spurs : 1, sizeof(path_s *));
+    assert(spurs!=NULL);
+    int nb_active = (nb_threads < nb_spurs) ? nb_threads : nb_spurs;
+    for (int w = 0; w < nb_active; w++) {
+      workers[w].last = last;
+      workers[w].found = found;
+      workers[w].nb_found = nb_found;
+      workers[w].nb_workers = nb_active;
+      workers[w].spurs = spurs;
+    }
+    task_group_s group = TASK_GROUP_INIT;
+    for (int w = 0; w < nb_active; w++)
+      thread_pool_submit(pool, &group, spur_worker, &workers[w]);
+    thread_pool_wait(pool, &group);
+    // Merge the new candidates, in the order of the spur vertices
+    for (int i = 0; i < nb_spurs; i++) {
+      path_s *p = spurs[i];
+      if (p == NULL) continue;
+      bool duplicate = false;
+      for (int c = 0; c < nb_candidates && !duplicate; c++)
+        duplicate = path_equal(p, candidates[c]);
+      for (int a = 0; a < nb_found && !duplicate; a++)
+        duplicate = path_equal(p, found[a]);
+      if (duplicate) path_delete(p);
+      else candidates_push(&candidates, &nb_candidates, &capacity, p);
+    }
+    free(spurs);
+    if (nb_candidates == 0) break;
+    found[nb_found++] = candidates_pop(candidates, &nb_candidates);
+  }
+  // Compact form of the paths found
+  ksp_s *res = malloc(sizeof(ksp_s));
+  assert(res!=NULL);
+  res->nb_paths = nb_found;
+  res->first = malloc((nb_found+1)*sizeof(int));
+  assert(res->first!=NULL);
+  res->first[0] = 0;
+  for (int i = 0; i < nb_found; i++)
+    res->first[i+1] = res->first[i] + found[i]->length;
+  res->vertices = malloc((res->first[nb_found] > 0 ? res->first[nb_found] : 1)*sizeof(int));
+  res->dist = malloc((res->first[nb_found] > 0 ? res->first[nb_found] : 1)*sizeof(double));
+  assert(res->vertices!=NULL && res->dist!=NULL);
+  for (int i = 0; i < nb_found; i++) {
+    memcpy(res->vertices + res->first[i], found[i]->vertices, found[i]->length*sizeof(int));
+    memcpy(res->dist + res->first[i], found[i]->dist, found[i]->length*sizeof(double));
+    path_delete(found[i]);
+  }
+  // Clean up
+  for (int c = 0; c < nb_candidates; c++)
+    path_delete(candidates[c]);
+  free(candidates);
+  free(found);
+  for (int w = 0; w < nb_threads; w++) {
+    workspace_delete(workers[w].ws);
+    free(workers[w].blocked);
+  }
+  return res;
+}
+
+/**
+ * @brief Deletes a set of paths and frees its memory.
+ *
+ * @param p Pointer to the set of paths.
+ */
+void ksp_delete(ksp_s *p) {
+  if (!p) return;
+  free(p->first);
+  free(p->vertices);
+  free(p->dist);
+  free(p);
+}
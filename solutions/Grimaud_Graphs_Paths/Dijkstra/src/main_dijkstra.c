@@ -36,8 +36,37 @@
 #include <getopt.h>
 #include <math.h>
 #include <assert.h>
+#include <time.h>
+#include <sys/wait.h>
 #include "graph_list.h"
 #include "heap.h"
+#include "voronoi.h"
+#include "workspace.h"
+#include "isochrone.h"
+#include "bitset.h"
+#include "knn.h"
+#include "ksp.h"
+#include "phast.h"
+#include "thread_pool.h"
+#include "batch.h"
+#include "parallel_sssp.h"
+#include "numa_alloc.h"
+#include "graph_csr.h"
+#include "sssp_csr.h"
+#include "bfs.h"
+#include "mst.h"
+#include "grid.h"
+#include "implicit_graph.h"
+#include "sssp_engine.h"
+#include "sssp_approx.h"
+#include "oracle.h"
+#include "arcflags.h"
+#include "crp.h"
+#include "partition.h"
+#include "sharded_sssp.h"
+#include "pregel.h"
+#include "graph_store.h"
+#include "graph_shm.h"
 
 /**
  * @brief Performs Dijkstra's algorithm to find the shortest paths from the source vertex.
@@ -98,6 +127,32 @@ vertex_s *dijkstra(graph_s *g, int src) {
   return dist;
 }
 
+// The Dijkstra engine specialized for each graph backend
+SSSP_ENGINE(engine_list, graph_s *, GRAPH_LIST_FOREACH_EDGE, SSSP_WEIGHT)
+SSSP_ENGINE(engine_csr, const graph_csr_s *, GRAPH_CSR_FOREACH_EDGE, SSSP_WEIGHT)
+SSSP_ENGINE(engine_implicit, implicit_graph_s *, IMPLICIT_GRAPH_FOREACH_EDGE, SSSP_WEIGHT)
+
+/**
+ * @brief Generates the moves of the counter game, a state space given by a callback.
+ *
+ * The state is a counter between 0 and n-1 (n being stored in the context), which
+ * can be incremented, decremented or doubled, each move costing 1.
+ *
+ * @param ctx Pointer to the number of states n.
+ * @param u The current value of the counter.
+ * @param heads Array where the next values are written.
+ * @param weights Array where the costs of the moves are written.
+ * @return The number of moves.
+ */
+int counter_moves(void *ctx, int u, int *heads, double *weights) {
+  int n = *(int *)ctx;
+  int nb_moves = 0;
+  if (u + 1 < n) { heads[nb_moves] = u + 1; weights[nb_moves++] = 1.0; }
+  if (u > 0) { heads[nb_moves] = u - 1; weights[nb_moves++] = 1.0; }
+  if (u > 0 && u < n / 2) { heads[nb_moves] = 2 * u; weights[nb_moves++] = 1.0; }
+  return nb_moves;
+}
+
 /**
  * @brief Prints the shortest path from the source to the target vertex.
  * 
@@ -131,6 +186,682 @@ void print_path(graph_s *g, vertex_s *v, int dst) {
   return;
 }
 
+/**
+ * @brief Parses a comma separated list of vertices such as "0,4,7".
+ *
+ * @param str The string to parse.
+ * @param nb_vertices The number of vertices of the graph (used to check each vertex).
+ * @param list Address of the dynamically allocated array of vertices.
+ * @return The number of vertices read, or -1 if the list is invalid.
+ */
+int parse_vertex_list(const char *str, int nb_vertices, int **list) {
+  int count = 1;
+  for (const char *c = str; *c != '\0'; c++)
+    if (*c == ',') count++;
+  *list = malloc(count*sizeof(int));
+  assert(*list!=NULL);
+  const char *ptr = str;
+  for (int i = 0; i < count; i++) {
+    char *end;
+    long v = strtol(ptr, &end, 10);
+    if (end == ptr || v < 0 || v >= nb_vertices || (*end != ',' && *end != '\0')) {
+      free(*list);
+      *list = NULL;
+      return -1;
+    }
+    (*list)[i] = (int)v;
+    ptr = end + 1;
+  }
+  return count;
+}
+
+/**
+ * @brief Generates the edges of a random graph.
+ *
+ * Each vertex gets `degree` edges towards uniformly drawn vertices, with weights
+ * uniformly drawn in [1, 100]. The generator is seeded with a constant, so the same
+ * arguments always give the same graph.
+ *
+ * @param nb_vertices The number of vertices.
+ * @param degree The number of edges leaving each vertex.
+ * @param nb_edges Address where the number of edges is stored.
+ * @return A dynamically allocated array of edges.
+ */
+edge_s *random_edges(int nb_vertices, int degree, int *nb_edges) {
+  *nb_edges = nb_vertices * degree;
+  edge_s *edges = malloc((size_t)*nb_edges*sizeof(edge_s));
+  assert(edges!=NULL);
+  unsigned int seed = 1;
+  for (int e = 0; e < *nb_edges; e++)
+    edges[e] = (edge_s){e / degree, rand_r(&seed) % nb_vertices, 1.0 + rand_r(&seed) % 100};
+  return edges;
+}
+
+/**
+ * @brief Generates the edges of a road-like lattice graph.
+ *
+ * The vertex (x, y) is `y * width + x`; it is linked to its right and lower
+ * neighbours, with weights uniformly drawn in [1, 100] by a generator seeded with a
+ * constant. Unlike the random graphs, the lattice is planar with a large diameter,
+ * as road networks are.
+ *
+ * @param width The number of columns.
+ * @param height The number of rows.
+ * @param nb_edges Address where the number of edges is stored.
+ * @return A dynamically allocated array of edges.
+ */
+edge_s *lattice_edges(int width, int height, int *nb_edges) {
+  edge_s *edges = malloc(2*(size_t)width*height*sizeof(edge_s) + 1);
+  assert(edges!=NULL);
+  unsigned int seed = 1;
+  *nb_edges = 0;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int v = y * width + x;
+      if (x + 1 < width) edges[(*nb_edges)++] = (edge_s){v, v + 1, 1.0 + rand_r(&seed) % 100};
+      if (y + 1 < height) edges[(*nb_edges)++] = (edge_s){v, v + width, 1.0 + rand_r(&seed) % 100};
+    }
+  }
+  return edges;
+}
+
+/**
+ * @brief Gets the time elapsed since a given instant.
+ *
+ * @param start The instant.
+ * @return The time in milliseconds.
+ */
+double elapsed_ms(const struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec)*1e3 + (now.tv_nsec - start->tv_nsec)*1e-6;
+}
+
+/**
+ * @brief Compares the plain and the prefetching relaxation loops of the CSR Dijkstra.
+ *
+ * Runs the searches from the same pseudo-random sources with each loop, checks that
+ * they find the same distances and prints their running times.
+ *
+ * @param g The graph.
+ * @param nb_sources The number of searches per loop.
+ * @return false if the loops found different distances.
+ */
+bool benchmark_relax(graph_s *g, int nb_sources) {
+  int n = g->nb_vertices;
+  graph_csr_s *csr = graph_csr_create(g);
+  workspace_s *ws = workspace_create(n);
+  double *check = malloc(n*sizeof(double));
+  assert(check!=NULL);
+  const char *names[2] = {"plain", "prefetch"};
+  double time_ms[2];
+  bool same = true;
+  for (int relax = RELAX_PLAIN; relax <= RELAX_PREFETCH; relax++) {
+    unsigned int seed = 2;
+    time_ms[relax] = 0.0;
+    for (int i = 0; i < nb_sources; i++) {
+      int src = rand_r(&seed) % n;
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      dijkstra_csr(csr, src, relax, ws);
+      time_ms[relax] += elapsed_ms(&start);
+      // the last search of each loop is compared
+      for (int v = 0; i == nb_sources - 1 && v < n; v++) {
+        if (relax == RELAX_PLAIN) check[v] = workspace_dist(ws, v);
+        else if (check[v] != workspace_dist(ws, v)) same = false;
+      }
+    }
+  }
+  printf("\nCSR Dijkstra on %d vertices and %d edges, %d searches:\n", n, csr->nb_edges, nb_sources);
+  for (int relax = RELAX_PLAIN; relax <= RELAX_PREFETCH; relax++)
+    printf("%-8s relaxation: %10.2f ms (%.2f ms per search)\n", names[relax], time_ms[relax], time_ms[relax] / nb_sources);
+  printf("speedup of the prefetching loop: %.2f%s\n", time_ms[RELAX_PLAIN] / time_ms[RELAX_PREFETCH],
+         same ? "" : " (DIFFERENT DISTANCES)");
+  free(check);
+  workspace_delete(ws);
+  graph_csr_delete(csr);
+  return same;
+}
+
+/**
+ * @brief Compares the exact CSR Dijkstra with the (1+ε)-approximate bucket queue searches.
+ *
+ * Runs the searches from the same pseudo-random sources with both engines, prints
+ * their running times and the largest relative error of the approximate lengths.
+ *
+ * @param g The graph.
+ * @param nb_sources The number of searches per engine.
+ * @param epsilon The bound of the relative error.
+ * @param rounding The rounding of the weights.
+ * @return false if the rounding was refused or an error exceeds the bound.
+ */
+bool benchmark_approx(graph_s *g, int nb_sources, double epsilon, rounding_e rounding) {
+  int n = g->nb_vertices;
+  graph_csr_s *csr = graph_csr_create(g);
+  sssp_approx_s *a = sssp_approx_create(csr, epsilon, rounding);
+  if (a == NULL) {
+    fprintf(stderr, "Error: The grid rounding needs too many buckets, use the geometric rounding or a larger epsilon\n");
+    graph_csr_delete(csr);
+    return false;
+  }
+  workspace_s *ws = workspace_create(n);
+  vertex_s *dst = malloc(n*sizeof(vertex_s));
+  assert(dst!=NULL);
+  double exact_ms = 0.0, approx_ms = 0.0, max_error = 0.0;
+  unsigned int seed = 2;
+  for (int i = 0; i < nb_sources; i++) {
+    int src = rand_r(&seed) % n;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    dijkstra_csr(csr, src, RELAX_PREFETCH, ws);
+    exact_ms += elapsed_ms(&start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    sssp_approx_query(a, src, dst);
+    approx_ms += elapsed_ms(&start);
+    for (int v = 0; v < n; v++) {
+      double d = workspace_dist(ws, v);
+      if (d > 0.0 && d != INFINITY && dst[v].weight / d - 1.0 > max_error)
+        max_error = dst[v].weight / d - 1.0;
+    }
+  }
+  printf("\nCSR Dijkstra on %d vertices and %d edges, %d searches:\n", n, csr->nb_edges, nb_sources);
+  printf("exact  (binary heap)  : %10.2f ms (%.2f ms per search)\n", exact_ms, exact_ms / nb_sources);
+  printf("approx (bucket queue) : %10.2f ms (%.2f ms per search, %d buckets)\n", approx_ms, approx_ms / nb_sources, a->nb_buckets);
+  printf("speedup: %.2f, largest relative error: %.4f%% (bound %.4f%%)\n", exact_ms / approx_ms, 100.0 * max_error, 100.0 * epsilon);
+  bool bounded = max_error <= epsilon * (1.0 + 1e-9);
+  free(dst);
+  workspace_delete(ws);
+  sssp_approx_delete(a);
+  graph_csr_delete(csr);
+  return bounded;
+}
+
+/**
+ * @brief Times the queries of a distance oracle on pseudo-random pairs of vertices.
+ *
+ * @param o The oracle.
+ * @param nb_pairs The number of queries.
+ */
+void benchmark_oracle(const oracle_s *o, int nb_pairs) {
+  int n = o->nb_vertices;
+  int *pairs = malloc(2*(size_t)nb_pairs*sizeof(int));
+  assert(pairs!=NULL);
+  unsigned int seed = 3;
+  for (int i = 0; i < 2*nb_pairs; i++)
+    pairs[i] = rand_r(&seed) % n;
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  double sum = 0.0;
+  int nb_reachable = 0;
+  for (int i = 0; i < nb_pairs; i++) {
+    double d = oracle_query(o, pairs[2*i], pairs[2*i + 1]);
+    if (d != INFINITY) {
+      sum += d;
+      nb_reachable++;
+    }
+  }
+  double time_ms = elapsed_ms(&start);
+  printf("%d queries in %.2f ms (%.1f ns per query), mean estimate %.2f over %d connected pairs\n", nb_pairs,
+         time_ms, 1e6 * time_ms / nb_pairs, nb_reachable ? sum / nb_reachable : 0.0, nb_reachable);
+  free(pairs);
+}
+
+/**
+ * @brief Measures the stretch of a distance oracle against exact Dijkstra searches.
+ *
+ * @param g The graph of the oracle.
+ * @param o The oracle.
+ * @param nb_sources The number of pseudo-random sources, compared with all the vertices.
+ * @return false if an estimate is out of [d, (2k-1) d].
+ */
+bool check_oracle(graph_s *g, const oracle_s *o, int nb_sources) {
+  int n = g->nb_vertices;
+  graph_csr_s *csr = graph_csr_create(g);
+  workspace_s *ws = workspace_create(n);
+  double max_stretch = 1.0, sum_stretch = 0.0;
+  long nb_pairs = 0;
+  bool bounded = true;
+  unsigned int seed = 2;
+  for (int i = 0; i < nb_sources; i++) {
+    int src = rand_r(&seed) % n;
+    dijkstra_csr(csr, src, RELAX_PREFETCH, ws);
+    for (int v = 0; v < n; v++) {
+      double d = workspace_dist(ws, v), estimate = oracle_query(o, src, v);
+      if (d == INFINITY || d == 0.0) {
+        bounded = bounded && (estimate == d);
+        continue;
+      }
+      double stretch = estimate / d;
+      // the oracle stores single precision distances
+      if (stretch < 1.0 - 1e-5 || stretch > (2*o->k - 1) * (1.0 + 1e-5)) bounded = false;
+      if (stretch > max_stretch) max_stretch = stretch;
+      sum_stretch += stretch;
+      nb_pairs++;
+    }
+  }
+  printf("stretch over %ld pairs: mean %.3f, max %.3f (bound %d)%s\n", nb_pairs,
+         nb_pairs ? sum_stretch / nb_pairs : 1.0, max_stretch, 2*o->k - 1, bounded ? "" : " (OUT OF BOUNDS)");
+  workspace_delete(ws);
+  graph_csr_delete(csr);
+  return bounded;
+}
+
+/**
+ * @brief Compares point-to-point searches with and without arc flags.
+ *
+ * Runs the searches between the same pseudo-random pairs of vertices with and
+ * without pruning, checks that they find the same distances and prints their
+ * running times and numbers of settled vertices.
+ *
+ * @param af The arc flags.
+ * @param nb_pairs The number of searches per mode.
+ * @return false if the searches found different distances.
+ */
+bool benchmark_arcflags(const arcflags_s *af, int nb_pairs) {
+  int n = af->csr->nb_vertices;
+  workspace_s *ws = workspace_create(n);
+  double time_ms[2] = {0.0, 0.0}, settled[2] = {0.0, 0.0};
+  bool same = true;
+  unsigned int seed = 2;
+  for (int i = 0; i < nb_pairs; i++) {
+    int src = rand_r(&seed) % n, dst = rand_r(&seed) % n;
+    double dist[2];
+    for (int prune = 0; prune <= 1; prune++) {
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      dist[prune] = arcflags_query(af, src, dst, prune, ws);
+      time_ms[prune] += elapsed_ms(&start);
+      settled[prune] += ws->nb_settled;
+    }
+    if (dist[0] != dist[1]) same = false;
+  }
+  printf("\nPoint-to-point searches on %d vertices and %d edges, %d pairs:\n", n, af->csr->nb_edges, nb_pairs);
+  printf("plain     : %10.2f ms (%.3f ms per search, %.0f vertices settled)\n",
+         time_ms[0], time_ms[0] / nb_pairs, settled[0] / nb_pairs);
+  printf("arc flags : %10.2f ms (%.3f ms per search, %.0f vertices settled)\n",
+         time_ms[1], time_ms[1] / nb_pairs, settled[1] / nb_pairs);
+  printf("speedup: %.2f%s\n", time_ms[0] / time_ms[1], same ? "" : " (DIFFERENT DISTANCES)");
+  workspace_delete(ws);
+  return same;
+}
+
+/**
+ * @brief Compares plain bidirectional searches with the searches on the overlays.
+ *
+ * Runs the searches between the same pseudo-random pairs of vertices in both
+ * modes, checks that they find the same distances and prints their running times
+ * and numbers of settled vertices.
+ *
+ * @param crp The prepared graph, customized.
+ * @param nb_pairs The number of searches per mode.
+ * @return false if the searches found different distances.
+ */
+bool benchmark_crp(const crp_s *crp, int nb_pairs) {
+  int n = crp->csr->nb_vertices;
+  workspace_s *fwd = workspace_create(n);
+  workspace_s *bwd = workspace_create(n);
+  double time_ms[2] = {0.0, 0.0}, settled[2] = {0.0, 0.0};
+  bool same = true;
+  unsigned int seed = 2;
+  for (int i = 0; i < nb_pairs; i++) {
+    int src = rand_r(&seed) % n, dst = rand_r(&seed) % n;
+    double dist[2];
+    for (int overlays = 0; overlays <= 1; overlays++) {
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      dist[overlays] = crp_query(crp, src, dst, overlays, fwd, bwd);
+      time_ms[overlays] += elapsed_ms(&start);
+      settled[overlays] += fwd->nb_settled + bwd->nb_settled;
+    }
+    // the cliques add the weights in another order
+    if (fabs(dist[0] - dist[1]) > 1e-9 * dist[0]) same = false;
+  }
+  printf("bidirectional : %10.2f ms (%.3f ms per search, %.0f vertices settled)\n",
+         time_ms[0], time_ms[0] / nb_pairs, settled[0] / nb_pairs);
+  printf("overlays      : %10.2f ms (%.3f ms per search, %.0f vertices settled)\n",
+         time_ms[1], time_ms[1] / nb_pairs, settled[1] / nb_pairs);
+  printf("speedup: %.2f%s\n", time_ms[0] / time_ms[1], same ? "" : " (DIFFERENT DISTANCES)");
+  workspace_delete(bwd);
+  workspace_delete(fwd);
+  return same;
+}
+
+/**
+ * @brief Compares CSR searches on the graph and on its vertices numbered part by part.
+ *
+ * The vertices of a part get consecutive indices, so that a search working in a
+ * part touches fewer cache lines and pages. Runs the searches from the same
+ * pseudo-random sources on both numberings and checks their last distances.
+ *
+ * @param g The graph.
+ * @param p A partition of its vertices.
+ * @param nb_sources The number of searches per numbering.
+ * @param pool The thread pool (used to build the renumbered graph).
+ * @return false if the searches found different distances.
+ */
+bool benchmark_partition(graph_s *g, const partition_s *p, int nb_sources, thread_pool_s *pool) {
+  int n = g->nb_vertices;
+  int *index = partition_permutation(p);
+  // The adjacencies already hold both directions of the undirected edges
+  int nb_adjacencies = 0;
+  for (int u = 0; u < n; u++)
+    for (adj_list_s *adj = get_adj_list(g, u); adj != NULL; adj = adj->next)
+      nb_adjacencies++;
+  edge_s *edges = malloc((nb_adjacencies + 1) * sizeof(edge_s));
+  assert(edges!=NULL);
+  int k = 0;
+  for (int u = 0; u < n; u++)
+    for (adj_list_s *adj = get_adj_list(g, u); adj != NULL; adj = adj->next)
+      edges[k++] = (edge_s){index[u], index[adj->vertex.ind], adj->vertex.weight};
+  graph_s *blocked = create_graph_parallel(n, nb_adjacencies, true, edges, pool);
+  free(edges);
+  graph_csr_s *csr[2] = {graph_csr_create(g), graph_csr_create(blocked)};
+  workspace_s *ws[2] = {workspace_create(n), workspace_create(n)};
+  double time_ms[2] = {0.0, 0.0};
+  bool same = true;
+  unsigned int seed = 2;
+  for (int i = 0; i < nb_sources; i++) {
+    int src = rand_r(&seed) % n;
+    for (int b = 0; b <= 1; b++) {
+      struct timespec start;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      dijkstra_csr(csr[b], b ? index[src] : src, RELAX_PREFETCH, ws[b]);
+      time_ms[b] += elapsed_ms(&start);
+    }
+    for (int v = 0; i == nb_sources - 1 && v < n; v++)
+      if (workspace_dist(ws[0], v) != workspace_dist(ws[1], index[v])) same = false;
+  }
+  printf("\nCSR Dijkstra, %d searches:\n", nb_sources);
+  printf("original numbering : %10.2f ms (%.2f ms per search)\n", time_ms[0], time_ms[0] / nb_sources);
+  printf("part by part       : %10.2f ms (%.2f ms per search)\n", time_ms[1], time_ms[1] / nb_sources);
+  printf("speedup: %.2f%s\n", time_ms[0] / time_ms[1], same ? "" : " (DIFFERENT DISTANCES)");
+  for (int b = 0; b <= 1; b++) {
+    workspace_delete(ws[b]);
+    graph_csr_delete(csr[b]);
+  }
+  delete_graph(blocked);
+  free(index);
+  return same;
+}
+
+/**
+ * @brief Prints the statistics of a partition.
+ *
+ * @param name The name of the partition.
+ * @param p The partition.
+ */
+void print_partition(const char *name, const partition_s *p) {
+  printf("%-10s: edge cut %lld (%.2f%% of %lld edges), %d boundary vertices, imbalance %.3f\n", name, p->edge_cut,
+         p->nb_edges > 0 ? 100.0 * p->edge_cut / p->nb_edges : 0.0, p->nb_edges, p->nb_boundary,
+         partition_imbalance(p));
+}
+
+/**
+ * @brief Structure representing the counters of one reader of `serve_queries`.
+ */
+typedef struct {
+  long nb_queries;  /**< Number of queries answered */
+  long nb_switches; /**< Number of times the reader got a newer version */
+  double total_ms;  /**< Total time of the queries */
+  double max_ms;    /**< Longest query */
+  bool ok;          /**< Cleared if the reader got a version older than its previous one */
+} serve_counters_s;
+
+/**
+ * @brief Structure shared by the readers of `serve_queries`.
+ */
+typedef struct {
+  graph_store_s *store;       /**< The store of the versions */
+  int nb_vertices;            /**< Number of vertices of every version */
+  relax_e relax;              /**< Relaxation loop of the searches */
+  bool stop;                  /**< Set when the readers must return */
+  serve_counters_s *counters; /**< Counters of each reader */
+} serve_s;
+
+/**
+ * @brief Answers queries on the current version until the serving stops (one reader).
+ *
+ * Each query enters the current version, runs a CSR search from a pseudo-random
+ * source and leaves the version.
+ *
+ * @param arg The serve_s structure.
+ */
+void serve_reader(void *arg) {
+  serve_s *sv = arg;
+  int reader = thread_pool_worker_id();
+  reader = reader < 0 ? 0 : reader;
+  workspace_s *ws = workspace_create(sv->nb_vertices);
+  unsigned int seed = 2 + reader;
+  serve_counters_s c = {0, 0, 0.0, 0.0, true};
+  unsigned long last_id = 0;
+  while (!__atomic_load_n(&sv->stop, __ATOMIC_RELAXED)) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    const graph_version_s *v = graph_store_enter(sv->store, reader);
+    if (v->id < last_id) c.ok = false;
+    c.nb_switches += (v->id > last_id);
+    last_id = v->id;
+    dijkstra_csr(v->csr, rand_r(&seed) % sv->nb_vertices, sv->relax, ws);
+    graph_store_exit(sv->store, reader);
+    double ms = elapsed_ms(&start);
+    c.total_ms += ms;
+    if (ms > c.max_ms) c.max_ms = ms;
+    c.nb_queries++;
+  }
+  workspace_delete(ws);
+  sv->counters[reader] = c;
+}
+
+/**
+ * @brief Serves CSR queries while new versions of the graph are built and published.
+ *
+ * Every worker of the pool answers queries on the current version. Meanwhile, the
+ * calling thread builds each new version from the edges with 10% of new weights
+ * (live traffic), publishes it and lets the store free the old versions once no
+ * query uses them. The store takes the ownership of the graph.
+ *
+ * @param g The graph (first version).
+ * @param edges The edges of the graph.
+ * @param nb_edges The number of edges.
+ * @param nb_reloads The number of new versions to publish.
+ * @param relax The relaxation loop of the searches.
+ * @param pool The thread pool (one reader per worker).
+ * @return false if a reader went back to an older version.
+ */
+bool serve_queries(graph_s *g, const edge_s *edges, int nb_edges, int nb_reloads, relax_e relax, thread_pool_s *pool) {
+  int nb_readers = thread_pool_size(pool);
+  serve_s sv = {.store = graph_store_create(g, graph_csr_create(g), nb_readers), .nb_vertices = g->nb_vertices,
+                .relax = relax, .stop = false, .counters = calloc(nb_readers, sizeof(serve_counters_s))};
+  assert(sv.counters!=NULL);
+  bool directed = g->directed;
+  task_group_s group = TASK_GROUP_INIT;
+  for (int r = 0; r < nb_readers; r++)
+    thread_pool_submit_to(pool, r, &group, serve_reader, &sv);
+  edge_s *updated = malloc((size_t)nb_edges * sizeof(edge_s));
+  assert(updated!=NULL);
+  double build_ms = 0.0, publish_ms = 0.0, max_publish_ms = 0.0;
+  struct timespec serve_start;
+  clock_gettime(CLOCK_MONOTONIC, &serve_start);
+  unsigned int seed = 4;
+  for (int reload = 1; reload <= nb_reloads; reload++) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int e = 0; e < nb_edges; e++) {
+      updated[e] = edges[e];
+      if (rand_r(&seed) % 10 == 0)
+        updated[e].weight *= 1.0 + (rand_r(&seed) % 200) / 100.0;
+    }
+    graph_s *next = create_graph_parallel(sv.nb_vertices, nb_edges, directed, updated, NULL);
+    assert(next!=NULL);
+    graph_csr_s *next_csr = graph_csr_create(next);
+    build_ms += elapsed_ms(&start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    graph_store_publish(sv.store, next, next_csr);
+    double ms = elapsed_ms(&start);
+    publish_ms += ms;
+    if (ms > max_publish_ms) max_publish_ms = ms;
+  }
+  graph_store_synchronize(sv.store);
+  double serve_ms = elapsed_ms(&serve_start);
+  __atomic_store_n(&sv.stop, true, __ATOMIC_RELAXED);
+  thread_pool_wait(pool, &group);
+  serve_counters_s total = {0, 0, 0.0, 0.0, true};
+  for (int r = 0; r < nb_readers; r++) {
+    total.nb_queries += sv.counters[r].nb_queries;
+    total.nb_switches += sv.counters[r].nb_switches;
+    total.total_ms += sv.counters[r].total_ms;
+    if (sv.counters[r].max_ms > total.max_ms) total.max_ms = sv.counters[r].max_ms;
+    total.ok = total.ok && sv.counters[r].ok;
+  }
+  graph_store_stats_s stats = graph_store_stats(sv.store);
+  printf("\n%d versions published in %.2f ms: build %.2f ms, publication and freeing %.3f ms (at most %.3f ms) per version\n",
+         nb_reloads, serve_ms, build_ms / nb_reloads, publish_ms / nb_reloads, max_publish_ms);
+  printf("%lu versions freed after their grace period, %d pending\n", stats.nb_reclaimed, stats.nb_pending);
+  printf("%ld queries by %d readers (%.1f per second), %.3f ms per query, longest %.3f ms, %ld version switches%s\n",
+         total.nb_queries, nb_readers, total.nb_queries / (serve_ms / 1e3), total.total_ms / total.nb_queries,
+         total.max_ms, total.nb_switches, total.ok ? "" : " (OLDER VERSION SEEN)");
+  free(sv.counters);
+  free(updated);
+  graph_store_delete(sv.store);
+  return total.ok;
+}
+
+/**
+ * @brief Runs CSR searches on a graph segment in a forked worker process.
+ *
+ * The worker attaches the segment by its name, as an unrelated process would,
+ * times the searches from pseudo-random sources and prints its resident memory,
+ * of which the pages of the segment are shared with the other processes.
+ *
+ * @param name The name of the segment.
+ * @param worker The index of the worker.
+ * @param nb_searches The number of searches.
+ * @param relax The relaxation loop of the searches.
+ * @return false if the segment could not be attached.
+ */
+bool shm_worker(const char *name, int worker, int nb_searches, relax_e relax) {
+  graph_shm_s *shm = graph_shm_attach(name);
+  if (shm == NULL) return false;
+  int n = shm->csr.nb_vertices;
+  workspace_s *ws = workspace_create(n);
+  unsigned int seed = 2 + worker;
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < nb_searches; i++)
+    dijkstra_csr(&shm->csr, rand_r(&seed) % n, relax, ws);
+  double time_ms = elapsed_ms(&start);
+  // resident and shared pages of the process
+  long resident = 0, shared = 0;
+  FILE *f = fopen("/proc/self/statm", "r");
+  if (f != NULL) {
+    if (fscanf(f, "%*s %ld %ld", &resident, &shared) != 2) resident = shared = 0;
+    fclose(f);
+  }
+  long page = sysconf(_SC_PAGESIZE);
+  printf("worker %d (pid %d): %d searches in %.2f ms (%.2f ms per search), %.1f MB resident, %.1f MB shared\n",
+         worker, (int)getpid(), nb_searches, time_ms, time_ms / nb_searches, resident * page / 1e6, shared * page / 1e6);
+  fflush(stdout);
+  workspace_delete(ws);
+  graph_shm_detach(shm);
+  return true;
+}
+
+/**
+ * @brief Runs CSR searches on a graph segment in several processes at once.
+ *
+ * @param name The name of the segment.
+ * @param nb_processes The number of worker processes.
+ * @param nb_searches The number of searches per process.
+ * @param relax The relaxation loop of the searches.
+ * @return false if a worker failed.
+ */
+bool run_shm_workers(const char *name, int nb_processes, int nb_searches, relax_e relax) {
+  fflush(stdout);
+  for (int w = 0; w < nb_processes; w++) {
+    pid_t pid = fork();
+    if (pid == -1) {
+      perror("fork");
+      return false;
+    }
+    if (pid == 0) _exit(shm_worker(name, w, nb_searches, relax) ? 0 : 1);
+  }
+  bool ok = true;
+  for (int w = 0; w < nb_processes; w++) {
+    int status;
+    if (wait(&status) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+  }
+  return ok;
+}
+
+/**
+ * @brief Parses the coordinates of a cell such as "12,7".
+ *
+ * @param str The string to parse.
+ * @param g The grid (used to check the coordinates).
+ * @return The index of the cell, or -1 if the coordinates are invalid.
+ */
+int parse_cell(const char *str, const grid_s *g) {
+  char *end;
+  long x = strtol(str, &end, 10);
+  if (end == str || *end != ',') return -1;
+  const char *ptr = end + 1;
+  long y = strtol(ptr, &end, 10);
+  if (end == ptr || *end != '\0' || x < 0 || y < 0 || x >= g->width || y >= g->height) return -1;
+  return (int)(y * g->width + x);
+}
+
+/**
+ * @brief Runs the shortest path searches between two cells of a grid and prints them.
+ *
+ * @param g The grid.
+ * @param from The source cell "x,y".
+ * @param to The target cell "x,y".
+ * @param search The name of the search: "dijkstra", "astar", "jps" or "all".
+ * @return false if the arguments are invalid.
+ */
+bool run_grid_searches(const grid_s *g, const char *from, const char *to, const char *search) {
+  const char *names[3] = {"dijkstra", "astar", "jps"};
+  int src = (from != NULL) ? parse_cell(from, g) : -1;
+  int dst = (to != NULL) ? parse_cell(to, g) : -1;
+  int first = 0, last = 2;
+  for (int k = 0; k < 3; k++)
+    if (strcmp(search, names[k]) == 0) first = last = k;
+  if (src < 0 || dst < 0 || (first != last && strcmp(search, "all") != 0)) {
+    fprintf(stderr, "Error: --grid requires valid --from and --to cells and --grid-search\n");
+    return false;
+  }
+  int nb_cells = g->width * g->height;
+  workspace_s *ws = workspace_create(nb_cells);
+  int *cells = malloc(nb_cells*sizeof(int));
+  assert(cells!=NULL);
+  printf("Grid of %d x %d cells, %d-connected, %s costs\n", g->width, g->height, g->connectivity, g->uniform ? "uniform" : "varying");
+  for (int k = first; k <= last; k++) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double cost = grid_search(g, src, dst, k, ws);
+    double time_ms = elapsed_ms(&start);
+    printf("\n%s%s: ", names[k], (k == GRID_JPS && !grid_jps_exact(g)) ? " (not exact on this grid, A* used)" : "");
+    if (cost == INFINITY) {
+      printf("no path (%d cells settled, %.2f ms)\n", ws->nb_settled, time_ms);
+      continue;
+    }
+    int n = grid_path(g, ws, dst, cells);
+    printf("cost %.2f, %d cells, %d cells settled, %.2f ms\n", cost, n, ws->nb_settled, time_ms);
+    for (int i = 0; n <= 100 && i < n; i++)
+      printf("(%d,%d)%s", cells[i] % g->width, cells[i] / g->width, (i < n - 1) ? " → " : "\n");
+  }
+  free(cells);
+  workspace_delete(ws);
+  return true;
+}
+
+/**
+ * @brief Prints the pages obtained for the large arrays (registered with atexit).
+ */
+void print_huge_pages_report(void) {
+  numa_report(stdout);
+}
+
 /**
  * @brief Prints the help message with usage examples.
  */
@@ -141,9 +872,98 @@ void print_help(char *prog_name) {
   printf("  -d, --directed          Specify that the graph is a directed graph (default: undirected)\n");
   printf("  -v, --vertices <number> Specify the number of vertices\n");
   printf("  -a, --adjacencies       Specify the adjacency list in the format \"src:dst1,dst2 ...\"\n");
+  printf("  -g, --random <degree>   Generate a random graph with <degree> edges per vertex instead of -a\n");
+  printf("  -L, --lattice <WxH>     Generate a road-like lattice of W x H vertices instead of -v and -a\n");
   printf("  -s, --start             Specify the start vertex for Dijkstra (default: 0)\n");
+  printf("  -m, --seeds <list>      Run a multi-source Dijkstra from the seeds \"s1,s2,...\" (Voronoi cells)\n");
+  printf("  -r, --radius <distance> Only settle the vertices within the distance from the start vertex\n");
+  printf("  -T, --targets <list>    Specify the target vertices \"t1,t2,...\" of a k-nearest query\n");
+  printf("  -k, --nearest <number>  Find the k targets closest to the start vertex (default: 1)\n");
+  printf("  -t, --target <vertex>   Specify the target vertex of the k-shortest paths\n");
+  printf("  -K, --paths <number>    Find the K shortest loopless paths from the start to the target vertex\n");
+  printf("  -j, --threads <number>  Specify the number of threads (default: number of online processors)\n");
+  printf("      --pin               Pin each worker thread to a processor\n");
+  printf("  -b, --batch <list>      Compute the distances from all the sources \"s1,s2,...\" in parallel\n");
+  printf("  -H, --phast             Compute the distances from the start vertex with PHAST (vertex hierarchy)\n");
+  printf("  -P, --parallel          Run a parallel label-correcting Dijkstra on a relaxed priority queue\n");
+  printf("  -B, --bfs               Compute the hop distances from the start vertex (weights ignored)\n");
+  printf("      --msbfs <list>      Compute the hop distances from the sources \"s1,s2,...\" in one bit-parallel BFS,\n");
+  printf("                          or the all-pairs hop statistics with \"all\"\n");
+  printf("      --many-to-one       Compute the distances from all the vertices to the target vertex with a backward\n");
+  printf("                          search on the transpose, or check --bench <number> of them against forward searches\n");
+  printf("      --mst               Compute a minimum spanning forest with a parallel Borůvka and with Prim\n");
+  printf("      --pregel <program>  Run the vertex program \"sssp\" (from the start vertex), \"components\" or\n");
+  printf("                          \"pagerank\" on the bulk-synchronous engine\n");
+  printf("      --serve <n>         Answer CSR queries from random sources on every thread while n new versions\n");
+  printf("                          of the graph (10%% of new weights each) are built and hot-swapped\n");
+  printf("      --grid <file>       Search a grid read from a cost raster \"width height c00 c01 ...\" ('#' for an obstacle)\n");
+  printf("      --grid-random <WxH> Search a random grid of cost 1 with 20%% of obstacles\n");
+  printf("      --connectivity <n>  Connect each cell to its 4 or 8 (default) neighbours\n");
+  printf("      --from <x,y>        Specify the source cell of the grid searches\n");
+  printf("      --to <x,y>          Specify the target cell of the grid searches\n");
+  printf("      --grid-search <s>   Search the grid with \"dijkstra\", \"astar\", \"jps\" or \"all\" (default)\n");
+  printf("      --engine <backend>  Compute the paths from the start vertex with the generic engine on \"list\" or \"csr\"\n");
+  printf("      --implicit <n>      Search the counter game (+1, -1, x2) over n states from the start to the target,\n");
+  printf("                          its moves being generated by a callback\n");
+  printf("      --approx <epsilon>  Compute paths from the start vertex at most (1+epsilon) times longer than the\n");
+  printf("                          shortest ones, with rounded weights and a bucket queue\n");
+  printf("      --rounding <kind>   Round the weights of --approx to a \"grid\" of multiples (default) or to\n");
+  printf("                          \"geometric\" powers of (1+epsilon)\n");
+  printf("      --oracle-build <file> Build a distance oracle of stretch 2k-1 of the (undirected) graph and save it\n");
+  printf("      --oracle-k <k>      Number of levels of the oracle (default: 3)\n");
+  printf("      --oracle <file>     Map an oracle file and estimate the distance from the start to the target\n");
+  printf("                          vertex, or time --bench <number> queries on random pairs\n");
+  printf("      --arc-flags <R>     Compute arc flags for R regions (at most 64) and search from the start to\n");
+  printf("                          the target vertex, or compare --bench <number> searches with plain ones\n");
+  printf("      --crp <levels>      Build multi-level overlays, customize them and search from the start to the\n");
+  printf("                          target vertex, or compare --bench <number> searches before and after a\n");
+  printf("                          change of 10%% of the weights\n");
+  printf("      --partition <k>     Split the vertices into k parts cutting few edges (multilevel k-way partitioner),\n");
+  printf("                          and compare --bench <number> searches on the vertices numbered part by part\n");
+  printf("      --imbalance <eps>   Largest part of --partition at most (1+eps) times the average (default: 0.03)\n");
+  printf("      --partition-out <file> Write the part of each vertex, one per line\n");
+  printf("      --shards <k>        Compute the paths from the start vertex with k processes, each owning a\n");
+  printf("                          shard of the graph (split by the partitioner) and exchanging boundary updates\n");
+  printf("      --shard-delta <d>   Width of the distance buckets of --shards (default: mean weight, \"inf\" for\n");
+  printf("                          Bellman-Ford rounds)\n");
+  printf("      --shm-build <name>  Write the CSR graph into the shared-memory segment \"/name\" (replaced if it exists)\n");
+  printf("      --shm <name>        Map the graph segment read-only and search from the start vertex, or run\n");
+  printf("                          --bench <number> searches in each of --processes <k> processes (default: 1)\n");
+  printf("      --shm-unlink <name> Remove the graph segment\n");
+  printf("      --relax <loop>      Relaxation loop of the CSR searches: \"prefetch\" (default) or \"plain\"\n");
+  printf("      --bench <number>    Time <number> CSR searches with the plain and the prefetching loops,\n");
+  printf("                          or the exact and the approximate searches with --approx\n");
+  printf("      --huge-pages <kind> Back the large arrays with \"thp\" (default), \"hugetlb\" or \"none\" huge pages, and report them\n");
   printf("\nExamples:\n");
   printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -m 0,5\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 -r 5.5\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 -T 0,4,6,7 -k 2\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 0 -t 7 -K 3\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 -H\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -b 0,3,5 -j 4\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 -P -j 4\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 --huge-pages hugetlb\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 -B\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" --msbfs 0,3,5\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" --mst\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -d -t 7 --many-to-one\n",prog_name);
+  printf("  %s -v 1000000 -g 4 --pregel pagerank -j 4\n",prog_name);
+  printf("  %s -L 1000x1000 --serve 10 -j 4\n",prog_name);
+  printf("  %s --grid-random 2000x2000 --from 0,0 --to 1999,1999\n",prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3 --engine csr\n",prog_name);
+  printf("  %s --implicit 10000 -s 1 -t 9999\n",prog_name);
+  printf("  %s -v 1000000 -g 4 --bench 10\n",prog_name);
+  printf("  %s -v 1000000 -g 4 --approx 0.01 --bench 10\n",prog_name);
+  printf("  %s -v 100000 -g 4 --oracle-build graph.tzo --oracle-k 3 --bench 10\n",prog_name);
+  printf("  %s --oracle graph.tzo --bench 1000000\n",prog_name);
+  printf("  %s -v 1000000 -g 4 --shm-build /roads\n",prog_name);
+  printf("  %s --shm /roads --processes 4 --bench 10\n",prog_name);
+  printf("  %s -L 300x300 --arc-flags 32 --bench 100 -j 4\n",prog_name);
+  printf("  %s -L 300x300 --crp 3 --bench 200 -j 4\n",prog_name);
+  printf("  %s -v 1000000 -g 4 --partition 64 --partition-out parts.txt --bench 10 -j 4\n",prog_name);
+  printf("  %s -v 1000000 -g 4 --shards 4\n",prog_name);
+  printf("  %s -v 100000 -g 8 --msbfs all -j 4\n",prog_name);
   printf("  %s --vertices 5 --adjancencies \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0\" --directed\n",prog_name);
 }
 
@@ -159,6 +979,52 @@ int main(int argc, char **argv) {
   char *edges_list = NULL;
   bool directed = false;
   int initial_vertex = 0;
+  char *seeds_list = NULL;
+  double radius = -1.0;
+  char *targets_list = NULL;
+  int nb_nearest = 1;
+  int target_vertex = -1;
+  int nb_paths = 0;
+  int nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  bool use_phast = false;
+  bool use_parallel = false;
+  bool pin_threads = false;
+  char *batch_list = NULL;
+  int random_degree = 0;
+  char *lattice_size = NULL;
+  bool generated = false;
+  int nb_regions = 0;
+  int crp_levels = 0;
+  int nb_parts = 0;
+  double imbalance = 0.03;
+  char *partition_file = NULL;
+  int nb_shards = 0;
+  double shard_delta = 0.0;
+  bool use_bfs = false;
+  char *msbfs_list = NULL;
+  bool use_mst = false;
+  char *pregel_program = NULL;
+  bool use_many_to_one = false;
+  int nb_reloads = 0;
+  char *shm_build_name = NULL;
+  char *shm_name = NULL;
+  char *shm_unlink_name = NULL;
+  int nb_processes = 1;
+  char *grid_file = NULL;
+  char *grid_random_size = NULL;
+  int connectivity = 8;
+  char *from_cell = NULL;
+  char *to_cell = NULL;
+  char *grid_search_name = "all";
+  char *engine_backend = NULL;
+  int implicit_states = 0;
+  int nb_bench = 0;
+  double approx_epsilon = 0.0;
+  rounding_e rounding = ROUND_GRID;
+  char *oracle_build_file = NULL;
+  char *oracle_file = NULL;
+  int oracle_k = 3;
+  relax_e relax = RELAX_PREFETCH;
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
       print_help(argv[0]);
@@ -179,6 +1045,69 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Error: Missing argument for --adjacencies\n");
         return 1;
       }
+    } else if (strcmp(argv[i], "-L") == 0 || strcmp(argv[i], "--lattice") == 0) {
+      if (i + 1 < argc) {
+        lattice_size = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --lattice\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--crp") == 0) {
+      if (i + 1 < argc && (crp_levels = atoi(argv[i + 1])) >= 1 && crp_levels <= CRP_MAX_LEVELS) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --crp (1 to %d levels)\n", CRP_MAX_LEVELS);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--partition") == 0) {
+      if (i + 1 < argc && (nb_parts = atoi(argv[i + 1])) >= 1) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --partition (positive number of parts)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--imbalance") == 0) {
+      if (i + 1 < argc && (imbalance = atof(argv[i + 1])) >= 0.0) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --imbalance (non negative)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--partition-out") == 0) {
+      if (i + 1 < argc) {
+        partition_file = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --partition-out\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--shards") == 0) {
+      if (i + 1 < argc && (nb_shards = atoi(argv[i + 1])) >= 1) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --shards (positive number of processes)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--shard-delta") == 0) {
+      if (i + 1 < argc && (shard_delta = atof(argv[i + 1])) > 0.0) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --shard-delta (positive width)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--arc-flags") == 0) {
+      if (i + 1 < argc && (nb_regions = atoi(argv[i + 1])) >= 1 && nb_regions <= ARCFLAGS_MAX_REGIONS) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --arc-flags (1 to %d regions)\n", ARCFLAGS_MAX_REGIONS);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-g") == 0 || strcmp(argv[i], "--random") == 0) {
+      if (i + 1 < argc) {
+        random_degree = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --random\n");
+        return 1;
+      }
     } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--start") == 0) {
       if (i + 1 < argc)
 	      initial_vertex = atoi(argv[++i]);
@@ -186,15 +1115,399 @@ int main(int argc, char **argv) {
 	      fprintf(stderr, "Error: Missing argument for --start\n");
 	      return 1;
       }
+    } else if (strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--seeds") == 0) {
+      if (i + 1 < argc) {
+        seeds_list = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --seeds\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--radius") == 0) {
+      if (i + 1 < argc) {
+        radius = atof(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --radius\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-T") == 0 || strcmp(argv[i], "--targets") == 0) {
+      if (i + 1 < argc) {
+        targets_list = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --targets\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--nearest") == 0) {
+      if (i + 1 < argc) {
+        nb_nearest = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --nearest\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--target") == 0) {
+      if (i + 1 < argc) {
+        target_vertex = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --target\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-K") == 0 || strcmp(argv[i], "--paths") == 0) {
+      if (i + 1 < argc) {
+        nb_paths = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --paths\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0) {
+      if (i + 1 < argc) {
+        nb_threads = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --threads\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--pin") == 0) {
+      pin_threads = true;
+    } else if (strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--batch") == 0) {
+      if (i + 1 < argc) {
+        batch_list = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --batch\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--phast") == 0) {
+      use_phast = true;
+    } else if (strcmp(argv[i], "-P") == 0 || strcmp(argv[i], "--parallel") == 0) {
+      use_parallel = true;
+    } else if (strcmp(argv[i], "-B") == 0 || strcmp(argv[i], "--bfs") == 0) {
+      use_bfs = true;
+    } else if (strcmp(argv[i], "--msbfs") == 0) {
+      if (i + 1 < argc) {
+        msbfs_list = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --msbfs\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--many-to-one") == 0) {
+      use_many_to_one = true;
+    } else if (strcmp(argv[i], "--mst") == 0) {
+      use_mst = true;
+    } else if (strcmp(argv[i], "--pregel") == 0) {
+      if (i + 1 < argc && (strcmp(argv[i + 1], "sssp") == 0 || strcmp(argv[i + 1], "components") == 0 ||
+                           strcmp(argv[i + 1], "pagerank") == 0)) {
+        pregel_program = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --pregel (sssp, components or pagerank)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--serve") == 0) {
+      if (i + 1 < argc && (nb_reloads = atoi(argv[i + 1])) >= 1) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --serve (positive number of versions)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--grid") == 0) {
+      if (i + 1 < argc) {
+        grid_file = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --grid\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--grid-random") == 0) {
+      if (i + 1 < argc) {
+        grid_random_size = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --grid-random\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--connectivity") == 0) {
+      if (i + 1 < argc) {
+        connectivity = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --connectivity\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--from") == 0) {
+      if (i + 1 < argc) {
+        from_cell = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --from\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--to") == 0) {
+      if (i + 1 < argc) {
+        to_cell = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --to\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--grid-search") == 0) {
+      if (i + 1 < argc) {
+        grid_search_name = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --grid-search\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--engine") == 0) {
+      if (i + 1 < argc) {
+        engine_backend = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --engine\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--implicit") == 0) {
+      if (i + 1 < argc) {
+        implicit_states = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --implicit\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--approx") == 0) {
+      if (i + 1 < argc && (approx_epsilon = atof(argv[i + 1])) > 0.0) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --approx (positive epsilon)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--rounding") == 0) {
+      if (i + 1 < argc && sssp_approx_parse_rounding(argv[i + 1], &rounding)) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --rounding (grid or geometric)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--oracle-build") == 0) {
+      if (i + 1 < argc) {
+        oracle_build_file = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --oracle-build\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--oracle-k") == 0) {
+      if (i + 1 < argc && (oracle_k = atoi(argv[i + 1])) >= 1) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --oracle-k (at least 1)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--oracle") == 0) {
+      if (i + 1 < argc) {
+        oracle_file = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --oracle\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--shm-build") == 0) {
+      if (i + 1 < argc) {
+        shm_build_name = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --shm-build\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--shm") == 0) {
+      if (i + 1 < argc) {
+        shm_name = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --shm\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--shm-unlink") == 0) {
+      if (i + 1 < argc) {
+        shm_unlink_name = argv[++i];
+      } else {
+        fprintf(stderr, "Error: Missing argument for --shm-unlink\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--processes") == 0) {
+      if (i + 1 < argc && (nb_processes = atoi(argv[i + 1])) >= 1) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --processes (positive number)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--relax") == 0) {
+      if (i + 1 < argc && sssp_csr_parse_relax(argv[i + 1], &relax)) {
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --relax (plain or prefetch)\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--bench") == 0) {
+      if (i + 1 < argc) {
+        nb_bench = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --bench\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--huge-pages") == 0) {
+      huge_pages_e mode;
+      if (i + 1 < argc && numa_parse_huge_pages(argv[i + 1], &mode)) {
+        numa_set_huge_pages(mode);
+        numa_set_report(true);
+        atexit(print_huge_pages_report);
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --huge-pages (none, thp or hugetlb)\n");
+        return 1;
+      }
+    }
+  }
+  if (implicit_states > 0) {
+    // Implicit state space process - beginning
+    if (initial_vertex < 0 || initial_vertex >= implicit_states || target_vertex < 0 || target_vertex >= implicit_states) {
+      fprintf(stderr, "Error: --implicit requires valid --start and --target states\n");
+      return 1;
+    }
+    implicit_graph_s *ig = implicit_graph_create(implicit_states, 3, counter_moves, &implicit_states);
+    vertex_s *dst = engine_implicit(ig, initial_vertex, target_vertex);
+    printf("Counter game over %d states, from %d to %d: ", implicit_states, initial_vertex, target_vertex);
+    if (dst[target_vertex].weight == INFINITY) {
+      printf("unreachable\n");
+    } else {
+      printf("%.0f moves\n", dst[target_vertex].weight);
+      int nb_reached = 0;
+      for (int i = 0; i < implicit_states; i++)
+        nb_reached += (dst[i].weight < INFINITY);
+      printf("%d states reached\n", nb_reached);
+      int path_length = 0;
+      for (int v = target_vertex; v != -1; v = dst[v].prev)
+        path_length++;
+      int *path = malloc(path_length*sizeof(int));
+      assert(path!=NULL);
+      for (int v = target_vertex, i = path_length - 1; v != -1; v = dst[v].prev)
+        path[i--] = v;
+      for (int i = 0; i < path_length; i++)
+        printf("%d%s", path[i], (i < path_length - 1) ? " → " : "\n");
+      free(path);
+    }
+    free(dst);
+    implicit_graph_delete(ig);
+    return 0;
+    // Implicit state space process - end
+  }
+
+  if (oracle_file != NULL) {
+    // Distance oracle queries process - beginning
+    oracle_s *o = oracle_load(oracle_file);
+    if (o == NULL) {
+      fprintf(stderr, "Error: Cannot map the oracle file \"%s\"\n", oracle_file);
+      return 1;
+    }
+    printf("Oracle of %d vertices, stretch %d, %.1f MB mapped\n", o->nb_vertices, 2*o->k - 1, o->size / 1e6);
+    if (nb_bench > 0) {
+      benchmark_oracle(o, nb_bench);
+    } else if (initial_vertex < 0 || initial_vertex >= o->nb_vertices || target_vertex < 0 || target_vertex >= o->nb_vertices) {
+      fprintf(stderr, "Error: --oracle requires valid --start and --target vertices, or --bench\n");
+      oracle_delete(o);
+      return 1;
+    } else {
+      double d = oracle_query(o, initial_vertex, target_vertex);
+      if (d == INFINITY) printf("from vertex %d to vertex %d: unreachable\n", initial_vertex, target_vertex);
+      else printf("from vertex %d to vertex %d: estimated length %.2f\n", initial_vertex, target_vertex, d);
+    }
+    oracle_delete(o);
+    return 0;
+    // Distance oracle queries process - end
+  }
+
+  if (shm_unlink_name != NULL) {
+    // Graph segment removal - beginning
+    if (!graph_shm_unlink(shm_unlink_name)) {
+      fprintf(stderr, "Error: Cannot remove the graph segment \"%s\"\n", shm_unlink_name);
+      return 1;
+    }
+    return 0;
+    // Graph segment removal - end
+  }
+
+  if (shm_name != NULL) {
+    // Shared-memory graph queries process - beginning
+    graph_shm_s *shm = graph_shm_attach(shm_name);
+    if (shm == NULL) {
+      fprintf(stderr, "Error: Cannot map the graph segment \"%s\"\n", shm_name);
+      return 1;
+    }
+    int n = shm->csr.nb_vertices;
+    printf("%s graph of %d vertices and %d edges, %.1f MB mapped\n", shm->directed ? "Directed" : "Undirected", n,
+           shm->csr.nb_edges, shm->size / 1e6);
+    bool ok = true;
+    if (nb_bench > 0) {
+      ok = run_shm_workers(shm_name, nb_processes, nb_bench, relax);
+    } else if (initial_vertex < 0 || initial_vertex >= n) {
+      fprintf(stderr, "Error: --shm requires a valid --start vertex, or --bench\n");
+      ok = false;
+    } else {
+      workspace_s *ws = workspace_create(n);
+      dijkstra_csr(&shm->csr, initial_vertex, relax, ws);
+      if (target_vertex >= 0 && target_vertex < n) {
+        double d = workspace_dist(ws, target_vertex);
+        if (d == INFINITY) printf("from vertex %d to vertex %d: unreachable\n", initial_vertex, target_vertex);
+        else printf("from vertex %d to vertex %d: length %.2f\n", initial_vertex, target_vertex, d);
+      } else {
+        int nb_reached = 0;
+        double farthest = 0.0;
+        for (int v = 0; v < n; v++) {
+          double d = workspace_dist(ws, v);
+          if (d == INFINITY) continue;
+          nb_reached++;
+          if (d > farthest) farthest = d;
+        }
+        printf("from vertex %d: %d vertices reached, the farthest at %.2f\n", initial_vertex, nb_reached, farthest);
+      }
+      workspace_delete(ws);
+    }
+    graph_shm_detach(shm);
+    return ok ? 0 : 1;
+    // Shared-memory graph queries process - end
+  }
+
+  if (grid_file != NULL || grid_random_size != NULL) {
+    // Grid searches process - beginning
+    int width = 0, height = 0;
+    if (connectivity != 4 && connectivity != 8) {
+      fprintf(stderr, "Error: Invalid connectivity %d (4 or 8)\n", connectivity);
+      return 1;
+    }
+    grid_s *grid = NULL;
+    if (grid_file != NULL)
+      grid = grid_load(grid_file, connectivity);
+    else if (sscanf(grid_random_size, "%dx%d", &width, &height) == 2 && width > 0 && height > 0)
+      grid = grid_random(width, height, connectivity, 0.2, 1);
+    if (!grid) {
+      fprintf(stderr, "Error: Failed to create the grid\n");
+      return 1;
+    }
+    bool ok = run_grid_searches(grid, from_cell, to_cell, grid_search_name);
+    grid_delete(grid);
+    return ok ? 0 : 1;
+    // Grid searches process - end
+  }
+  int lattice_width = 0, lattice_height = 0;
+  if (lattice_size != NULL) {
+    if (sscanf(lattice_size, "%dx%d", &lattice_width, &lattice_height) != 2 || lattice_width <= 0 || lattice_height <= 0) {
+      fprintf(stderr, "Error: Invalid lattice size \"%s\" (WxH expected)\n", lattice_size);
+      return 1;
     }
+    vertices = lattice_width * lattice_height;
   }
-  if (vertices == 0 || edges_list == NULL) {
-    fprintf(stderr, "Error: --vertices and --adjacencies are required\n\n");
+  if (vertices <= 0 || (edges_list == NULL && random_degree <= 0 && lattice_size == NULL)) {
+    fprintf(stderr, "Error: --vertices and --adjacencies (or --random) are required\n\n");
     print_help(argv[0]);
     return 1;
   }
-  edge_s edges[vertices * vertices]; // Assume a maximum possible number of edges
+  edge_s *edges;
   int edge_count = 0;
+  if (lattice_size != NULL) {
+    edges = lattice_edges(lattice_width, lattice_height, &edge_count);
+    edges_list = "";
+    generated = true;
+  } else if (random_degree > 0) {
+    edges = random_edges(vertices, random_degree, &edge_count);
+    edges_list = "";
+    generated = true;
+  } else {
+    edges = malloc((size_t)vertices * vertices * sizeof(edge_s)); // Assume a maximum possible number of edges
+    assert(edges!=NULL);
+  }
   // Parsing edges_list
   const char *ptr = edges_list;
   while (*ptr != '\0') {
@@ -205,6 +1518,7 @@ int main(int argc, char **argv) {
       fprintf(stderr, "Error: Invalid edge format (missing ':' ?)\n");
       for(int i=0;i<ptr-edges_list+1;i++) fprintf(stderr,"-"); fprintf(stderr,"v"); fprintf(stderr, "\n");
       fprintf(stderr, "\"%s\"\n",edges_list);
+      free(edges);
       return 1;
     }
     // Read each connection for the current start vertex
@@ -215,6 +1529,7 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Error: Invalid edge format (missing '/' ?)\n");
         for(int i=0;i<ptr-edges_list+1;i++) fprintf(stderr,"-"); fprintf(stderr,"v"); fprintf(stderr, "\n");
         fprintf(stderr, "\"%s\"\n",edges_list);
+        free(edges);
         return 1;
       }
       // Read weight
@@ -226,18 +1541,794 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Error: Invalid edge format here (',' or ' ' expected).\n");
         for(int i=0;i<ptr-edges_list+1;i++) fprintf(stderr,"-"); fprintf(stderr,"v"); fprintf(stderr, "\n");
         fprintf(stderr, "\"%s\"\n",edges_list);
+        free(edges);
         return 1;
       }
     }
     while (*ptr == ' ') ptr++;
   }
-  graph_s *g = create_graph(vertices, edge_count, directed, edges);
+  // One thread pool shared by all the parallel engines
+  thread_pool_s *pool = thread_pool_create(nb_threads, pin_threads);
+  graph_s *g = create_graph_parallel(vertices, edge_count, directed, edges, pool);
   if (!g) {
     fprintf(stderr, "Error: Failed to create graph\n");
+    free(edges);
+    thread_pool_delete(pool);
+    return 1;
+  }
+  if (!generated) {
+    printf("The initial Graph:\n");
+    print(g);
+  }
+
+  if (shm_build_name != NULL) {
+    // Shared-memory graph building process - beginning
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    graph_csr_s *csr = graph_csr_create(g);
+    bool ok = graph_shm_create(shm_build_name, csr, directed);
+    if (ok)
+      printf("\nGraph segment \"%s\" written in %.2f ms: %.1f MB (adjacency lists of a process: %.1f MB)\n",
+             shm_build_name, elapsed_ms(&start), graph_csr_size(csr) / 1e6,
+             (g->nb_nodes * sizeof(adj_list_s) + g->nb_vertices * sizeof(adj_list_s *)) / 1e6);
+    else
+      fprintf(stderr, "Error: Cannot create the graph segment \"%s\"\n", shm_build_name);
+    graph_csr_delete(csr);
+    free(edges);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Shared-memory graph building process - end
+  }
+
+  if (nb_reloads > 0) {
+    // Hot-swapped graph versions process - beginning
+    // the edges are kept to build the next versions
+    bool ok = serve_queries(g, edges, edge_count, nb_reloads, relax, pool);
+    free(edges);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Hot-swapped graph versions process - end
+  }
+  free(edges);
+
+  if (nb_parts > 0) {
+    // Graph partitioning process - beginning
+    if (nb_parts > g->nb_vertices) {
+      fprintf(stderr, "Error: More parts than vertices\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    partition_s *p = partition_create(g, nb_parts, imbalance, pool);
+    printf("\n%d parts computed in %.2f ms (%d threads, %d levels)\n", nb_parts, elapsed_ms(&start),
+           thread_pool_size(pool), p->nb_levels);
+    print_partition("multilevel", p);
+    // Baseline: consecutive ranges of indices, as a naive sharding would do
+    int *range = malloc(g->nb_vertices * sizeof(int));
+    assert(range!=NULL);
+    for (int v = 0; v < g->nb_vertices; v++)
+      range[v] = (int)((long long)v * nb_parts / g->nb_vertices);
+    partition_s *ranges = partition_from_vector(g, nb_parts, range);
+    print_partition("ranges", ranges);
+    partition_delete(ranges);
+    free(range);
+    if (!generated) {
+      printf("Parts:\n");
+      for (int v = 0; v < g->nb_vertices; v++)
+        printf("vertex %d: part %d\n", v, p->part[v]);
+    }
+    bool ok = true;
+    if (partition_file != NULL && !partition_save(p, partition_file)) {
+      fprintf(stderr, "Error: Cannot write the partition file \"%s\"\n", partition_file);
+      ok = false;
+    }
+    if (nb_bench > 0)
+      ok = benchmark_partition(g, p, nb_bench, pool) && ok;
+    partition_delete(p);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Graph partitioning process - end
+  }
+
+  if (nb_shards > 0) {
+    // Sharded Dijkstra process - beginning
+    if (nb_shards > g->nb_vertices || initial_vertex < 0 || initial_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: More shards than vertices, or invalid start vertex\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    if (shard_delta <= 0.0) {
+      double sum = 0.0;
+      long long nb_adjacencies = 0;
+      for (int u = 0; u < g->nb_vertices; u++)
+        for (adj_list_s *adj = get_adj_list(g, u); adj != NULL; adj = adj->next, nb_adjacencies++)
+          sum += adj->vertex.weight;
+      shard_delta = (sum > 0.0) ? sum / nb_adjacencies : 1.0;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    partition_s *p = partition_create(g, nb_shards, 0.03, pool);
+    double partition_ms = elapsed_ms(&start);
+    int nb_vertices = g->nb_vertices;
+    double *reference = NULL;
+    if (generated) {
+      // Reference distances of the sequential CSR search, computed before the graph is dropped
+      graph_csr_s *csr = graph_csr_create(g);
+      workspace_s *ws = workspace_create(nb_vertices);
+      reference = malloc(nb_vertices * sizeof(double));
+      assert(reference!=NULL);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      dijkstra_csr(csr, initial_vertex, RELAX_PREFETCH, ws);
+      printf("Sequential CSR Dijkstra in %.2f ms\n", elapsed_ms(&start));
+      for (int v = 0; v < nb_vertices; v++)
+        reference[v] = workspace_dist(ws, v);
+      workspace_delete(ws);
+      graph_csr_delete(csr);
+    }
+    // Once the shards are sent, the coordinator only keeps the partition and the results
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    sharded_s *sh = sharded_create(g, p->part, nb_shards);
+    double create_ms = elapsed_ms(&start);
+    delete_graph(g);
+    sharded_stats_s stats;
+    vertex_s *dst = NULL;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (sh != NULL) dst = sharded_search(sh, initial_vertex, shard_delta, &stats);
+    double sharded_ms = elapsed_ms(&start);
+    sharded_delete(sh);
+    bool ok = (dst != NULL);
+    if (!ok) {
+      fprintf(stderr, "Error: The shard processes failed\n");
+    } else {
+      printf("\n%d shards (partition in %.2f ms, sent in %.2f ms, edge cut %lld, largest shard %d vertices and %d ghosts)\n",
+             nb_shards, partition_ms, create_ms, p->edge_cut, stats.largest_shard, stats.largest_ghosts);
+      printf("Sharded Dijkstra from vertex %d in %.2f ms: %d steps of width %g, %lld updates (%.2f MB) exchanged\n",
+             initial_vertex, sharded_ms, stats.nb_steps, shard_delta, stats.nb_messages, stats.nb_bytes / 1e6);
+    }
+    if (ok && generated) {
+      for (int v = 0; v < nb_vertices; v++)
+        if (dst[v].weight != reference[v]) ok = false;
+      printf("%s\n", ok ? "Same distances" : "DIFFERENT DISTANCES");
+    } else if (ok) {
+      printf("Resulting sharded Dijkstra shortest paths from vertex %d:\n", initial_vertex);
+      int *path = malloc(nb_vertices * sizeof(int));
+      assert(path!=NULL);
+      for (int i = 0; i < nb_vertices; i++) {
+        if (dst[i].weight == INFINITY) {
+          printf("to vertex %d (shard %d), length   ∞ : \n", i, p->part[i]);
+          continue;
+        }
+        printf("to vertex %d (shard %d), length %.2f: ", i, p->part[i], dst[i].weight);
+        // The graph is gone, so the path is traced back here rather than by print_path
+        int path_length = 0;
+        for (int current = i; current != -1; current = dst[current].prev)
+          path[path_length++] = current;
+        for (int k = path_length - 1; k >= 0; k--)
+          printf("%d%s", path[k], k > 0 ? " → " : "\n");
+      }
+      free(path);
+    }
+    free(reference);
+    free(dst);
+    partition_delete(p);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Sharded Dijkstra process - end
+  }
+
+  if (crp_levels > 0) {
+    // Customizable route planning process - beginning
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    crp_s *crp = crp_create(g, crp_levels);
+    double partition_ms = elapsed_ms(&start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    crp_customize(crp, pool);
+    printf("\nOverlays of %d levels: partition in %.2f ms, customization in %.2f ms (%d threads), %zu shortcuts\n",
+           crp_levels, partition_ms, elapsed_ms(&start), thread_pool_size(pool), crp_nb_shortcuts(crp));
+    bool ok = true;
+    if (nb_bench > 0) {
+      ok = benchmark_crp(crp, nb_bench);
+      // Live traffic: 10% of the weights change, only the customization runs again
+      unsigned int seed = 4;
+      for (int e = 0; e < crp->csr->nb_edges; e++)
+        if (rand_r(&seed) % 10 == 0)
+          crp->csr->weight[e] *= 1.0 + (rand_r(&seed) % 200) / 100.0;
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      crp_customize(crp, pool);
+      printf("\nNew weights customized in %.2f ms\n", elapsed_ms(&start));
+      ok = benchmark_crp(crp, nb_bench) && ok;
+    } else if (target_vertex < 0 || target_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: --crp requires a valid --target vertex, or --bench\n");
+      ok = false;
+    } else {
+      workspace_s *fwd = workspace_create(g->nb_vertices);
+      workspace_s *bwd = workspace_create(g->nb_vertices);
+      double d = crp_query(crp, initial_vertex, target_vertex, true, fwd, bwd);
+      if (d == INFINITY)
+        printf("from vertex %d to vertex %d: unreachable (%d vertices settled)\n", initial_vertex, target_vertex,
+               fwd->nb_settled + bwd->nb_settled);
+      else
+        printf("from vertex %d to vertex %d, length %.2f (%d vertices settled)\n", initial_vertex, target_vertex, d,
+               fwd->nb_settled + bwd->nb_settled);
+      workspace_delete(bwd);
+      workspace_delete(fwd);
+    }
+    crp_delete(crp);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Customizable route planning process - end
+  }
+
+  if (nb_regions > 0) {
+    // Arc flags process - beginning
+    if (nb_regions > g->nb_vertices) {
+      fprintf(stderr, "Error: More regions than vertices\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    arcflags_s *af = arcflags_create(g, nb_regions, pool);
+    printf("\nArc flags of %d regions computed in %.2f ms (%d threads): %d boundary vertices, %.1f%% of the flags set\n",
+           nb_regions, elapsed_ms(&start), thread_pool_size(pool), af->nb_boundary, 100.0 * arcflags_density(af));
+    bool ok = true;
+    if (nb_bench > 0) {
+      ok = benchmark_arcflags(af, nb_bench);
+    } else if (target_vertex < 0 || target_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: --arc-flags requires a valid --target vertex, or --bench\n");
+      ok = false;
+    } else {
+      workspace_s *ws = workspace_create(g->nb_vertices);
+      double d = arcflags_query(af, initial_vertex, target_vertex, true, ws);
+      if (d == INFINITY) {
+        printf("from vertex %d to vertex %d: unreachable (%d vertices settled)\n", initial_vertex, target_vertex, ws->nb_settled);
+      } else {
+        printf("from vertex %d to vertex %d, length %.2f (%d vertices settled): ", initial_vertex, target_vertex, d, ws->nb_settled);
+        int path_length = 0;
+        for (int v = target_vertex; v != -1; v = ws->prev[v])
+          path_length++;
+        int *path = malloc(path_length*sizeof(int));
+        assert(path!=NULL);
+        for (int v = target_vertex, i = path_length - 1; v != -1; v = ws->prev[v])
+          path[i--] = v;
+        for (int i = 0; i < path_length; i++)
+          printf("%d%s", path[i], (i < path_length - 1) ? " → " : "\n");
+        free(path);
+      }
+      workspace_delete(ws);
+    }
+    arcflags_delete(af);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Arc flags process - end
+  }
+
+  if (oracle_build_file != NULL) {
+    // Distance oracle preprocessing process - beginning
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    oracle_s *o = oracle_build(g, oracle_k, 1);
+    if (o == NULL) {
+      fprintf(stderr, "Error: The distance oracle needs an undirected graph\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    double build_ms = elapsed_ms(&start);
+    uint64_t nb_entries = oracle_nb_entries(o);
+    printf("\nOracle of stretch %d built in %.2f ms: %llu bunch entries (%.1f per vertex), %.1f MB\n", 2*oracle_k - 1,
+           build_ms, (unsigned long long)nb_entries, (double)nb_entries / g->nb_vertices, o->size / 1e6);
+    bool saved = oracle_save(o, oracle_build_file);
+    if (!saved) fprintf(stderr, "Error: Cannot write the oracle file \"%s\"\n", oracle_build_file);
+    bool bounded = (nb_bench > 0) ? check_oracle(g, o, nb_bench) : true;
+    oracle_delete(o);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return (saved && bounded) ? 0 : 1;
+    // Distance oracle preprocessing process - end
+  }
+
+  if (use_many_to_one) {
+    // Many-to-one Dijkstra process - beginning
+    if (target_vertex < 0 || target_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: --many-to-one requires a valid --target vertex\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    int n = g->nb_vertices;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    graph_csr_s *out = graph_csr_create_parallel(g, pool);
+    double out_ms = elapsed_ms(&start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    graph_csr_s *in = g->directed ? graph_csr_transpose_parallel(out, pool) : out;
+    printf("\nForward CSR built in %.2f ms, transpose in %.2f ms (%d threads)\n", out_ms, elapsed_ms(&start),
+           thread_pool_size(pool));
+    bool ok = true;
+    if (nb_bench > 0 && in != out) {
+      // The sequential transposition gives the same arrays
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      graph_csr_s *check = graph_csr_transpose(out);
+      printf("sequential transpose in %.2f ms\n", elapsed_ms(&start));
+      ok = memcmp(check->first, in->first, (n + 1)*sizeof(int)) == 0 &&
+           memcmp(check->head, in->head, (size_t)in->nb_edges*sizeof(int)) == 0 &&
+           memcmp(check->weight, in->weight, (size_t)in->nb_edges*sizeof(double)) == 0;
+      graph_csr_delete(check);
+    }
+    workspace_s *ws = workspace_create(n);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    dijkstra_csr_to(in, target_vertex, relax, ws);
+    double search_ms = elapsed_ms(&start);
+    int nb_reached = 0;
+    for (int v = 0; v < n; v++)
+      nb_reached += (workspace_dist(ws, v) < INFINITY);
+    printf("Distances to vertex %d computed in %.2f ms: %d vertices reach it\n", target_vertex, search_ms, nb_reached);
+    for (int v = 0; !generated && v < n; v++) {
+      if (workspace_dist(ws, v) == INFINITY) {
+        printf("from vertex %d: unreachable\n", v);
+        continue;
+      }
+      printf("from vertex %d: length %.2f, path %d", v, workspace_dist(ws, v), v);
+      // the predecessor in the backward search is the next vertex toward the target
+      for (int u = v; u != target_vertex; u = ws->prev[u])
+        printf(" → %d", ws->prev[u]);
+      printf("\n");
+    }
+    if (nb_bench > 0) {
+      // Each backward distance is the forward distance from the source to the target
+      workspace_s *fwd = workspace_create(n);
+      unsigned int seed = 2;
+      for (int i = 0; i < nb_bench; i++) {
+        int src = rand_r(&seed) % n;
+        dijkstra_csr(out, src, relax, fwd);
+        double d = workspace_dist(fwd, target_vertex), r = workspace_dist(ws, src);
+        if (d != r && fabs(d - r) > 1e-9 * d) ok = false;
+      }
+      workspace_delete(fwd);
+      printf("%d forward searches checked%s\n", nb_bench, ok ? "" : " (DIFFERENT DISTANCES)");
+    }
+    workspace_delete(ws);
+    if (in != out) graph_csr_delete(in);
+    graph_csr_delete(out);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Many-to-one Dijkstra process - end
+  }
+
+  if (nb_bench > 0) {
+    // Relaxation loops benchmark - beginning
+    bool same = (approx_epsilon > 0.0) ? benchmark_approx(g, nb_bench, approx_epsilon, rounding)
+                                       : benchmark_relax(g, nb_bench);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return same ? 0 : 1;
+    // Relaxation loops benchmark - end
+  }
+
+  if (seeds_list != NULL) {
+    // Multi-source Dijkstra process - beginning
+    int *seeds = NULL;
+    int nb_seeds = parse_vertex_list(seeds_list, g->nb_vertices, &seeds);
+    if (nb_seeds < 0) {
+      fprintf(stderr, "Error: Invalid seed list \"%s\"\n", seeds_list);
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    int *nearest = malloc(g->nb_vertices * sizeof(int));
+    assert(nearest!=NULL);
+    vertex_s *dst = dijkstra_multi(g, seeds, nb_seeds, nearest);
+    printf("\nResulting Voronoi cells of seeds %s:\n", seeds_list);
+    for (int i = 0; i < g->nb_vertices; i++) {
+      if (nearest[i] == -1)
+        printf("vertex %d, no seed reachable\n", i);
+      else {
+        printf("vertex %d, seed %d, length %.2f: ", i, nearest[i], dst[i].weight);
+        print_path(g, dst, i);
+      }
+    }
+    free(dst);
+    free(nearest);
+    free(seeds);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Multi-source Dijkstra process - end
+  }
+
+  // The searches below all start from -s
+  bool from_start = radius >= 0.0 || targets_list != NULL || approx_epsilon > 0.0 || engine_backend != NULL ||
+                    use_phast || use_parallel;
+  if (from_start && (initial_vertex < 0 || initial_vertex >= g->nb_vertices)) {
+    fprintf(stderr, "Error: Invalid start vertex\n");
+    delete_graph(g);
+    thread_pool_delete(pool);
     return 1;
   }
-  printf("The initial Graph:\n");
-  print(g);
+
+  if (radius >= 0.0) {
+    // Bounded-radius Dijkstra process - beginning
+    workspace_s *ws = workspace_create(g->nb_vertices);
+    int nb_settled = dijkstra_within(g, initial_vertex, radius, ws);
+    printf("\nVertices within %.2f of vertex %d (%d settled):\n", radius, initial_vertex, nb_settled);
+    for (int i = 0; i < nb_settled; i++)
+      printf("[% 2d, %02.2f, % 2d]\n", ws->settled_list[i].ind, ws->settled_list[i].weight, ws->settled_list[i].prev);
+    workspace_delete(ws);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Bounded-radius Dijkstra process - end
+  }
+
+  if (targets_list != NULL) {
+    // k-nearest targets process - beginning
+    int *targets = NULL;
+    int nb_targets = parse_vertex_list(targets_list, g->nb_vertices, &targets);
+    if (nb_targets < 0 || nb_nearest < 1) {
+      fprintf(stderr, "Error: Invalid target list \"%s\" or number of targets\n", targets_list);
+      free(targets);
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    bitset_s *target_set = bitset_create(g->nb_vertices);
+    for (int i = 0; i < nb_targets; i++)
+      bitset_set(target_set, targets[i]);
+    workspace_s *ws = workspace_create(g->nb_vertices);
+    // No more targets can be found than listed
+    if (nb_nearest > nb_targets) nb_nearest = nb_targets;
+    vertex_s *nearest = malloc(nb_nearest * sizeof(vertex_s));
+    assert(nearest!=NULL);
+    int nb_found = dijkstra_knn(g, initial_vertex, target_set, nb_nearest, ws, nearest);
+    printf("\nThe %d targets closest to vertex %d (%d vertices settled):\n", nb_found, initial_vertex, ws->nb_settled);
+    for (int i = 0; i < nb_found; i++)
+      printf("target %d, length %.2f\n", nearest[i].ind, nearest[i].weight);
+    free(nearest);
+    workspace_delete(ws);
+    bitset_delete(target_set);
+    free(targets);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // k-nearest targets process - end
+  }
+
+  if (nb_paths > 0) {
+    // k-shortest paths process - beginning
+    if (target_vertex < 0 || target_vertex >= g->nb_vertices
+        || initial_vertex < 0 || initial_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: --paths requires valid --start and --target vertices\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    ksp_s *paths = yen_ksp(g, initial_vertex, target_vertex, nb_paths, pool);
+    printf("\nThe %d shortest loopless paths from vertex %d to vertex %d:\n", paths->nb_paths, initial_vertex, target_vertex);
+    for (int p = 0; p < paths->nb_paths; p++) {
+      printf("length %.2f: ", ksp_length(paths, p));
+      for (int i = paths->first[p]; i < paths->first[p+1]; i++)
+        printf("%d%s", paths->vertices[i], (i < paths->first[p+1] - 1) ? " → " : "\n");
+    }
+    ksp_delete(paths);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // k-shortest paths process - end
+  }
+
+  if (batch_list != NULL) {
+    // Batch Dijkstra process - beginning
+    int *sources = NULL;
+    int nb_sources = parse_vertex_list(batch_list, g->nb_vertices, &sources);
+    if (nb_sources < 0) {
+      fprintf(stderr, "Error: Invalid source list \"%s\"\n", batch_list);
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    double *dist = dijkstra_batch(g, sources, nb_sources, relax, pool);
+    printf("\nResulting distances from the %d sources (%d threads):\n", nb_sources, thread_pool_size(pool));
+    for (int s = 0; s < nb_sources; s++) {
+      printf("from vertex %d:", sources[s]);
+      for (int i = 0; i < g->nb_vertices; i++) {
+        double d = dist[(size_t)s * g->nb_vertices + i];
+        if (d == INFINITY) printf("     ∞");
+        else printf(" %5.2f", d);
+      }
+      printf("\n");
+    }
+    free(dist);
+    free(sources);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Batch Dijkstra process - end
+  }
+
+  if (use_bfs) {
+    // Direction-optimizing BFS process - beginning
+    if (initial_vertex < 0 || initial_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: Invalid start vertex %d\n", initial_vertex);
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    graph_csr_s *out = graph_csr_create_parallel(g, pool);
+    graph_csr_s *in = g->directed ? graph_csr_transpose_parallel(out, pool) : out;
+    int *hops = malloc(g->nb_vertices*sizeof(int));
+    assert(hops!=NULL);
+    int nb_bottom_up;
+    int nb_levels = bfs(out, in, initial_vertex, hops, &nb_bottom_up);
+    printf("\nHop distances from vertex %d (%d levels, %d expanded bottom-up):\n", initial_vertex, nb_levels, nb_bottom_up);
+    for (int i = 0; !generated && i < g->nb_vertices; i++) {
+      if (hops[i] < 0) printf("to vertex %d, hops ∞\n", i);
+      else printf("to vertex %d, hops %d\n", i, hops[i]);
+    }
+    free(hops);
+    if (in != out) graph_csr_delete(in);
+    graph_csr_delete(out);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Direction-optimizing BFS process - end
+  }
+
+  if (msbfs_list != NULL) {
+    // Multi-source bit-parallel BFS process - beginning
+    graph_csr_s *csr = graph_csr_create(g);
+    if (strcmp(msbfs_list, "all") == 0) {
+      hop_stats_s stats = bfs_all_pairs(csr, pool);
+      printf("\nAll-pairs hop distances (%d threads, %d sources per sweep):\n", thread_pool_size(pool), MSBFS_SOURCES);
+      printf("%lld connected pairs, diameter %d, average %.3f hops\n", stats.nb_pairs, stats.max_hops,
+             stats.nb_pairs ? (double)stats.sum_hops / stats.nb_pairs : 0.0);
+    } else {
+      int *sources = NULL;
+      int nb_sources = parse_vertex_list(msbfs_list, g->nb_vertices, &sources);
+      if (nb_sources < 0 || nb_sources > MSBFS_SOURCES) {
+        fprintf(stderr, "Error: Invalid source list \"%s\" (at most %d sources)\n", msbfs_list, MSBFS_SOURCES);
+        free(sources);
+        graph_csr_delete(csr);
+        delete_graph(g);
+        thread_pool_delete(pool);
+        return 1;
+      }
+      msbfs_s *ms = msbfs_create(g->nb_vertices);
+      int *hops = malloc((size_t)nb_sources * g->nb_vertices * sizeof(int));
+      assert(hops!=NULL);
+      bfs_multi(ms, csr, sources, nb_sources, hops);
+      printf("\nHop distances from the %d sources:\n", nb_sources);
+      for (int s = 0; s < nb_sources; s++) {
+        printf("from vertex %d:", sources[s]);
+        for (int i = 0; i < g->nb_vertices; i++) {
+          int h = hops[(size_t)s * g->nb_vertices + i];
+          if (h < 0) printf("  ∞");
+          else printf(" %2d", h);
+        }
+        printf("\n");
+      }
+      free(hops);
+      msbfs_delete(ms);
+      free(sources);
+    }
+    graph_csr_delete(csr);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Multi-source bit-parallel BFS process - end
+  }
+
+  if (pregel_program != NULL) {
+    // Vertex program process - beginning
+    if (initial_vertex < 0 || initial_vertex >= g->nb_vertices) {
+      fprintf(stderr, "Error: Invalid start vertex\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    if (g->directed && strcmp(pregel_program, "components") == 0) {
+      fprintf(stderr, "Error: --pregel components requires an undirected graph\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    double *values = malloc(g->nb_vertices * sizeof(double));
+    assert(values!=NULL);
+    pregel_stats_s stats;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (strcmp(pregel_program, "sssp") == 0) pregel_sssp(g, initial_vertex, values, pool, &stats);
+    else if (strcmp(pregel_program, "components") == 0) pregel_components(g, values, pool, &stats);
+    else pregel_pagerank(g, 0.85, 30, values, pool, &stats);
+    printf("\nVertex program \"%s\" in %.2f ms (%d threads): %d supersteps, %lld computes, %lld messages\n",
+           pregel_program, elapsed_ms(&start), thread_pool_size(pool), stats.nb_supersteps, stats.nb_computes,
+           stats.nb_messages);
+    bool ok = true;
+    if (strcmp(pregel_program, "sssp") == 0) {
+      graph_csr_s *csr = graph_csr_create(g);
+      workspace_s *ws = workspace_create(g->nb_vertices);
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      dijkstra_csr(csr, initial_vertex, RELAX_PREFETCH, ws);
+      printf("Sequential CSR Dijkstra in %.2f ms\n", elapsed_ms(&start));
+      for (int v = 0; v < g->nb_vertices; v++)
+        if (fabs(values[v] - workspace_dist(ws, v)) > 1e-9 * values[v]) ok = false;
+      printf("%s\n", ok ? "Same distances" : "DIFFERENT DISTANCES");
+      workspace_delete(ws);
+      graph_csr_delete(csr);
+    } else if (strcmp(pregel_program, "components") == 0) {
+      int nb_components = 0;
+      for (int v = 0; v < g->nb_vertices; v++)
+        if (values[v] == v) nb_components++;
+      printf("%d components\n", nb_components);
+    } else {
+      double sum = 0.0;
+      int best = 0;
+      for (int v = 0; v < g->nb_vertices; v++) {
+        sum += values[v];
+        if (values[v] > values[best]) best = v;
+      }
+      printf("Sum of the ranks %.6f, highest rank %.3g (vertex %d)\n", sum, values[best], best);
+    }
+    for (int v = 0; !generated && v < g->nb_vertices; v++)
+      printf("vertex %d: %g\n", v, values[v]);
+    free(values);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return ok ? 0 : 1;
+    // Vertex program process - end
+  }
+
+  if (use_mst) {
+    // Minimum spanning forest process - beginning
+    if (g->directed) {
+      fprintf(stderr, "Error: --mst requires an undirected graph\n");
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    graph_csr_s *csr = graph_csr_create(g);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    mst_s *boruvka = mst_boruvka(csr, pool);
+    double boruvka_ms = elapsed_ms(&start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    mst_s *prim = mst_prim(csr);
+    double prim_ms = elapsed_ms(&start);
+    printf("\nMinimum spanning forest: %d edges, %d trees, weight %.2f\n", boruvka->nb_edges, boruvka->nb_trees, boruvka->weight);
+    for (int i = 0; !generated && i < boruvka->nb_edges; i++)
+      printf("%d - %d (%.2f)\n", boruvka->edges[i].src, boruvka->edges[i].dst, boruvka->edges[i].weight);
+    printf("Borůvka (%d threads): %10.2f ms\n", thread_pool_size(pool), boruvka_ms);
+    printf("Prim:                 %10.2f ms, weight %.2f\n", prim_ms, prim->weight);
+    // The weights are summed in different orders: compare them up to rounding
+    bool same = boruvka->nb_trees == prim->nb_trees &&
+                fabs(boruvka->weight - prim->weight) <= 1e-9 * fmax(1.0, fabs(prim->weight));
+    printf("%s\n", same ? "Same weights" : "DIFFERENT WEIGHTS");
+    mst_delete(prim);
+    mst_delete(boruvka);
+    graph_csr_delete(csr);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return same ? 0 : 1;
+    // Minimum spanning forest process - end
+  }
+
+  if (approx_epsilon > 0.0) {
+    // Approximate Dijkstra process - beginning
+    graph_csr_s *csr = graph_csr_create(g);
+    sssp_approx_s *a = sssp_approx_create(csr, approx_epsilon, rounding);
+    if (a == NULL) {
+      fprintf(stderr, "Error: The grid rounding needs too many buckets, use the geometric rounding or a larger epsilon\n");
+      graph_csr_delete(csr);
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    vertex_s *dst = malloc(g->nb_vertices*sizeof(vertex_s));
+    assert(dst!=NULL);
+    sssp_approx_query(a, initial_vertex, dst);
+    printf("\nResulting paths from vertex %d, at most %g%% longer than the shortest ones (%d buckets):\n",
+           initial_vertex, 100.0 * approx_epsilon, a->nb_buckets);
+    for (int i = 0; !generated && i < g->nb_vertices; i++) {
+      if (dst[i].weight == INFINITY)
+        printf("to vertex %d, length   ∞ : \n", i);
+      else {
+        printf("to vertex %d, length %.2f: ", i, dst[i].weight);
+        print_path(g, dst, i);
+      }
+    }
+    free(dst);
+    sssp_approx_delete(a);
+    graph_csr_delete(csr);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Approximate Dijkstra process - end
+  }
+
+  if (engine_backend != NULL) {
+    // Generic engine process - beginning
+    vertex_s *dst = NULL;
+    graph_csr_s *csr = NULL;
+    if (strcmp(engine_backend, "list") == 0) {
+      dst = engine_list(g, initial_vertex, -1);
+    } else if (strcmp(engine_backend, "csr") == 0) {
+      csr = graph_csr_create(g);
+      dst = engine_csr(csr, initial_vertex, -1);
+    } else {
+      fprintf(stderr, "Error: Invalid backend \"%s\" (list or csr)\n", engine_backend);
+      delete_graph(g);
+      thread_pool_delete(pool);
+      return 1;
+    }
+    printf("\nResulting shortest paths from vertex %d (%s backend):\n", initial_vertex, engine_backend);
+    for (int i = 0; !generated && i < g->nb_vertices; i++) {
+      if (dst[i].weight == INFINITY)
+        printf("to vertex %d, length   ∞ : \n", i);
+      else {
+        printf("to vertex %d, length %.2f: ", i, dst[i].weight);
+        print_path(g, dst, i);
+      }
+    }
+    free(dst);
+    graph_csr_delete(csr);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Generic engine process - end
+  }
+
+  if (use_phast) {
+    // PHAST process - beginning
+    phast_s *ph = phast_create(g);
+    workspace_s *ws = workspace_create(g->nb_vertices);
+    double *dist = malloc(g->nb_vertices * sizeof(double));
+    assert(dist!=NULL);
+    phast_query(ph, initial_vertex, ws, dist);
+    printf("\nVertex hierarchy built with %d shortcuts.\n", ph->nb_shortcuts);
+    printf("Resulting PHAST distances from vertex %d:\n", initial_vertex);
+    for (int i = 0; i < g->nb_vertices; i++) {
+      if (dist[ph->position[i]] == INFINITY)
+        printf("to vertex %d, length   ∞\n", i);
+      else
+        printf("to vertex %d, length %.2f\n", i, dist[ph->position[i]]);
+    }
+    free(dist);
+    workspace_delete(ws);
+    phast_delete(ph);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // PHAST process - end
+  }
+
+  if (use_parallel) {
+    // Parallel Dijkstra process - beginning
+    vertex_s *dst = dijkstra_parallel(g, initial_vertex, pool);
+    printf("\nResulting parallel Dijkstra shortest paths from vertex %d (%d threads):\n", initial_vertex, thread_pool_size(pool));
+    for (int i = 0; i < g->nb_vertices; i++) {
+      if (dst[i].weight == INFINITY)
+        printf("to vertex %d, length   ∞ : \n", i);
+      else {
+        printf("to vertex %d, length %.2f: ", i, dst[i].weight);
+        print_path(g, dst, i);
+      }
+    }
+    free(dst);
+    delete_graph(g);
+    thread_pool_delete(pool);
+    return 0;
+    // Parallel Dijkstra process - end
+  }
 
   // Dijkstra algorithm process - beginning
   vertex_s *dst = dijkstra(g, initial_vertex);
@@ -258,6 +2349,7 @@ int main(int argc, char **argv) {
 
   // delete the graph_s
   delete_graph(g);
+  thread_pool_delete(pool);
   
   // that's all folk !
   return 0;
@@ -0,0 +1,245 @@
+/**
+ * @file mst.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Parallel Borůvka and Prim minimum spanning forests.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "mst.h"
+#include "heap.h"
+
+/**
+ * @brief Structure shared by the tasks of a Borůvka.
+ */
+typedef struct {
+  const graph_csr_s *csr; /**< The graph */
+  int *tail;              /**< Tail of each edge */
+  int *parent;            /**< Parent of each vertex in the union-find forest */
+  int *best;              /**< Lightest edge leaving each component, indexed by root (-1 if none) */
+  mst_s *mst;             /**< The forest being built */
+} boruvka_s;
+
+/**
+ * @brief Compares two edges in the total order of the edges.
+ *
+ * @param b The Borůvka.
+ * @param e The first edge.
+ * @param f The second edge.
+ * @return true if e comes before f.
+ */
+static inline bool edge_less(const boruvka_s *b, int e, int f) {
+  const graph_csr_s *csr = b->csr;
+  if (csr->weight[e] != csr->weight[f]) return csr->weight[e] < csr->weight[f];
+  int e_lo = b->tail[e] < csr->head[e] ? b->tail[e] : csr->head[e];
+  int f_lo = b->tail[f] < csr->head[f] ? b->tail[f] : csr->head[f];
+  if (e_lo != f_lo) return e_lo < f_lo;
+  int e_hi = b->tail[e] ^ csr->head[e] ^ e_lo;
+  int f_hi = b->tail[f] ^ csr->head[f] ^ f_lo;
+  return e_hi < f_hi;
+}
+
+/**
+ * @brief Finds the root of the component of a vertex, halving the path on the way.
+ *
+ * Each vertex visited is linked to its grand-parent with a compare-and-swap, so
+ * concurrent finds and unions never lose a link.
+ *
+ * @param parent The union-find forest.
+ * @param x The vertex.
+ * @return The root of its component.
+ */
+static int uf_find(int *parent, int x) {
+  for (;;) {
+    int p = __atomic_load_n(&parent[x], __ATOMIC_ACQUIRE);
+    if (p == x) return x;
+    int gp = __atomic_load_n(&parent[p], __ATOMIC_ACQUIRE);
+    if (gp != p)
+      __atomic_compare_exchange_n(&parent[x], &p, gp, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    x = gp;
+  }
+}
+
+/**
+ * @brief Merges the components of two vertices.
+ *
+ * The root of larger index is linked under the other one, so the links always go
+ * towards smaller indices and concurrent unions cannot create a cycle.
+ *
+ * @param parent The union-find forest.
+ * @param a The first vertex.
+ * @param b The second vertex.
+ * @return false if the vertices were already in the same component.
+ */
+static bool uf_union(int *parent, int a, int b) {
+  for (;;) {
+    a = uf_find(parent, a);
+    b = uf_find(parent, b);
+    if (a == b) return false;
+    if (a < b) { int tmp = a; a = b; b = tmp; }
+    int expected = a;
+    if (__atomic_compare_exchange_n(&parent[a], &expected, b, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      return true;
+  }
+}
+
+/**
+ * @brief Selects for each component the lightest edge leaving it, for the vertices [lo, hi).
+ *
+ * Each vertex computes its lightest edge towards another component, then lowers the
+ * selection of its component with a compare-and-swap loop.
+ */
+static void select_body(int lo, int hi, void *arg) {
+  boruvka_s *b = arg;
+  const graph_csr_s *csr = b->csr;
+  for (int u = lo; u < hi; u++) {
+    int cu = uf_find(b->parent, u);
+    int lightest = -1;
+    for (int e = csr->first[u]; e < csr->first[u + 1]; e++)
+      if (uf_find(b->parent, csr->head[e]) != cu && (lightest < 0 || edge_less(b, e, lightest)))
+        lightest = e;
+    if (lightest < 0) continue;
+    int cur = __atomic_load_n(&b->best[cu], __ATOMIC_RELAXED);
+    while (cur < 0 || edge_less(b, lightest, cur))
+      if (__atomic_compare_exchange_n(&b->best[cu], &cur, lightest, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+  }
+}
+
+/**
+ * @brief Adds the selected edges of the components rooted in [lo, hi) to the forest.
+ *
+ * An edge selected by both of its components is added once: the second union finds
+ * its endpoints already merged.
+ */
+static void merge_body(int lo, int hi, void *arg) {
+  boruvka_s *b = arg;
+  for (int c = lo; c < hi; c++) {
+    int e = b->best[c];
+    if (e < 0) continue;
+    b->best[c] = -1;
+    if (uf_union(b->parent, b->tail[e], b->csr->head[e])) {
+      int k = __atomic_fetch_add(&b->mst->nb_edges, 1, __ATOMIC_RELAXED);
+      b->mst->edges[k] = (edge_s){b->tail[e], b->csr->head[e], b->csr->weight[e]};
+    }
+  }
+}
+
+/**
+ * @brief Computes a minimum spanning forest with a parallel Borůvka.
+ *
+ * The rounds alternate a selection phase over the vertices and a merge phase over
+ * the components, both split in ranges of vertices run by the pool, until a round
+ * adds no edge.
+ *
+ * @param csr The undirected graph (each edge stored in both directions).
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created forest.
+ */
+mst_s *mst_boruvka(const graph_csr_s *csr, thread_pool_s *pool) {
+  assert(csr!=NULL);
+  int n = csr->nb_vertices;
+  boruvka_s b = {.csr = csr};
+  b.tail = malloc((csr->nb_edges + 1)*sizeof(int));
+  b.parent = malloc((n + 1)*sizeof(int));
+  b.best = malloc((n + 1)*sizeof(int));
+  b.mst = malloc(sizeof(mst_s));
+  assert(b.tail!=NULL && b.parent!=NULL && b.best!=NULL && b.mst!=NULL);
+  b.mst->edges = malloc(((size_t)n + 1)*sizeof(edge_s));
+  assert(b.mst->edges!=NULL);
+  b.mst->nb_edges = 0;
+  for (int v = 0; v < n; v++) {
+    b.parent[v] = v;
+    b.best[v] = -1;
+    for (int e = csr->first[v]; e < csr->first[v + 1]; e++)
+      b.tail[e] = v;
+  }
+  int grain = 1 + n / (8 * thread_pool_size(pool));
+  int nb_added;
+  do {
+    nb_added = b.mst->nb_edges;
+    thread_pool_parallel_for(pool, 0, n, grain, select_body, &b);
+    thread_pool_parallel_for(pool, 0, n, grain, merge_body, &b);
+  } while (b.mst->nb_edges > nb_added);
+  b.mst->nb_trees = n - b.mst->nb_edges;
+  b.mst->weight = 0.0;
+  for (int i = 0; i < b.mst->nb_edges; i++)
+    b.mst->weight += b.mst->edges[i].weight;
+  free(b.tail);
+  free(b.parent);
+  free(b.best);
+  return b.mst;
+}
+
+/**
+ * @brief Computes a minimum spanning forest with Prim's algorithm.
+ *
+ * The heap holds the vertices not yet in the tree, keyed by the weight of their
+ * lightest edge towards the tree (the tail of this edge being `prev`); a lighter
+ * edge decreases the key in place. When the heap is empty, a new tree is grown from
+ * the next vertex outside the forest.
+ *
+ * @param csr The undirected graph (each edge stored in both directions).
+ * @return Pointer to the created forest.
+ */
+mst_s *mst_prim(const graph_csr_s *csr) {
+  assert(csr!=NULL);
+  int n = csr->nb_vertices;
+  mst_s *mst = malloc(sizeof(mst_s));
+  assert(mst!=NULL);
+  mst->edges = malloc(((size_t)n + 1)*sizeof(edge_s));
+  bool *in_tree = calloc(n + 1, sizeof(bool));
+  assert(mst->edges!=NULL && in_tree!=NULL);
+  mst->nb_edges = 0;
+  mst->nb_trees = 0;
+  mst->weight = 0.0;
+  heap_s *q = heap_create(n);
+  for (int root = 0; root < n; root++) {
+    if (in_tree[root]) continue;
+    mst->nb_trees++;
+    q = heap_add((vertex_s){.ind = root, .weight = 0.0, .prev = -1}, q);
+    while (!heap_empty(q)) {
+      vertex_s v = heap_peek(q);
+      q = heap_remove(q);
+      in_tree[v.ind] = true;
+      if (v.prev >= 0) {
+        mst->edges[mst->nb_edges++] = (edge_s){v.prev, v.ind, v.weight};
+        mst->weight += v.weight;
+      }
+      for (int e = csr->first[v.ind]; e < csr->first[v.ind + 1]; e++)
+        if (!in_tree[csr->head[e]])
+          q = heap_add((vertex_s){.ind = csr->head[e], .weight = csr->weight[e], .prev = v.ind}, q);
+    }
+  }
+  heap_delete(q);
+  free(in_tree);
+  return mst;
+}
+
+/**
+ * @brief Deletes a spanning forest and frees its memory.
+ *
+ * @param mst Pointer to the forest.
+ */
+void mst_delete(mst_s *mst) {
+  if (!mst) return;
+  free(mst->edges);
+  free(mst);
+}
@@ -0,0 +1,207 @@
+/**
+ * @file multiqueue.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Relaxed concurrent priority queue (MultiQueue).
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include <assert.h>
+#include "multiqueue.h"
+
+/** @brief Initial capacity of each heap, doubled when it is full. */
+#define MQ_INITIAL_CAPACITY 64
+
+/**
+ * @brief Structure of one heap of the multiqueue.
+ *
+ * The heap is a binary heap without index: a vertex whose distance decreases is
+ * pushed again and its outdated entries are skipped by the caller (lazy deletion),
+ * so the array grows with the entries of the heap only, not with the graph.
+ * Each heap is aligned on a cache line so that threads working on different heaps
+ * do not share lines.
+ */
+typedef struct {
+  _Alignas(64) pthread_mutex_t lock; /**< Lock of the heap */
+  vertex_s *items;                    /**< The entries, ordered as a binary heap */
+  int size;                           /**< Number of entries */
+  int capacity;                       /**< Number of entries allocated */
+  double top;                         /**< Weight of the head (INFINITY if empty), read without lock */
+} mq_heap_s;
+
+/**
+ * @brief Structure of the multiqueue.
+ */
+struct multiqueue {
+  int nb_queues;     /**< Number of heaps */
+  mq_heap_s *queues; /**< The heaps */
+  int nb_elements;   /**< Number of elements in all the heaps (atomic) */
+};
+
+/**
+ * @brief Reads the weight of the head of a heap without taking its lock.
+ */
+static double mq_top(mq_heap_s *q) {
+  double top;
+  __atomic_load(&q->top, &top, __ATOMIC_ACQUIRE);
+  return top;
+}
+
+/**
+ * @brief Publishes the weight of the head of a heap (its lock is held).
+ */
+static void mq_update_top(mq_heap_s *q) {
+  double top = (q->size == 0) ? INFINITY : q->items[0].weight;
+  __atomic_store(&q->top, &top, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Adds an entry to a heap (its lock is held), growing its array if full.
+ */
+static void mq_heap_add(mq_heap_s *q, vertex_s vertex) {
+  if (q->size == q->capacity) {
+    q->capacity *= 2;
+    q->items = realloc(q->items, q->capacity*sizeof(vertex_s));
+    assert(q->items!=NULL);
+  }
+  int i = q->size++;
+  while (i > 0 && q->items[(i - 1) / 2].weight > vertex.weight) {
+    q->items[i] = q->items[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  q->items[i] = vertex;
+}
+
+/**
+ * @brief Removes the head of a non empty heap (its lock is held).
+ */
+static vertex_s mq_heap_remove(mq_heap_s *q) {
+  vertex_s head = q->items[0];
+  vertex_s last = q->items[--q->size];
+  int i = 0;
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= q->size) break;
+    if (child + 1 < q->size && q->items[child + 1].weight < q->items[child].weight) child++;
+    if (q->items[child].weight >= last.weight) break;
+    q->items[i] = q->items[child];
+    i = child;
+  }
+  if (q->size > 0) q->items[i] = last;
+  return head;
+}
+
+/**
+ * @brief Creates a multiqueue.
+ *
+ * @param nb_queues Number of heaps (usually twice the number of threads).
+ * @return Pointer to the created multiqueue.
+ */
+multiqueue_s *multiqueue_create(int nb_queues) {
+  assert(nb_queues>0);
+  multiqueue_s *mq = malloc(sizeof(multiqueue_s));
+  assert(mq!=NULL);
+  mq->nb_queues = nb_queues;
+  mq->nb_elements = 0;
+  mq->queues = aligned_alloc(64, nb_queues*sizeof(mq_heap_s));
+  assert(mq->queues!=NULL);
+  for (int i = 0; i < nb_queues; i++) {
+    pthread_mutex_init(&mq->queues[i].lock, NULL);
+    mq->queues[i].items = malloc(MQ_INITIAL_CAPACITY*sizeof(vertex_s));
+    assert(mq->queues[i].items!=NULL);
+    mq->queues[i].size = 0;
+    mq->queues[i].capacity = MQ_INITIAL_CAPACITY;
+    mq->queues[i].top = INFINITY;
+  }
+  return mq;
+}
+
+/**
+ * @brief Adds a vertex to a random heap.
+ *
+ * @param mq The multiqueue.
+ * @param vertex The vertex to add.
+ * @param seed The random seed of the calling thread.
+ */
+void multiqueue_push(multiqueue_s *mq, vertex_s vertex, unsigned int *seed) {
+  assert(mq!=NULL);
+  mq_heap_s *q;
+  do {
+    q = &mq->queues[rand_r(seed) % mq->nb_queues];
+  } while (pthread_mutex_trylock(&q->lock) != 0);
+  mq_heap_add(q, vertex);
+  __atomic_add_fetch(&mq->nb_elements, 1, __ATOMIC_ACQ_REL);
+  mq_update_top(q);
+  pthread_mutex_unlock(&q->lock);
+}
+
+/**
+ * @brief Removes the head of the better of two random heaps.
+ *
+ * @param mq The multiqueue.
+ * @param vertex Receives the removed vertex.
+ * @param seed The random seed of the calling thread.
+ * @return true if a vertex was removed, false if the multiqueue was seen empty.
+ */
+bool multiqueue_pop(multiqueue_s *mq, vertex_s *vertex, unsigned int *seed) {
+  assert(mq!=NULL && vertex!=NULL);
+  while (__atomic_load_n(&mq->nb_elements, __ATOMIC_ACQUIRE) > 0) {
+    mq_heap_s *q1 = &mq->queues[rand_r(seed) % mq->nb_queues];
+    mq_heap_s *q2 = &mq->queues[rand_r(seed) % mq->nb_queues];
+    mq_heap_s *q = (mq_top(q1) <= mq_top(q2)) ? q1 : q2;
+    if (mq_top(q) == INFINITY) continue; // both heaps look empty
+    if (pthread_mutex_trylock(&q->lock) != 0) continue;
+    bool found = (q->size > 0);
+    if (found) {
+      *vertex = mq_heap_remove(q);
+      __atomic_sub_fetch(&mq->nb_elements, 1, __ATOMIC_ACQ_REL);
+      mq_update_top(q);
+    }
+    pthread_mutex_unlock(&q->lock);
+    if (found) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Gets the number of elements of a multiqueue.
+ *
+ * @param mq The multiqueue.
+ * @return The number of elements (a snapshot while other threads are working).
+ */
+int multiqueue_size(multiqueue_s *mq) {
+  assert(mq!=NULL);
+  return __atomic_load_n(&mq->nb_elements, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Deletes a multiqueue and frees its memory.
+ *
+ * @param mq The multiqueue.
+ */
+void multiqueue_delete(multiqueue_s *mq) {
+  assert(mq!=NULL);
+  for (int i = 0; i < mq->nb_queues; i++) {
+    pthread_mutex_destroy(&mq->queues[i].lock);
+    free(mq->queues[i].items);
+  }
+  free(mq->queues);
+  free(mq);
+}
@@ -0,0 +1,347 @@
+/**
+ * @file oracle.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Thorup–Zwick approximate distance oracles stored in mappable files.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "oracle.h"
+#include "voronoi.h"
+#include "graph_csr.h"
+#include "workspace.h"
+#include "numa_alloc.h"
+
+/** @brief Rounds a size up to a multiple of 8 bytes. */
+#define ALIGN8(size) (((size) + 7) & ~(size_t)7)
+
+/**
+ * @brief Structure representing a vertex of a cluster: an entry of the bunch of `v`.
+ */
+typedef struct {
+  int v;   /**< Owner of the bunch */
+  int w;   /**< Center of the cluster */
+  float d; /**< Distance between w and v */
+} cluster_entry_s;
+
+/**
+ * @brief Sets the arrays of an oracle from its block.
+ *
+ * @param o The oracle.
+ * @param block The block, beginning with its header.
+ * @param size The size of the block.
+ * @return false if the block is not a consistent oracle.
+ */
+static bool oracle_bind(oracle_s *o, void *block, size_t size) {
+  const oracle_header_s *h = block;
+  if (size < sizeof(oracle_header_s) || h->magic != ORACLE_MAGIC || h->size != size) return false;
+  if (h->k < 1 || h->nb_vertices < 0) return false;
+  size_t kn = (size_t)h->k * h->nb_vertices;
+  // Each array fits in the block, so that the offsets below cannot wrap around
+  if (kn > size / (sizeof(int32_t) + sizeof(float)) || (size_t)h->nb_vertices + 1 > size / sizeof(uint64_t) ||
+      h->nb_slots > size / (sizeof(int32_t) + sizeof(float)))
+    return false;
+  size_t off_pivot = ALIGN8(sizeof(oracle_header_s));
+  size_t off_pivot_dist = off_pivot + kn * sizeof(int32_t);
+  size_t off_first = ALIGN8(off_pivot_dist + kn * sizeof(float));
+  size_t off_slot_vertex = off_first + ((size_t)h->nb_vertices + 1) * sizeof(uint64_t);
+  size_t off_slot_dist = off_slot_vertex + h->nb_slots * sizeof(int32_t);
+  if (off_slot_dist + h->nb_slots * sizeof(float) != size) return false;
+  char *base = block;
+  o->k = h->k;
+  o->nb_vertices = h->nb_vertices;
+  o->pivot = (const int32_t *)(base + off_pivot);
+  o->pivot_dist = (const float *)(base + off_pivot_dist);
+  o->bunch_first = (const uint64_t *)(base + off_first);
+  o->slot_vertex = (const int32_t *)(base + off_slot_vertex);
+  o->slot_dist = (const float *)(base + off_slot_dist);
+  o->block = block;
+  o->size = size;
+  return o->bunch_first[o->nb_vertices] == h->nb_slots;
+}
+
+/**
+ * @brief Gets the size of a block.
+ *
+ * @param k The number of levels.
+ * @param nb_vertices The number of vertices.
+ * @param nb_slots The number of slots of the bunches.
+ * @return The size in bytes.
+ */
+static size_t oracle_size(int k, int nb_vertices, uint64_t nb_slots) {
+  size_t kn = (size_t)k * nb_vertices;
+  size_t size = ALIGN8(sizeof(oracle_header_s)) + kn * sizeof(int32_t);
+  size = ALIGN8(size + kn * sizeof(float));
+  return size + ((size_t)nb_vertices + 1) * sizeof(uint64_t) + nb_slots * (sizeof(int32_t) + sizeof(float));
+}
+
+/**
+ * @brief Gets the number of slots of the hash table of a bunch.
+ *
+ * @param nb_entries The number of vertices of the bunch.
+ * @return The smallest power of 2 keeping the table at most half full: a vertex
+ *         missing from the bunch, the common case of a query, ends a short probe.
+ */
+static uint64_t bunch_slots(int nb_entries) {
+  uint64_t slots = 2;
+  while (slots < 2 * (uint64_t)nb_entries) slots *= 2;
+  return slots;
+}
+
+/**
+ * @brief Samples the levels of the vertices.
+ *
+ * The level of a vertex is the last i such that it belongs to A_i: each vertex of A_i
+ * is kept in A_(i+1) with probability n^(-1/k). The sampling is repeated until
+ * A_(k-1) is not empty.
+ *
+ * @param n The number of vertices (at least 1).
+ * @param k The number of levels.
+ * @param seed The seed of the sampling.
+ * @param level Array of n levels to fill.
+ */
+static void sample_levels(int n, int k, unsigned int seed, int *level) {
+  double keep = pow(n, -1.0 / k);
+  bool top;
+  do {
+    top = (k == 1);
+    for (int v = 0; v < n; v++) {
+      level[v] = 0;
+      while (level[v] + 1 < k && rand_r(&seed) < keep * RAND_MAX) level[v]++;
+      if (level[v] == k - 1) top = true;
+    }
+  } while (!top);
+}
+
+/**
+ * @brief Builds the oracle of an undirected graph.
+ *
+ * @param g The graph (undirected, with positive weights).
+ * @param k The number of levels (at least 1): the stretch is 2k-1.
+ * @param seed The seed of the sampling of the levels.
+ * @return Pointer to the created oracle, NULL if the graph is directed.
+ */
+oracle_s *oracle_build(graph_s *g, int k, unsigned int seed) {
+  assert(g!=NULL && k >= 1 && g->nb_vertices > 0);
+  if (g->directed) return NULL;
+  int n = g->nb_vertices;
+  size_t kn = (size_t)k * n;
+  int *level = malloc(n * sizeof(int));
+  int *seeds = malloc(n * sizeof(int));
+  int32_t *pivot = malloc(kn * sizeof(int32_t));
+  double *pivot_dist = malloc(kn * sizeof(double));
+  assert(level!=NULL && seeds!=NULL && pivot!=NULL && pivot_dist!=NULL);
+  sample_levels(n, k, seed, level);
+  // Pivots: one multi-source Dijkstra from each A_i
+  for (int i = 0; i < k; i++) {
+    int nb_seeds = 0;
+    for (int v = 0; v < n; v++)
+      if (level[v] >= i) seeds[nb_seeds++] = v;
+    vertex_s *dist = dijkstra_multi(g, seeds, nb_seeds, pivot + (size_t)i * n);
+    for (int v = 0; v < n; v++)
+      pivot_dist[(size_t)i * n + v] = dist[v].weight;
+    free(dist);
+  }
+  // Clusters: from each w of A_i \ A_(i+1), the search only goes on while d(w, v) < d(A_(i+1), v)
+  graph_csr_s *csr = graph_csr_create(g);
+  workspace_s *ws = workspace_create(n);
+  size_t nb_entries = 0, max_entries = 4 * (size_t)n;
+  cluster_entry_s *entries = malloc(max_entries * sizeof(cluster_entry_s));
+  int *bunch_size = calloc(n, sizeof(int));
+  assert(entries!=NULL && bunch_size!=NULL);
+  for (int w = 0; w < n; w++) {
+    const double *bound = (level[w] + 1 < k) ? pivot_dist + (size_t)(level[w] + 1) * n : NULL;
+    workspace_reset(ws);
+    workspace_push(ws, w, 0.0, -1);
+    vertex_s x;
+    while (workspace_pop(ws, &x)) {
+      if (nb_entries == max_entries) {
+        max_entries *= 2;
+        entries = realloc(entries, max_entries * sizeof(cluster_entry_s));
+        assert(entries!=NULL);
+      }
+      entries[nb_entries++] = (cluster_entry_s){x.ind, w, (float)x.weight};
+      bunch_size[x.ind]++;
+      for (int e = csr->first[x.ind]; e < csr->first[x.ind + 1]; e++) {
+        double d = x.weight + csr->weight[e];
+        if (bound == NULL || d < bound[csr->head[e]])
+          workspace_push(ws, csr->head[e], d, x.ind);
+      }
+    }
+  }
+  workspace_delete(ws);
+  graph_csr_delete(csr);
+  // Each bunch becomes a hash table
+  uint64_t nb_slots = 0;
+  for (int v = 0; v < n; v++) {
+    nb_slots += bunch_slots(bunch_size[v]);
+  }
+  size_t size = oracle_size(k, n, nb_slots);
+  void *block = numa_alloc_interleaved(size);
+  assert(block!=NULL);
+  *(oracle_header_s *)block = (oracle_header_s){ORACLE_MAGIC, k, n, 0, nb_slots, size};
+  oracle_s *o = malloc(sizeof(oracle_s));
+  assert(o!=NULL);
+  o->mapped = false;
+  // The arrays are bound before being filled: the header gives their sizes
+  uint64_t *first = (uint64_t *)((char *)block + ALIGN8(ALIGN8(sizeof(oracle_header_s)) + kn * (sizeof(int32_t) + sizeof(float))));
+  first[0] = 0;
+  for (int v = 0; v < n; v++) {
+    first[v + 1] = first[v] + bunch_slots(bunch_size[v]);
+  }
+  bool consistent = oracle_bind(o, block, size);
+  assert(consistent);
+  (void)consistent;
+  int32_t *slot_vertex = (int32_t *)o->slot_vertex;
+  float *slot_dist = (float *)o->slot_dist;
+  for (uint64_t s = 0; s < nb_slots; s++)
+    slot_vertex[s] = -1;
+  for (size_t i = 0; i < nb_entries; i++) {
+    uint64_t base = first[entries[i].v];
+    uint32_t mask = (uint32_t)(first[entries[i].v + 1] - base - 1);
+    uint32_t h = (uint32_t)entries[i].w * 0x9e3779b1u;
+    uint32_t s = (h ^ (h >> 16)) & mask;
+    while (slot_vertex[base + s] != -1) s = (s + 1) & mask;
+    slot_vertex[base + s] = entries[i].w;
+    slot_dist[base + s] = entries[i].d;
+  }
+  int32_t *pivots = (int32_t *)o->pivot;
+  float *pivot_dists = (float *)o->pivot_dist;
+  for (size_t i = 0; i < kn; i++) {
+    pivots[i] = pivot[i];
+    pivot_dists[i] = (float)pivot_dist[i];
+  }
+  free(entries);
+  free(bunch_size);
+  free(pivot_dist);
+  free(pivot);
+  free(seeds);
+  free(level);
+  return o;
+}
+
+/**
+ * @brief Saves an oracle in a file.
+ *
+ * @param o The oracle.
+ * @param path The path of the file.
+ * @return false if the file could not be written.
+ */
+bool oracle_save(const oracle_s *o, const char *path) {
+  assert(o!=NULL && path!=NULL);
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) return false;
+  bool written = fwrite(o->block, 1, o->size, f) == o->size;
+  return (fclose(f) == 0) && written;
+}
+
+/**
+ * @brief Checks the arrays of an oracle read from a file before it is queried.
+ *
+ * The bunches must follow each other within the slots, each one being a hash
+ * table whose size is a power of 2 (at most 2^32) with an empty slot, so that
+ * a probe ends; the pivots must be vertices or -1.
+ *
+ * @param o The oracle.
+ * @return false if a query could read outside the arrays or probe forever.
+ */
+static bool oracle_check(const oracle_s *o) {
+  int n = o->nb_vertices;
+  if (o->bunch_first[0] != 0) return false;
+  for (int v = 0; v < n; v++) {
+    uint64_t first = o->bunch_first[v], slots = o->bunch_first[v + 1] - first;
+    if (o->bunch_first[v + 1] < first || o->bunch_first[v + 1] > o->bunch_first[n]) return false;
+    if (slots < 2 || slots > ((uint64_t)1 << 32) || (slots & (slots - 1)) != 0) return false;
+    bool empty = false;
+    for (uint64_t s = first; s < first + slots; s++) {
+      if (o->slot_vertex[s] < -1 || o->slot_vertex[s] >= n) return false;
+      if (o->slot_vertex[s] == -1) empty = true;
+    }
+    if (!empty) return false;
+  }
+  for (size_t i = 0; i < (size_t)o->k * n; i++)
+    if (o->pivot[i] < -1 || o->pivot[i] >= n) return false;
+  return true;
+}
+
+/**
+ * @brief Maps an oracle file in memory, read-only.
+ *
+ * @param path The path of the file.
+ * @return Pointer to the oracle, NULL if the file could not be mapped or is not a
+ *         consistent oracle.
+ */
+oracle_s *oracle_load(const char *path) {
+  assert(path!=NULL);
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) return NULL;
+  struct stat st;
+  if (fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof(oracle_header_s)) {
+    close(fd);
+    return NULL;
+  }
+  size_t size = (size_t)st.st_size;
+  void *block = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (block == MAP_FAILED) return NULL;
+  // The file is checked in one pass before the queries
+  madvise(block, size, MADV_SEQUENTIAL);
+  oracle_s *o = malloc(sizeof(oracle_s));
+  assert(o!=NULL);
+  o->mapped = true;
+  if (!oracle_bind(o, block, size) || !oracle_check(o)) {
+    munmap(block, size);
+    free(o);
+    return NULL;
+  }
+  // The queries probe the bunches at random: no read-ahead
+  madvise(block, size, MADV_RANDOM);
+  return o;
+}
+
+/**
+ * @brief Gets the number of entries of the bunches of an oracle.
+ *
+ * @param o The oracle.
+ * @return The sum of the sizes of the bunches.
+ */
+uint64_t oracle_nb_entries(const oracle_s *o) {
+  assert(o!=NULL);
+  uint64_t nb_entries = 0;
+  for (uint64_t s = 0; s < o->bunch_first[o->nb_vertices]; s++)
+    if (o->slot_vertex[s] != -1) nb_entries++;
+  return nb_entries;
+}
+
+/**
+ * @brief Deletes an oracle: frees its block or unmaps its file.
+ *
+ * @param o Pointer to the oracle.
+ */
+void oracle_delete(oracle_s *o) {
+  assert(o!=NULL);
+  if (o->mapped) munmap(o->block, o->size);
+  else numa_free(o->block, o->size);
+  free(o);
+}
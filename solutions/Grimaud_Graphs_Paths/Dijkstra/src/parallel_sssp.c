@@ -0,0 +1,105 @@
+/**
+ * @file parallel_sssp.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Parallel label-correcting Dijkstra on a relaxed priority queue.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <sched.h>
+#include <assert.h>
+#include "parallel_sssp.h"
+#include "multiqueue.h"
+#include "dist_store.h"
+
+/**
+ * @brief Structure shared by the workers of a search.
+ */
+typedef struct {
+  graph_s *g;          /**< The graph */
+  multiqueue_s *mq;    /**< The vertices to process */
+  dist_store_s *store; /**< The labels, lowered without locks */
+  int active;          /**< Queued or processed vertices (atomic) */
+} sssp_s;
+
+/**
+ * @brief Lowers the label of a vertex and queues it if the new distance is shorter.
+ */
+static void sssp_relax(sssp_s *s, int v, float weight, int prev, unsigned int *seed) {
+  if (!dist_store_min(s->store, v, weight, prev)) return;
+  // counted before being visible, so that active never drops to 0 too early
+  __atomic_add_fetch(&s->active, 1, __ATOMIC_ACQ_REL);
+  vertex_s tmp = {.ind = v, .weight = weight, .prev = prev};
+  multiqueue_push(s->mq, tmp, seed);
+}
+
+/**
+ * @brief Loop of a worker: processes vertices until the search is over.
+ */
+static void sssp_worker(void *arg) {
+  sssp_s *s = arg;
+  unsigned int seed = 0x9e3779b9u * (unsigned int)(thread_pool_worker_id() + 2);
+  vertex_s v;
+  for (;;) {
+    if (multiqueue_pop(s->mq, &v, &seed)) {
+      if (v.weight <= dist_store_dist(s->store, v.ind)) { // skip the outdated labels
+        for (adj_list_s *adj = get_adj_list(s->g, v.ind); adj != NULL; adj = adj->next)
+          sssp_relax(s, adj->vertex.ind, (float)(v.weight + adj->vertex.weight), v.ind, &seed);
+      }
+      __atomic_sub_fetch(&s->active, 1, __ATOMIC_ACQ_REL);
+    } else if (__atomic_load_n(&s->active, __ATOMIC_ACQUIRE) == 0) {
+      return;
+    } else {
+      sched_yield(); // other workers are still processing vertices
+    }
+  }
+}
+
+/**
+ * @brief Performs a parallel label-correcting Dijkstra from a source vertex.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return An array of vertices with the shortest path information, as `dijkstra()`.
+ */
+vertex_s *dijkstra_parallel(graph_s *g, int src, thread_pool_s *pool) {
+  assert(g!=NULL && src>=0 && src<g->nb_vertices);
+  int nb_workers = thread_pool_size(pool);
+  sssp_s s = {.g = g, .active = 0};
+  s.mq = multiqueue_create(2 * nb_workers);
+  s.store = dist_store_create(g->nb_vertices);
+
+  unsigned int seed = 1;
+  sssp_relax(&s, src, 0.0f, -1, &seed);
+  task_group_s group = TASK_GROUP_INIT;
+  for (int w = 0; w < nb_workers; w++)
+    thread_pool_submit(pool, &group, sssp_worker, &s);
+  thread_pool_wait(pool, &group);
+
+  vertex_s *dist = malloc(g->nb_vertices*sizeof(vertex_s));
+  assert(dist!=NULL);
+  for (int i = 0; i < g->nb_vertices; i++) {
+    uint64_t label = dist_store_load(s.store, i);
+    dist[i] = (vertex_s){.ind = i, .weight = dist_store_unpack_dist(label), .prev = dist_store_unpack_parent(label)};
+  }
+  dist_store_delete(s.store);
+  multiqueue_delete(s.mq);
+  return dist;
+}
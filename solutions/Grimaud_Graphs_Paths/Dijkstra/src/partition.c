@@ -0,0 +1,894 @@
+/**
+ * @file partition.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Multilevel k-way graph partitioner, for sharding and cache blocking.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "partition.h"
+#include "heap.h"
+
+/** @brief Maximum number of graphs of the hierarchy. */
+#define MAX_LEVELS 64
+/** @brief Maximum number of proposal rounds of a matching. */
+#define MATCHING_ROUNDS 8
+/** @brief Number of seeds tried by each bisection of the initial partition. */
+#define BISECTION_TRIES 8
+/** @brief Maximum number of parallel greedy passes per level. */
+#define GREEDY_PASSES 8
+/** @brief Maximum number of Fiduccia-Mattheyses passes per level. */
+#define FM_PASSES 4
+
+/**
+ * @brief Structure representing a weighted graph of the hierarchy.
+ *
+ * The edges are stored in both directions. The weight of a vertex is the number of
+ * original vertices it stands for, the weight of an edge the number of original
+ * edges.
+ */
+typedef struct {
+  int nb_vertices; /**< Number of vertices */
+  int *first;      /**< First edge of each vertex (nb_vertices+1 entries) */
+  int *head;       /**< Head of each edge */
+  int *ewgt;       /**< Weight of each edge */
+  int *vwgt;       /**< Weight of each vertex */
+} pgraph_s;
+
+/**
+ * @brief Allocates a weighted graph.
+ *
+ * @param n The number of vertices.
+ * @param nb_edges The number of edges.
+ * @return Pointer to the graph.
+ */
+static pgraph_s *pgraph_create(int n, int nb_edges) {
+  pgraph_s *g = malloc(sizeof(pgraph_s));
+  assert(g!=NULL);
+  g->nb_vertices = n;
+  g->first = calloc(n + 1, sizeof(int));
+  g->head = malloc((nb_edges + 1) * sizeof(int));
+  g->ewgt = malloc((nb_edges + 1) * sizeof(int));
+  g->vwgt = malloc((n + 1) * sizeof(int));
+  assert(g->first!=NULL && g->head!=NULL && g->ewgt!=NULL && g->vwgt!=NULL);
+  return g;
+}
+
+/**
+ * @brief Deletes a weighted graph.
+ *
+ * @param g The graph.
+ */
+static void pgraph_delete(pgraph_s *g) {
+  free(g->first);
+  free(g->head);
+  free(g->ewgt);
+  free(g->vwgt);
+  free(g);
+}
+
+/**
+ * @brief Builds the simple undirected graph underlying a graph.
+ *
+ * Each adjacency gives the edge in both directions; the loops are dropped and the
+ * copies of an edge are merged.
+ *
+ * @param g The graph.
+ * @return Pointer to the weighted graph (all the weights are 1).
+ */
+static pgraph_s *pgraph_from_graph(graph_s *g) {
+  int n = g->nb_vertices;
+  int *first = calloc(n + 1, sizeof(int));
+  assert(first!=NULL);
+  for (int u = 0; u < n; u++)
+    for (adj_list_s *adj = get_adj_list(g, u); adj != NULL; adj = adj->next)
+      if (adj->vertex.ind != u) {
+        first[u + 1]++;
+        first[adj->vertex.ind + 1]++;
+      }
+  for (int u = 0; u < n; u++)
+    first[u + 1] += first[u];
+  int *head = malloc((first[n] + 1) * sizeof(int));
+  int *next = malloc((n + 1) * sizeof(int));
+  assert(head!=NULL && next!=NULL);
+  memcpy(next, first, n * sizeof(int));
+  for (int u = 0; u < n; u++)
+    for (adj_list_s *adj = get_adj_list(g, u); adj != NULL; adj = adj->next)
+      if (adj->vertex.ind != u) {
+        head[next[u]++] = adj->vertex.ind;
+        head[next[adj->vertex.ind]++] = u;
+      }
+  // Merge the copies: next[v] holds the last vertex having v as a neighbour
+  int nb_edges = 0;
+  for (int v = 0; v < n; v++)
+    next[v] = -1;
+  for (int u = 0; u < n; u++)
+    for (int e = first[u]; e < first[u + 1]; e++)
+      if (next[head[e]] != u) {
+        next[head[e]] = u;
+        nb_edges++;
+      }
+  pgraph_s *pg = pgraph_create(n, nb_edges);
+  for (int v = 0; v < n; v++)
+    next[v] = -1;
+  for (int u = 0; u < n; u++) {
+    int k = pg->first[u];
+    for (int e = first[u]; e < first[u + 1]; e++)
+      if (next[head[e]] != u) {
+        next[head[e]] = u;
+        pg->head[k] = head[e];
+        pg->ewgt[k++] = 1;
+      }
+    pg->first[u + 1] = k;
+    pg->vwgt[u] = 1;
+  }
+  free(next);
+  free(head);
+  free(first);
+  return pg;
+}
+
+/**
+ * @brief Hashes an edge, the same way in both directions.
+ *
+ * Breaks the ties between the edges of equal weights in the matching.
+ */
+static inline unsigned int edge_hash(int u, int v) {
+  unsigned int x = (unsigned int)(u < v ? u : v) * 0x9E3779B1u ^ (unsigned int)(u < v ? v : u) * 0x85EBCA77u;
+  x ^= x >> 15;
+  x *= 0x2C1B3C6Du;
+  return x ^ (x >> 13);
+}
+
+/**
+ * @brief Structure holding the state of a coarsening step.
+ */
+typedef struct {
+  const pgraph_s *g;   /**< The graph to contract */
+  int max_vwgt;        /**< Largest weight of a coarse vertex */
+  int *match;          /**< Vertex matched with each vertex (-1 if not yet matched) */
+  int *proposal;       /**< Neighbour proposed by each vertex (-1 if none) */
+  int nb_matched;      /**< Number of vertices matched by the current round */
+  const int *cmap;     /**< Coarse vertex of each vertex */
+  const int *leader;   /**< Smallest vertex of each coarse vertex */
+  pgraph_s *coarse;    /**< The coarse graph, each vertex having room for its two sets of edges */
+  int *degree;         /**< Number of edges of each coarse vertex */
+  int **position;      /**< One array per worker: position of each coarse neighbour (-1 if absent) */
+} coarsen_s;
+
+/**
+ * @brief Lets the unmatched vertices [lo, hi) propose their heaviest unmatched neighbour.
+ */
+static void propose_body(int lo, int hi, void *arg) {
+  coarsen_s *c = arg;
+  const pgraph_s *g = c->g;
+  for (int u = lo; u < hi; u++) {
+    int best = -1, best_w = 0;
+    unsigned int best_h = 0;
+    if (c->match[u] == -1)
+      for (int e = g->first[u]; e < g->first[u + 1]; e++) {
+        int v = g->head[e];
+        if (c->match[v] != -1 || g->vwgt[u] + g->vwgt[v] > c->max_vwgt) continue;
+        unsigned int h = edge_hash(u, v);
+        if (g->ewgt[e] > best_w || (g->ewgt[e] == best_w && h > best_h)) {
+          best = v;
+          best_w = g->ewgt[e];
+          best_h = h;
+        }
+      }
+    c->proposal[u] = best;
+  }
+}
+
+/**
+ * @brief Matches the vertices [lo, hi) whose proposal is mutual.
+ */
+static void accept_body(int lo, int hi, void *arg) {
+  coarsen_s *c = arg;
+  int nb = 0;
+  for (int u = lo; u < hi; u++) {
+    int v = c->proposal[u];
+    if (v != -1 && c->proposal[v] == u) {
+      c->match[u] = v;
+      nb++;
+    }
+  }
+  __atomic_fetch_add(&c->nb_matched, nb, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Builds the edges of the coarse vertices [lo, hi).
+ *
+ * The edges of the two merged vertices are gathered, the edges between them are
+ * dropped and the edges towards the same coarse vertex are merged.
+ */
+static void contract_body(int lo, int hi, void *arg) {
+  coarsen_s *c = arg;
+  const pgraph_s *g = c->g;
+  pgraph_s *coarse = c->coarse;
+  int id = thread_pool_worker_id();
+  int *position = c->position[id < 0 ? 0 : id];
+  for (int cu = lo; cu < hi; cu++) {
+    int start = coarse->first[cu], k = start;
+    int members[2] = {c->leader[cu], c->match[c->leader[cu]]};
+    coarse->vwgt[cu] = g->vwgt[members[0]] + (members[1] != members[0] ? g->vwgt[members[1]] : 0);
+    for (int i = 0; i < (members[1] != members[0] ? 2 : 1); i++)
+      for (int e = g->first[members[i]]; e < g->first[members[i] + 1]; e++) {
+        int cv = c->cmap[g->head[e]];
+        if (cv == cu) continue;
+        if (position[cv] == -1) {
+          position[cv] = k;
+          coarse->head[k] = cv;
+          coarse->ewgt[k++] = g->ewgt[e];
+        } else {
+          coarse->ewgt[position[cv]] += g->ewgt[e];
+        }
+      }
+    for (int e = start; e < k; e++)
+      position[coarse->head[e]] = -1;
+    c->degree[cu] = k - start;
+  }
+}
+
+/**
+ * @brief Contracts a graph along a heavy-edge matching.
+ *
+ * @param g The graph.
+ * @param max_vwgt The largest weight of a coarse vertex.
+ * @param cmap Receives the coarse vertex of each vertex.
+ * @param pool The thread pool.
+ * @return Pointer to the coarse graph.
+ */
+static pgraph_s *coarsen(const pgraph_s *g, int max_vwgt, int *cmap, thread_pool_s *pool) {
+  int n = g->nb_vertices;
+  int grain = 1024;
+  coarsen_s c = {.g = g, .max_vwgt = max_vwgt, .cmap = cmap};
+  c.match = malloc((n + 1) * sizeof(int));
+  c.proposal = malloc((n + 1) * sizeof(int));
+  assert(c.match!=NULL && c.proposal!=NULL);
+  for (int u = 0; u < n; u++)
+    c.match[u] = -1;
+  // Locally dominant matching: the heaviest edges around are matched first
+  for (int round = 0; round < MATCHING_ROUNDS; round++) {
+    c.nb_matched = 0;
+    thread_pool_parallel_for(pool, 0, n, grain, propose_body, &c);
+    thread_pool_parallel_for(pool, 0, n, grain, accept_body, &c);
+    if (c.nb_matched <= n / 100) break;
+  }
+  // The coarse vertices are numbered in the order of their smallest vertex
+  int nc = 0;
+  int *leader = c.proposal;
+  for (int u = 0; u < n; u++) {
+    if (c.match[u] == -1) c.match[u] = u;
+    if (c.match[u] >= u) {
+      leader[nc] = u;
+      cmap[u] = nc++;
+    }
+  }
+  for (int u = 0; u < n; u++)
+    if (c.match[u] < u) cmap[u] = cmap[c.match[u]];
+  c.leader = leader;
+  int room = 0;
+  for (int cu = 0; cu < nc; cu++) {
+    int u = leader[cu], v = c.match[u];
+    room += g->first[u + 1] - g->first[u] + (v != u ? g->first[v + 1] - g->first[v] : 0);
+  }
+  c.coarse = pgraph_create(nc, room);
+  for (int cu = 0; cu < nc; cu++) {
+    int u = leader[cu], v = c.match[u];
+    c.coarse->first[cu + 1] = c.coarse->first[cu] + g->first[u + 1] - g->first[u] +
+                              (v != u ? g->first[v + 1] - g->first[v] : 0);
+  }
+  c.degree = malloc((nc + 1) * sizeof(int));
+  int nb_workers = thread_pool_size(pool);
+  c.position = malloc(nb_workers * sizeof(int *));
+  assert(c.degree!=NULL && c.position!=NULL);
+  for (int w = 0; w < nb_workers; w++) {
+    c.position[w] = malloc((nc + 1) * sizeof(int));
+    assert(c.position[w]!=NULL);
+    for (int cv = 0; cv < nc; cv++)
+      c.position[w][cv] = -1;
+  }
+  thread_pool_parallel_for(pool, 0, nc, grain, contract_body, &c);
+  // Compaction of the edges
+  int k = 0;
+  for (int cu = 0; cu < nc; cu++) {
+    int start = c.coarse->first[cu];
+    memmove(c.coarse->head + k, c.coarse->head + start, c.degree[cu] * sizeof(int));
+    memmove(c.coarse->ewgt + k, c.coarse->ewgt + start, c.degree[cu] * sizeof(int));
+    c.coarse->first[cu] = k;
+    k += c.degree[cu];
+  }
+  c.coarse->first[nc] = k;
+  for (int w = 0; w < nb_workers; w++)
+    free(c.position[w]);
+  free(c.position);
+  free(c.degree);
+  free(c.proposal);
+  free(c.match);
+  return c.coarse;
+}
+
+/**
+ * @brief Computes the total weight of the edges between two parts.
+ *
+ * @param g The graph.
+ * @param part The part of each vertex.
+ * @return The edge cut.
+ */
+static long long edge_cut(const pgraph_s *g, const int *part) {
+  long long cut = 0;
+  for (int u = 0; u < g->nb_vertices; u++)
+    for (int e = g->first[u]; e < g->first[u + 1]; e++)
+      if (part[g->head[e]] != part[u]) cut += g->ewgt[e];
+  return cut / 2;
+}
+
+/**
+ * @brief Structure holding the buffers of the initial partition.
+ */
+typedef struct {
+  const pgraph_s *g; /**< The coarsest graph */
+  int *part;         /**< Part of each vertex, or first part of its set during the bisections */
+  int *side;         /**< Side of each vertex in the current bisection */
+  int *best_side;    /**< Side of each vertex in the best bisection so far */
+  heap_s *q;         /**< Heap of the vertices next to the growing side, by decreasing gain */
+  int *conn;         /**< Weight of the edges of each vertex towards the growing side */
+  int *inner;        /**< Weight of the edges of each vertex inside its set */
+  unsigned int seed; /**< Seed of the random choices */
+} bisection_s;
+
+/**
+ * @brief Grows the side 0 of a set until it reaches a weight.
+ *
+ * The side grows greedily from a random seed: the next vertex is the neighbour
+ * whose move reduces the cut the most (the gain 2 conn - inner only increases as
+ * the side grows). A new seed is taken when the side has no more neighbours.
+ *
+ * @param b The buffers.
+ * @param set The vertices of the set.
+ * @param nb The number of vertices of the set.
+ * @param region The region of the set (the value of `part` of its vertices).
+ * @param target The weight of the side 0.
+ */
+static void grow(bisection_s *b, const int *set, int nb, int region, long long target) {
+  const pgraph_s *g = b->g;
+  for (int i = 0; i < nb; i++) {
+    b->side[set[i]] = 1;
+    b->conn[set[i]] = 0;
+  }
+  long long weight = 0;
+  int scan = rand_r(&b->seed) % nb;
+  for (int i = 0; i < nb && weight < target; i++, scan = (scan + 1) % nb) {
+    if (b->side[set[scan]] == 0) continue;
+    heap_add((vertex_s){set[scan], 0.0, -1}, b->q);
+    while (!heap_empty(b->q) && weight < target) {
+      int u = heap_peek(b->q).ind;
+      heap_remove(b->q);
+      b->side[u] = 0;
+      weight += g->vwgt[u];
+      for (int e = g->first[u]; e < g->first[u + 1]; e++) {
+        int v = g->head[e];
+        if (b->part[v] == region && b->side[v] == 1) {
+          b->conn[v] += g->ewgt[e];
+          heap_add((vertex_s){v, -(2.0 * b->conn[v] - b->inner[v]), -1}, b->q);
+        }
+      }
+    }
+  }
+  heap_clear(b->q);
+}
+
+/**
+ * @brief Splits a set of vertices into nb_parts parts by recursive bisection.
+ *
+ * @param b The buffers.
+ * @param set The vertices of the set (reordered).
+ * @param nb The number of vertices of the set.
+ * @param first_part The first part given to the set (the value of `part` of its vertices).
+ * @param nb_parts The number of parts of the set.
+ */
+static void bisect(bisection_s *b, int *set, int nb, int first_part, int nb_parts) {
+  const pgraph_s *g = b->g;
+  if (nb_parts == 1 || nb == 0) return;
+  int k0 = nb_parts / 2;
+  long long weight = 0;
+  for (int i = 0; i < nb; i++)
+    weight += g->vwgt[set[i]];
+  long long target = weight * k0 / nb_parts;
+  for (int i = 0; i < nb; i++) {
+    int u = set[i];
+    b->inner[u] = 0;
+    for (int e = g->first[u]; e < g->first[u + 1]; e++)
+      if (b->part[g->head[e]] == first_part) b->inner[u] += g->ewgt[e];
+  }
+  long long best_cut = LLONG_MAX;
+  for (int t = 0; t < BISECTION_TRIES; t++) {
+    grow(b, set, nb, first_part, target);
+    long long cut = 0;
+    for (int i = 0; i < nb; i++) {
+      int u = set[i];
+      for (int e = g->first[u]; e < g->first[u + 1]; e++)
+        if (b->part[g->head[e]] == first_part && b->side[g->head[e]] != b->side[u]) cut += g->ewgt[e];
+    }
+    if (cut < best_cut) {
+      best_cut = cut;
+      for (int i = 0; i < nb; i++)
+        b->best_side[set[i]] = b->side[set[i]];
+    }
+  }
+  // The side 0 goes first in the set, the side 1 becomes the region first_part + k0
+  int nb0 = 0;
+  for (int i = 0; i < nb; i++)
+    if (b->best_side[set[i]] == 0) {
+      int u = set[i];
+      set[i] = set[nb0];
+      set[nb0++] = u;
+    }
+  for (int i = nb0; i < nb; i++)
+    b->part[set[i]] = first_part + k0;
+  bisect(b, set, nb0, first_part, k0);
+  bisect(b, set + nb0, nb - nb0, first_part + k0, nb_parts - k0);
+}
+
+/**
+ * @brief Computes the initial partition of the coarsest graph.
+ *
+ * @param g The coarsest graph.
+ * @param nb_parts The number of parts.
+ * @param part Receives the part of each vertex.
+ */
+static void initial_partition(const pgraph_s *g, int nb_parts, int *part) {
+  int n = g->nb_vertices;
+  bisection_s b = {.g = g, .part = part, .seed = 1};
+  int *set = malloc((n + 1) * sizeof(int));
+  b.side = malloc((n + 1) * sizeof(int));
+  b.best_side = malloc((n + 1) * sizeof(int));
+  b.q = heap_create(n);
+  b.conn = malloc((n + 1) * sizeof(int));
+  b.inner = malloc((n + 1) * sizeof(int));
+  assert(set!=NULL && b.side!=NULL && b.best_side!=NULL && b.conn!=NULL && b.inner!=NULL);
+  for (int u = 0; u < n; u++) {
+    set[u] = u;
+    part[u] = 0;
+  }
+  bisect(&b, set, n, 0, nb_parts);
+  free(b.inner);
+  free(b.conn);
+  heap_delete(b.q);
+  free(b.best_side);
+  free(b.side);
+  free(set);
+}
+
+/**
+ * @brief Structure holding the state of the refinement of a level.
+ */
+typedef struct {
+  const pgraph_s *g; /**< The graph of the level */
+  int nb_parts;      /**< Number of parts */
+  int max_pwgt;      /**< Largest weight of a part */
+  int *part;         /**< Part of each vertex */
+  int *pwgt;         /**< Weight of each part */
+  bool upward;       /**< The current greedy pass only moves vertices to parts of higher index */
+  int nb_moved;      /**< Number of vertices moved by the current greedy pass */
+  int *key;          /**< Bound of the gain of each vertex of the heap (INT_MIN if not in the heap) */
+  int **conn;        /**< One array per worker: weight of the edges to each part (zero between uses) */
+  int **touched;     /**< One array per worker: parts of non-zero conn */
+} refine_s;
+
+/**
+ * @brief Finds the best move of a vertex.
+ *
+ * The vertex may move to a part of its neighbours that stays within the balance
+ * constraint. If `force` is set and there is no such part, the lightest part is
+ * tried.
+ *
+ * @param r The refinement state.
+ * @param u The vertex.
+ * @param force Accepts a part without neighbours of u.
+ * @param conn A zero array of nb_parts entries (zero again on return).
+ * @param touched An array of nb_parts entries.
+ * @param to Receives the target part (-1 if none).
+ * @return The decrease of the edge cut brought by the move (INT_MIN if none).
+ */
+static int best_move(const refine_s *r, int u, bool force, int *conn, int *touched, int *to) {
+  const pgraph_s *g = r->g;
+  int own = __atomic_load_n(&r->part[u], __ATOMIC_RELAXED);
+  int nb = 0;
+  for (int e = g->first[u]; e < g->first[u + 1]; e++) {
+    int p = __atomic_load_n(&r->part[g->head[e]], __ATOMIC_RELAXED);
+    if (conn[p] == 0) touched[nb++] = p;
+    conn[p] += g->ewgt[e];
+  }
+  int internal = conn[own];
+  int best = -1, best_gain = INT_MIN, best_pwgt = INT_MAX;
+  for (int i = 0; i < nb; i++) {
+    int p = touched[i];
+    int pw = __atomic_load_n(&r->pwgt[p], __ATOMIC_RELAXED);
+    if (p != own && pw + g->vwgt[u] <= r->max_pwgt) {
+      int gain = conn[p] - internal;
+      if (gain > best_gain || (gain == best_gain && pw < best_pwgt)) {
+        best = p;
+        best_gain = gain;
+        best_pwgt = pw;
+      }
+    }
+    conn[p] = 0;
+  }
+  if (best == -1 && force) {
+    for (int p = 0; p < r->nb_parts; p++)
+      if (p != own && r->pwgt[p] + g->vwgt[u] <= r->max_pwgt && r->pwgt[p] < best_pwgt) {
+        best = p;
+        best_pwgt = r->pwgt[p];
+      }
+    if (best != -1) best_gain = -internal;
+  }
+  *to = best;
+  return best_gain;
+}
+
+/**
+ * @brief Moves the boundary vertices [lo, hi) of positive gain (greedy pass).
+ *
+ * The vertices only move to parts of higher index (or only to parts of lower index),
+ * so that two neighbours never swap their parts in the same pass. The gains are
+ * computed on the parts seen at that time, which other workers may change.
+ */
+static void greedy_body(int lo, int hi, void *arg) {
+  refine_s *r = arg;
+  int id = thread_pool_worker_id();
+  int *conn = r->conn[id < 0 ? 0 : id], *touched = r->touched[id < 0 ? 0 : id];
+  int nb = 0;
+  for (int u = lo; u < hi; u++) {
+    int to, own = __atomic_load_n(&r->part[u], __ATOMIC_RELAXED);
+    int gain = best_move(r, u, false, conn, touched, &to);
+    if (to == -1 || gain <= 0 || (to > own) != r->upward) continue;
+    int w = r->g->vwgt[u];
+    if (__atomic_add_fetch(&r->pwgt[to], w, __ATOMIC_RELAXED) > r->max_pwgt) {
+      __atomic_sub_fetch(&r->pwgt[to], w, __ATOMIC_RELAXED);
+      continue;
+    }
+    __atomic_sub_fetch(&r->pwgt[own], w, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->part[u], to, __ATOMIC_RELAXED);
+    nb++;
+  }
+  __atomic_fetch_add(&r->nb_moved, nb, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Structure recording a move of the Fiduccia-Mattheyses pass.
+ */
+typedef struct {
+  int vertex; /**< The vertex moved */
+  int from;   /**< Its former part */
+} move_s;
+
+/**
+ * @brief Runs a k-way Fiduccia-Mattheyses pass.
+ *
+ * The boundary vertices wait in a heap by decreasing gain. The vertex of best gain
+ * moves even if its gain is negative, then is locked for the rest of the pass; the
+ * pass stops after a number of moves without improvement and undoes the moves made
+ * after the best partition.
+ *
+ * The keys are upper bounds of the gains: a move raises the gain of a neighbour by
+ * at most twice the weight of their edge, so the key is raised by this amount
+ * without scanning the edges of the neighbour; a vertex coming out of the heap
+ * with a lower gain than its key is put back with its exact gain.
+ *
+ * In the balancing mode, only the vertices of the parts heavier than the constraint
+ * move (to any part with room), until no part is too heavy.
+ *
+ * @param r The refinement state.
+ * @param q A heap of nb_vertices entries, empty.
+ * @param locked Locks of the vertices (all false, false again on return).
+ * @param log Buffer of nb_vertices moves.
+ * @param balance Runs in the balancing mode.
+ * @return The decrease of the edge cut.
+ */
+static long long fm_pass(refine_s *r, heap_s *q, bool *locked, move_s *log, bool balance) {
+  const pgraph_s *g = r->g;
+  int n = g->nb_vertices;
+  int *conn = r->conn[0], *touched = r->touched[0];
+  int *key = r->key;
+  int patience = n / 100 > 100 ? n / 100 : 100;
+  for (int u = 0; u < n; u++) {
+    key[u] = INT_MIN;
+    if (balance && r->pwgt[r->part[u]] <= r->max_pwgt) continue;
+    int to, gain = best_move(r, u, balance, conn, touched, &to);
+    if (to != -1) heap_add((vertex_s){u, -(double)(key[u] = gain), -1}, q);
+  }
+  long long delta = 0, best_delta = 0;
+  int nb_moves = 0, best_moves = 0;
+  while (!heap_empty(q)) {
+    vertex_s top = heap_peek(q);
+    heap_remove(q);
+    int u = top.ind, from = r->part[u];
+    key[u] = INT_MIN;
+    if (locked[u] || (balance && r->pwgt[from] <= r->max_pwgt)) continue;
+    int to, gain = best_move(r, u, balance, conn, touched, &to);
+    if (to == -1) continue;
+    if (gain < -top.weight) {
+      heap_add((vertex_s){u, -(double)(key[u] = gain), -1}, q);
+      continue;
+    }
+    r->part[u] = to;
+    r->pwgt[from] -= g->vwgt[u];
+    r->pwgt[to] += g->vwgt[u];
+    locked[u] = true;
+    log[nb_moves++] = (move_s){u, from};
+    delta += gain;
+    if (balance || delta > best_delta) {
+      best_delta = delta;
+      best_moves = nb_moves;
+    } else if (nb_moves - best_moves > patience) {
+      break;
+    }
+    for (int e = g->first[u]; e < g->first[u + 1]; e++) {
+      int v = g->head[e], pv = r->part[v];
+      if (locked[v] || (balance && r->pwgt[pv] <= r->max_pwgt)) continue;
+      if (key[v] == INT_MIN) {
+        int v_to, v_gain = best_move(r, v, balance, conn, touched, &v_to);
+        if (v_to != -1) heap_add((vertex_s){v, -(double)(key[v] = v_gain), -1}, q);
+      } else if (pv != to) {
+        key[v] += (pv == from) ? 2 * g->ewgt[e] : g->ewgt[e];
+        heap_add((vertex_s){v, -(double)key[v], -1}, q);
+      }
+    }
+  }
+  for (int i = 0; i < nb_moves; i++)
+    locked[log[i].vertex] = false;
+  while (nb_moves > best_moves) {
+    move_s m = log[--nb_moves];
+    r->pwgt[r->part[m.vertex]] -= g->vwgt[m.vertex];
+    r->pwgt[m.from] += g->vwgt[m.vertex];
+    r->part[m.vertex] = m.from;
+  }
+  heap_clear(q);
+  return best_delta;
+}
+
+/**
+ * @brief Refines the partition of a level.
+ *
+ * @param r The refinement state (part and pwgt set for the level).
+ * @param pool The thread pool.
+ */
+static void refine(refine_s *r, thread_pool_s *pool) {
+  int n = r->g->nb_vertices;
+  heap_s *q = heap_create(n);
+  bool *locked = calloc(n + 1, sizeof(bool));
+  move_s *log = malloc((n + 1) * sizeof(move_s));
+  r->key = malloc((n + 1) * sizeof(int));
+  assert(locked!=NULL && log!=NULL && r->key!=NULL);
+  bool heavy = false;
+  for (int p = 0; p < r->nb_parts; p++)
+    heavy = heavy || r->pwgt[p] > r->max_pwgt;
+  if (heavy) fm_pass(r, q, locked, log, true);
+  int idle = 0;
+  for (int pass = 0; pass < GREEDY_PASSES && idle < 2; pass++) {
+    r->upward = (pass % 2 == 0);
+    r->nb_moved = 0;
+    thread_pool_parallel_for(pool, 0, n, 1024, greedy_body, r);
+    idle = (r->nb_moved <= n / 1000) ? idle + 1 : 0;
+  }
+  for (int pass = 0; pass < FM_PASSES; pass++)
+    if (fm_pass(r, q, locked, log, false) == 0) break;
+  free(r->key);
+  free(log);
+  free(locked);
+  heap_delete(q);
+}
+
+/**
+ * @brief Computes the statistics of a partition on the underlying simple graph.
+ *
+ * @param p The partition (nb_parts and part set).
+ * @param g The underlying simple graph.
+ */
+static void partition_stats(partition_s *p, const pgraph_s *g) {
+  p->part_size = calloc(p->nb_parts, sizeof(int));
+  assert(p->part_size!=NULL);
+  p->nb_boundary = 0;
+  for (int u = 0; u < g->nb_vertices; u++) {
+    p->part_size[p->part[u]]++;
+    for (int e = g->first[u]; e < g->first[u + 1]; e++)
+      if (p->part[g->head[e]] != p->part[u]) {
+        p->nb_boundary++;
+        break;
+      }
+  }
+  p->nb_edges = g->first[g->nb_vertices] / 2;
+  p->edge_cut = edge_cut(g, p->part);
+}
+
+/**
+ * @brief Partitions the vertices of a graph into parts of nearly equal sizes.
+ *
+ * @param g The graph.
+ * @param nb_parts The number of parts (1 to the number of vertices).
+ * @param imbalance The tolerated imbalance: each part has at most
+ *        (1 + imbalance) nb_vertices / nb_parts vertices (rounded up).
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the partition.
+ */
+partition_s *partition_create(graph_s *g, int nb_parts, double imbalance, thread_pool_s *pool) {
+  assert(g!=NULL && nb_parts >= 1 && nb_parts <= g->nb_vertices && imbalance >= 0.0);
+  int n = g->nb_vertices;
+  pgraph_s *levels[MAX_LEVELS];
+  int *cmap[MAX_LEVELS];
+  int nb_levels = 1;
+  levels[0] = pgraph_from_graph(g);
+  // Coarsening, until the graph is small or hardly shrinks
+  int coarsest = PARTITION_COARSEST_PER_PART * nb_parts > 200 ? PARTITION_COARSEST_PER_PART * nb_parts : 200;
+  int max_vwgt = (int)(1.5 * n / coarsest) > 1 ? (int)(1.5 * n / coarsest) : 1;
+  while (nb_parts > 1 && nb_levels < MAX_LEVELS && levels[nb_levels - 1]->nb_vertices > coarsest) {
+    const pgraph_s *fine = levels[nb_levels - 1];
+    cmap[nb_levels - 1] = malloc((fine->nb_vertices + 1) * sizeof(int));
+    assert(cmap[nb_levels - 1]!=NULL);
+    pgraph_s *coarse = coarsen(fine, max_vwgt, cmap[nb_levels - 1], pool);
+    if (coarse->nb_vertices > 0.95 * fine->nb_vertices) {
+      pgraph_delete(coarse);
+      free(cmap[nb_levels - 1]);
+      break;
+    }
+    levels[nb_levels++] = coarse;
+  }
+  // Initial partition and uncoarsening
+  refine_s r = {.nb_parts = nb_parts};
+  r.max_pwgt = (int)((1.0 + imbalance) * n / nb_parts);
+  if ((double)r.max_pwgt * nb_parts < (1.0 + imbalance) * n) r.max_pwgt++;
+  r.pwgt = calloc(nb_parts, sizeof(int));
+  int nb_workers = thread_pool_size(pool);
+  r.conn = malloc(nb_workers * sizeof(int *));
+  r.touched = malloc(nb_workers * sizeof(int *));
+  assert(r.pwgt!=NULL && r.conn!=NULL && r.touched!=NULL);
+  for (int w = 0; w < nb_workers; w++) {
+    r.conn[w] = calloc(nb_parts, sizeof(int));
+    r.touched[w] = malloc(nb_parts * sizeof(int));
+    assert(r.conn[w]!=NULL && r.touched[w]!=NULL);
+  }
+  int *part = malloc((levels[nb_levels - 1]->nb_vertices + 1) * sizeof(int));
+  assert(part!=NULL);
+  initial_partition(levels[nb_levels - 1], nb_parts, part);
+  for (int l = nb_levels - 1; l >= 0; l--) {
+    r.g = levels[l];
+    r.part = part;
+    memset(r.pwgt, 0, nb_parts * sizeof(int));
+    for (int u = 0; u < r.g->nb_vertices; u++)
+      r.pwgt[part[u]] += r.g->vwgt[u];
+    refine(&r, pool);
+    if (l > 0) {
+      int *fine_part = malloc((levels[l - 1]->nb_vertices + 1) * sizeof(int));
+      assert(fine_part!=NULL);
+      for (int u = 0; u < levels[l - 1]->nb_vertices; u++)
+        fine_part[u] = part[cmap[l - 1][u]];
+      free(part);
+      free(cmap[l - 1]);
+      pgraph_delete(levels[l]);
+      part = fine_part;
+    }
+  }
+  for (int w = 0; w < nb_workers; w++) {
+    free(r.conn[w]);
+    free(r.touched[w]);
+  }
+  free(r.touched);
+  free(r.conn);
+  free(r.pwgt);
+  partition_s *p = malloc(sizeof(partition_s));
+  assert(p!=NULL);
+  p->nb_vertices = n;
+  p->nb_parts = nb_parts;
+  p->part = part;
+  p->nb_levels = nb_levels;
+  partition_stats(p, levels[0]);
+  pgraph_delete(levels[0]);
+  return p;
+}
+
+/**
+ * @brief Computes the edge cut and the part sizes of a partition vector.
+ *
+ * @param g The graph.
+ * @param nb_parts The number of parts.
+ * @param part The part of each vertex (copied).
+ * @return Pointer to the partition (nb_levels is 0).
+ */
+partition_s *partition_from_vector(graph_s *g, int nb_parts, const int *part) {
+  assert(g!=NULL && nb_parts >= 1 && part!=NULL);
+  partition_s *p = malloc(sizeof(partition_s));
+  assert(p!=NULL);
+  p->nb_vertices = g->nb_vertices;
+  p->nb_parts = nb_parts;
+  p->part = malloc((g->nb_vertices + 1) * sizeof(int));
+  assert(p->part!=NULL);
+  memcpy(p->part, part, g->nb_vertices * sizeof(int));
+  p->nb_levels = 0;
+  pgraph_s *pg = pgraph_from_graph(g);
+  partition_stats(p, pg);
+  pgraph_delete(pg);
+  return p;
+}
+
+/**
+ * @brief Gets the largest part size relative to the average one.
+ *
+ * @param p The partition.
+ * @return The ratio (1.0 for a perfectly balanced partition).
+ */
+double partition_imbalance(const partition_s *p) {
+  assert(p!=NULL);
+  int largest = 0;
+  for (int i = 0; i < p->nb_parts; i++)
+    if (p->part_size[i] > largest) largest = p->part_size[i];
+  return (double)largest * p->nb_parts / p->nb_vertices;
+}
+
+/**
+ * @brief Numbers the vertices part by part.
+ *
+ * @param p The partition.
+ * @return The new index of each vertex (nb_vertices entries, to free).
+ */
+int *partition_permutation(const partition_s *p) {
+  assert(p!=NULL);
+  int *next = malloc((p->nb_parts + 1) * sizeof(int));
+  int *index = malloc((p->nb_vertices + 1) * sizeof(int));
+  assert(next!=NULL && index!=NULL);
+  next[0] = 0;
+  for (int i = 0; i < p->nb_parts; i++)
+    next[i + 1] = next[i] + p->part_size[i];
+  for (int v = 0; v < p->nb_vertices; v++)
+    index[v] = next[p->part[v]]++;
+  free(next);
+  return index;
+}
+
+/**
+ * @brief Writes the partition vector, one part per line (the format of METIS).
+ *
+ * @param p The partition.
+ * @param filename The file to write.
+ * @return false if the file cannot be written.
+ */
+bool partition_save(const partition_s *p, const char *filename) {
+  assert(p!=NULL && filename!=NULL);
+  FILE *f = fopen(filename, "w");
+  if (f == NULL) return false;
+  for (int v = 0; v < p->nb_vertices; v++)
+    fprintf(f, "%d\n", p->part[v]);
+  return fclose(f) == 0;
+}
+
+/**
+ * @brief Deletes a partition.
+ *
+ * @param p The partition.
+ */
+void partition_delete(partition_s *p) {
+  if (p == NULL) return;
+  free(p->part);
+  free(p->part_size);
+  free(p);
+}
@@ -0,0 +1,315 @@
+/**
+ * @file phast.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief PHAST one-to-all shortest path distances on a vertex hierarchy.
+ *
+ * The preprocessing contracts the vertices in the order given by a heap keyed by
+ * the edge difference (number of shortcuts needed minus number of edges removed)
+ * plus the number of already contracted neighbours, updated lazily. Contracting a
+ * vertex v adds a shortcut u → w for every pair of edges u → v → w unless a witness
+ * search, a bounded Dijkstra from u avoiding v, finds a path at most as short.
+ * Each vertex gets the rank of its contraction; the edges of the graph augmented
+ * with the shortcuts are then split into upward and downward edges and stored in
+ * arrays indexed by position.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <assert.h>
+#include "phast.h"
+#include "heap.h"
+
+#define WITNESS_SETTLE_LIMIT 500 // Maximum number of vertices settled by a witness search
+
+/**
+ * @brief Structure representing a growable array of edges.
+ */
+typedef struct {
+  int *nbr;        /**< Neighbour at the other end of each edge */
+  double *weight;  /**< Weight of each edge */
+  int nb;          /**< Number of edges */
+  int capacity;    /**< Number of edges that fit in the arrays */
+} arcs_s;
+
+/**
+ * @brief Structure of the state of the contraction.
+ */
+typedef struct {
+  int nb_vertices;          /**< Number of vertices */
+  arcs_s *out;              /**< Outgoing edges (original and shortcuts) */
+  arcs_s *in;               /**< Incoming edges (original and shortcuts) */
+  bool *contracted;         /**< Contracted vertices */
+  int *contracted_nbrs;     /**< Number of contracted neighbours of each vertex */
+  workspace_s *ws;          /**< Workspace of the witness searches */
+  int nb_shortcuts;         /**< Number of shortcuts added */
+} contraction_s;
+
+/**
+ * @brief Adds an edge, or lowers the weight of the edge to the same neighbour.
+ *
+ * @return true if a new edge was added.
+ */
+static bool arcs_add(arcs_s *a, int nbr, double weight) {
+  for (int i = 0; i < a->nb; i++)
+    if (a->nbr[i] == nbr) {
+      if (weight < a->weight[i]) a->weight[i] = weight;
+      return false;
+    }
+  if (a->nb == a->capacity) {
+    a->capacity = 2 * a->capacity + 4;
+    a->nbr = realloc(a->nbr, a->capacity*sizeof(int));
+    a->weight = realloc(a->weight, a->capacity*sizeof(double));
+    assert(a->nbr!=NULL && a->weight!=NULL);
+  }
+  a->nbr[a->nb] = nbr;
+  a->weight[a->nb] = weight;
+  a->nb++;
+  return true;
+}
+
+/**
+ * @brief Bounded Dijkstra from u in the remaining graph, avoiding the vertex avoid.
+ */
+static void witness_search(contraction_s *c, int u, int avoid, double bound) {
+  workspace_s *ws = c->ws;
+  workspace_reset(ws);
+  workspace_push(ws, u, 0.0, -1);
+  vertex_s v;
+  while (workspace_next_weight(ws) <= bound && ws->nb_settled < WITNESS_SETTLE_LIMIT) {
+    workspace_pop(ws, &v);
+    arcs_s *a = &c->out[v.ind];
+    for (int i = 0; i < a->nb; i++) {
+      int x = a->nbr[i];
+      if (x != avoid && !c->contracted[x])
+        workspace_push(ws, x, v.weight + a->weight[i], v.ind);
+    }
+  }
+}
+
+/**
+ * @brief Contracts a vertex, or only counts the shortcuts its contraction needs.
+ *
+ * @return The number of shortcuts needed.
+ */
+static int contract(contraction_s *c, int v, bool simulate) {
+  int count = 0;
+  arcs_s *in = &c->in[v], *out = &c->out[v];
+  for (int i = 0; i < in->nb; i++) {
+    int u = in->nbr[i];
+    if (u == v || c->contracted[u]) continue;
+    double bound = -1.0;
+    for (int j = 0; j < out->nb; j++) {
+      int w = out->nbr[j];
+      if (w != u && w != v && !c->contracted[w] && in->weight[i] + out->weight[j] > bound)
+        bound = in->weight[i] + out->weight[j];
+    }
+    if (bound < 0.0) continue;
+    witness_search(c, u, v, bound);
+    for (int j = 0; j < out->nb; j++) {
+      int w = out->nbr[j];
+      if (w == u || w == v || c->contracted[w]) continue;
+      double needed = in->weight[i] + out->weight[j];
+      if (workspace_dist(c->ws, w) <= needed) continue; // a witness path exists
+      count++;
+      if (!simulate) {
+        if (arcs_add(&c->out[u], w, needed)) c->nb_shortcuts++;
+        arcs_add(&c->in[w], u, needed);
+      }
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Computes the contraction priority of a vertex (smaller is contracted first).
+ */
+static double priority(contraction_s *c, int v) {
+  int removed = 0;
+  for (int i = 0; i < c->in[v].nb; i++)
+    if (!c->contracted[c->in[v].nbr[i]]) removed++;
+  for (int i = 0; i < c->out[v].nb; i++)
+    if (!c->contracted[c->out[v].nbr[i]]) removed++;
+  return contract(c, v, true) - removed + c->contracted_nbrs[v];
+}
+
+/**
+ * @brief Ranks the vertices of a graph and builds its hierarchy.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @return Pointer to the created hierarchy.
+ */
+phast_s *phast_create(graph_s *g) {
+  assert(g!=NULL);
+  int n = g->nb_vertices;
+  contraction_s c = {.nb_vertices = n, .nb_shortcuts = 0};
+  c.out = calloc(n, sizeof(arcs_s));
+  c.in = calloc(n, sizeof(arcs_s));
+  c.contracted = calloc(n, sizeof(bool));
+  c.contracted_nbrs = calloc(n, sizeof(int));
+  assert(c.out!=NULL && c.in!=NULL && c.contracted!=NULL && c.contracted_nbrs!=NULL);
+  c.ws = workspace_create(n);
+  for (int u = 0; u < n; u++)
+    for (adj_list_s *adj = get_adj_list(g, u); adj != NULL; adj = adj->next)
+      if (adj->vertex.ind != u) {
+        arcs_add(&c.out[u], adj->vertex.ind, adj->vertex.weight);
+        arcs_add(&c.in[adj->vertex.ind], u, adj->vertex.weight);
+      }
+  // Contraction order, the priorities are updated lazily when a vertex is popped
+  int *rank = malloc(n*sizeof(int));
+  assert(rank!=NULL);
+  heap_s *q = heap_create(n);
+  for (int v = 0; v < n; v++) {
+    vertex_s tmp = {.ind = v, .weight = priority(&c, v), .prev = -1};
+    q = heap_add(tmp, q);
+  }
+  int next_rank = 0;
+  while (!heap_empty(q)) {
+    vertex_s v = heap_peek(q);
+    q = heap_remove(q);
+    double p = priority(&c, v.ind);
+    if (!heap_empty(q) && p > heap_peek(q).weight) {
+      v.weight = p;
+      q = heap_add(v, q);
+      continue;
+    }
+    contract(&c, v.ind, false);
+    c.contracted[v.ind] = true;
+    rank[v.ind] = next_rank++;
+    for (int i = 0; i < c.in[v.ind].nb; i++) c.contracted_nbrs[c.in[v.ind].nbr[i]]++;
+    for (int i = 0; i < c.out[v.ind].nb; i++) c.contracted_nbrs[c.out[v.ind].nbr[i]]++;
+  }
+  heap_delete(q);
+  // Layout by decreasing rank
+  phast_s *ph = malloc(sizeof(phast_s));
+  assert(ph!=NULL);
+  ph->nb_vertices = n;
+  ph->nb_shortcuts = c.nb_shortcuts;
+  ph->position = malloc(n*sizeof(int));
+  ph->vertex = malloc(n*sizeof(int));
+  ph->up_first = calloc(n+1, sizeof(int));
+  ph->down_first = calloc(n+1, sizeof(int));
+  assert(ph->position!=NULL && ph->vertex!=NULL && ph->up_first!=NULL && ph->down_first!=NULL);
+  for (int v = 0; v < n; v++) {
+    ph->position[v] = n - 1 - rank[v];
+    ph->vertex[ph->position[v]] = v;
+  }
+  for (int u = 0; u < n; u++)
+    for (int i = 0; i < c.out[u].nb; i++) {
+      int w = c.out[u].nbr[i];
+      if (rank[w] > rank[u]) ph->up_first[ph->position[u]+1]++;
+      else ph->down_first[ph->position[w]+1]++;
+    }
+  for (int i = 0; i < n; i++) {
+    ph->up_first[i+1] += ph->up_first[i];
+    ph->down_first[i+1] += ph->down_first[i];
+  }
+  ph->up_head = malloc((ph->up_first[n] + 1)*sizeof(int));
+  ph->up_weight = malloc((ph->up_first[n] + 1)*sizeof(double));
+  ph->down_tail = malloc((ph->down_first[n] + 1)*sizeof(int));
+  ph->down_weight = malloc((ph->down_first[n] + 1)*sizeof(double));
+  assert(ph->up_head!=NULL && ph->up_weight!=NULL && ph->down_tail!=NULL && ph->down_weight!=NULL);
+  int *up_next = malloc(n*sizeof(int));
+  int *down_next = malloc(n*sizeof(int));
+  assert(up_next!=NULL && down_next!=NULL);
+  for (int i = 0; i < n; i++) {
+    up_next[i] = ph->up_first[i];
+    down_next[i] = ph->down_first[i];
+  }
+  for (int u = 0; u < n; u++)
+    for (int i = 0; i < c.out[u].nb; i++) {
+      int w = c.out[u].nbr[i];
+      if (rank[w] > rank[u]) {
+        int e = up_next[ph->position[u]]++;
+        ph->up_head[e] = ph->position[w];
+        ph->up_weight[e] = c.out[u].weight[i];
+      } else {
+        int e = down_next[ph->position[w]]++;
+        ph->down_tail[e] = ph->position[u];
+        ph->down_weight[e] = c.out[u].weight[i];
+      }
+    }
+  // Clean up
+  free(up_next);
+  free(down_next);
+  free(rank);
+  for (int v = 0; v < n; v++) {
+    free(c.out[v].nbr); free(c.out[v].weight);
+    free(c.in[v].nbr); free(c.in[v].weight);
+  }
+  free(c.out);
+  free(c.in);
+  free(c.contracted);
+  free(c.contracted_nbrs);
+  workspace_delete(c.ws);
+  return ph;
+}
+
+/**
+ * @brief Computes the distances from a source to all the vertices.
+ *
+ * @param ph The hierarchy.
+ * @param src The source vertex.
+ * @param ws A workspace created for `ph->nb_vertices` vertices.
+ * @param dist Array of `ph->nb_vertices` distances, filled by position.
+ */
+void phast_query(const phast_s *ph, int src, workspace_s *ws, double *dist) {
+  assert(ph!=NULL && ws!=NULL && dist!=NULL && ws->nb_vertices >= ph->nb_vertices);
+  assert(src >= 0 && src < ph->nb_vertices);
+  int n = ph->nb_vertices;
+  // Upward search from the source
+  workspace_reset(ws);
+  workspace_push(ws, ph->position[src], 0.0, -1);
+  vertex_s v;
+  while (workspace_pop(ws, &v))
+    for (int e = ph->up_first[v.ind]; e < ph->up_first[v.ind+1]; e++)
+      workspace_push(ws, ph->up_head[e], v.weight + ph->up_weight[e], v.ind);
+  for (int i = 0; i < n; i++)
+    dist[i] = workspace_dist(ws, i);
+  // Linear top-down sweep by decreasing rank
+  const int *restrict down_first = ph->down_first;
+  const int *restrict down_tail = ph->down_tail;
+  const double *restrict down_weight = ph->down_weight;
+  for (int i = 0; i < n; i++) {
+    double d = dist[i];
+    for (int e = down_first[i]; e < down_first[i+1]; e++) {
+      double nd = dist[down_tail[e]] + down_weight[e];
+      d = (nd < d) ? nd : d;
+    }
+    dist[i] = d;
+  }
+}
+
+/**
+ * @brief Deletes a hierarchy and frees its memory.
+ *
+ * @param ph Pointer to the hierarchy.
+ */
+void phast_delete(phast_s *ph) {
+  if (!ph) return;
+  free(ph->position);
+  free(ph->vertex);
+  free(ph->up_first);
+  free(ph->up_head);
+  free(ph->up_weight);
+  free(ph->down_first);
+  free(ph->down_tail);
+  free(ph->down_weight);
+  free(ph);
+}
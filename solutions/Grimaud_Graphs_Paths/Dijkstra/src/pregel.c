@@ -0,0 +1,348 @@
+/**
+ * @file pregel.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Vertex-centric bulk-synchronous graph engine (Pregel model).
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include <assert.h>
+#include "pregel.h"
+#include "bitset.h"
+
+/** @brief Number of 64-vertex words of the bitsets per task of a superstep. */
+#define PREGEL_GRAIN 16
+/** @brief Distance between the message counters of two workers (one cache line). */
+#define COUNTER_STRIDE 8
+
+/**
+ * @brief Structure of a running engine.
+ */
+struct pregel_context {
+  graph_s *g;                  /**< The graph */
+  combiner_e combiner;         /**< The combiner of the messages */
+  double identity;             /**< The identity of the combiner (the empty message) */
+  pregel_compute_f compute;    /**< The compute function */
+  void *arg;                   /**< The argument of the compute function */
+  double *values;              /**< The value of each vertex */
+  int *out_degree;             /**< The out-degree of each vertex */
+  int superstep;               /**< The current superstep */
+  double *inbox;               /**< Combined message of each vertex for the current superstep */
+  double *next_inbox;          /**< Combined message of each vertex for the next superstep */
+  bitset_s *active;            /**< Vertices that have not voted to halt */
+  bitset_s *has_message;       /**< Vertices having a message in the current superstep */
+  bitset_s *next_has_message;  /**< Vertices having a message for the next superstep */
+  double aggregated;           /**< Sum aggregated during the previous superstep */
+  double next_aggregated;      /**< Sum aggregated during the current superstep */
+  long long *nb_sent;          /**< Number of messages sent by each worker (every COUNTER_STRIDE entries) */
+  long long nb_computes;       /**< Number of calls of the compute function */
+};
+
+/**
+ * @brief Gets the graph of a running engine.
+ *
+ * @param ctx The engine.
+ * @return The graph.
+ */
+graph_s *pregel_graph(const pregel_context_s *ctx) {
+  return ctx->g;
+}
+
+/**
+ * @brief Gets the index of the current superstep (0 for the first one).
+ *
+ * @param ctx The engine.
+ * @return The superstep.
+ */
+int pregel_superstep(const pregel_context_s *ctx) {
+  return ctx->superstep;
+}
+
+/**
+ * @brief Gets the number of edges leaving a vertex.
+ *
+ * @param ctx The engine.
+ * @param v The vertex.
+ * @return The out-degree of the vertex.
+ */
+int pregel_out_degree(const pregel_context_s *ctx, int v) {
+  return ctx->out_degree[v];
+}
+
+/**
+ * @brief Sends a message, received in the next superstep.
+ *
+ * The message is combined with the messages already sent to the vertex by a
+ * compare-and-swap loop.
+ *
+ * @param ctx The engine.
+ * @param dst The vertex receiving the message.
+ * @param message The message.
+ */
+void pregel_send(pregel_context_s *ctx, int dst, double message) {
+  double *slot = &ctx->next_inbox[dst];
+  double old, combined;
+  __atomic_load(slot, &old, __ATOMIC_RELAXED);
+  do {
+    if (ctx->combiner == COMBINE_MIN) {
+      if (old <= message) break;
+      combined = message;
+    } else {
+      combined = old + message;
+    }
+  } while (!__atomic_compare_exchange(slot, &old, &combined, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  if (!bitset_test_atomic(ctx->next_has_message, dst)) bitset_set_atomic(ctx->next_has_message, dst);
+  int id = thread_pool_worker_id();
+  ctx->nb_sent[(id < 0 ? 0 : id) * COUNTER_STRIDE]++;
+}
+
+/**
+ * @brief Deactivates a vertex until it receives a message.
+ *
+ * @param ctx The engine.
+ * @param v The vertex (the one being computed).
+ */
+void pregel_vote_to_halt(pregel_context_s *ctx, int v) {
+  bitset_clear(ctx->active, v);
+}
+
+/**
+ * @brief Adds a value to the aggregator of the current superstep.
+ *
+ * @param ctx The engine.
+ * @param x The value.
+ */
+void pregel_aggregate(pregel_context_s *ctx, double x) {
+  double old, sum;
+  __atomic_load(&ctx->next_aggregated, &old, __ATOMIC_RELAXED);
+  do {
+    sum = old + x;
+  } while (!__atomic_compare_exchange(&ctx->next_aggregated, &old, &sum, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Gets the sum aggregated during the previous superstep.
+ *
+ * @param ctx The engine.
+ * @return The sum (0 in the first superstep).
+ */
+double pregel_aggregated(const pregel_context_s *ctx) {
+  return ctx->aggregated;
+}
+
+/**
+ * @brief Computes the vertices of the words [lo, hi) of the bitsets.
+ *
+ * A vertex is computed if it is active or has a message; it is active again after
+ * the call unless it votes to halt. The words belong to the task, so the active
+ * bits and the message slots of its vertices are updated without atomics.
+ */
+static void superstep_body(int lo, int hi, void *arg) {
+  pregel_context_s *ctx = arg;
+  long long nb_computes = 0;
+  for (int w = lo; w < hi; w++) {
+    uint64_t bits = ctx->active->words[w] | ctx->has_message->words[w];
+    ctx->active->words[w] = bits;
+    while (bits != 0) {
+      int v = w * 64 + __builtin_ctzll(bits);
+      bits &= bits - 1;
+      bool has_message = bitset_test(ctx->has_message, v);
+      double message = has_message ? ctx->inbox[v] : ctx->identity;
+      ctx->inbox[v] = ctx->identity;
+      ctx->compute(ctx, v, &ctx->values[v], message, has_message, ctx->arg);
+      nb_computes++;
+    }
+    ctx->has_message->words[w] = 0;
+  }
+  __atomic_fetch_add(&ctx->nb_computes, nb_computes, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Runs a vertex program.
+ *
+ * @param g The graph.
+ * @param combiner The combiner of the messages.
+ * @param compute The compute function.
+ * @param arg The argument given to the compute function.
+ * @param values The value of each vertex, initialized by the caller (nb_vertices entries).
+ * @param max_supersteps The maximum number of supersteps.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_run(graph_s *g, combiner_e combiner, pregel_compute_f compute, void *arg, double *values,
+                int max_supersteps, thread_pool_s *pool, pregel_stats_s *stats) {
+  assert(g!=NULL && compute!=NULL && values!=NULL && max_supersteps >= 0);
+  int n = g->nb_vertices;
+  pregel_context_s ctx = {.g = g, .combiner = combiner, .compute = compute, .arg = arg, .values = values};
+  ctx.identity = (combiner == COMBINE_MIN) ? INFINITY : 0.0;
+  ctx.out_degree = calloc(n + 1, sizeof(int));
+  ctx.inbox = malloc((n + 1) * sizeof(double));
+  ctx.next_inbox = malloc((n + 1) * sizeof(double));
+  int nb_workers = thread_pool_size(pool);
+  ctx.nb_sent = calloc(nb_workers * COUNTER_STRIDE, sizeof(long long));
+  assert(ctx.out_degree!=NULL && ctx.inbox!=NULL && ctx.next_inbox!=NULL && ctx.nb_sent!=NULL);
+  for (int v = 0; v < n; v++) {
+    GRAPH_LIST_FOREACH_EDGE(g, v, u, w, (void)u; (void)w; ctx.out_degree[v]++;)
+    ctx.inbox[v] = ctx.next_inbox[v] = ctx.identity;
+  }
+  ctx.active = bitset_create(n);
+  ctx.has_message = bitset_create(n);
+  ctx.next_has_message = bitset_create(n);
+  for (int v = 0; v < n; v++)
+    bitset_set(ctx.active, v);
+  int nb_words = ctx.active->nb_words;
+  bool running = (n > 0);
+  for (ctx.superstep = 0; running && ctx.superstep < max_supersteps; ctx.superstep++) {
+    thread_pool_parallel_for(pool, 0, nb_words, PREGEL_GRAIN, superstep_body, &ctx);
+    // The messages sent become the messages of the next superstep
+    double *inbox = ctx.inbox;
+    ctx.inbox = ctx.next_inbox;
+    ctx.next_inbox = inbox;
+    bitset_s *has_message = ctx.has_message;
+    ctx.has_message = ctx.next_has_message;
+    ctx.next_has_message = has_message;
+    ctx.aggregated = ctx.next_aggregated;
+    ctx.next_aggregated = 0.0;
+    running = false;
+    for (int w = 0; w < nb_words && !running; w++)
+      running = (ctx.active->words[w] | ctx.has_message->words[w]) != 0;
+  }
+  long long nb_messages = 0;
+  for (int i = 0; i < nb_workers; i++)
+    nb_messages += ctx.nb_sent[i * COUNTER_STRIDE];
+  if (stats != NULL) *stats = (pregel_stats_s){ctx.superstep, nb_messages, ctx.nb_computes};
+  bitset_delete(ctx.next_has_message);
+  bitset_delete(ctx.has_message);
+  bitset_delete(ctx.active);
+  free(ctx.next_inbox);
+  free(ctx.inbox);
+  free(ctx.out_degree);
+  free(ctx.nb_sent);
+}
+
+/**
+ * @brief Vertex program of the shortest paths: a vertex improved by its messages
+ * offers the new distance to its neighbours.
+ */
+static void sssp_compute(pregel_context_s *ctx, int v, double *dist, double message, bool has_message, void *arg) {
+  (void)has_message;
+  double d = (pregel_superstep(ctx) == 0 && v == *(int *)arg) ? 0.0 : message;
+  if (d < *dist) {
+    *dist = d;
+    GRAPH_LIST_FOREACH_EDGE(pregel_graph(ctx), v, u, w, pregel_send(ctx, u, d + w);)
+  }
+  pregel_vote_to_halt(ctx, v);
+}
+
+/**
+ * @brief Computes the shortest path distances from a source (vertex program).
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param dist Receives the distance of each vertex (INFINITY if unreachable).
+ * @param pool The thread pool.
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_sssp(graph_s *g, int src, double *dist, thread_pool_s *pool, pregel_stats_s *stats) {
+  assert(src >= 0 && src < g->nb_vertices);
+  for (int v = 0; v < g->nb_vertices; v++)
+    dist[v] = INFINITY;
+  pregel_run(g, COMBINE_MIN, sssp_compute, &src, dist, INT_MAX, pool, stats);
+}
+
+/**
+ * @brief Vertex program of the connected components: a vertex lowered by its
+ * messages propagates its new label.
+ */
+static void components_compute(pregel_context_s *ctx, int v, double *label, double message, bool has_message,
+                               void *arg) {
+  (void)has_message;
+  (void)arg;
+  double l = (pregel_superstep(ctx) == 0) ? (double)v : message;
+  if (l < *label) {
+    *label = l;
+    GRAPH_LIST_FOREACH_EDGE(pregel_graph(ctx), v, u, w, (void)w; pregel_send(ctx, u, l);)
+  }
+  pregel_vote_to_halt(ctx, v);
+}
+
+/**
+ * @brief Labels the connected components (vertex program).
+ *
+ * @param g The graph (undirected: the labels only follow the out-edges).
+ * @param label Receives the label of each vertex.
+ * @param pool The thread pool.
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_components(graph_s *g, double *label, thread_pool_s *pool, pregel_stats_s *stats) {
+  assert(!g->directed);
+  for (int v = 0; v < g->nb_vertices; v++)
+    label[v] = INFINITY;
+  pregel_run(g, COMBINE_MIN, components_compute, NULL, label, INT_MAX, pool, stats);
+}
+
+/**
+ * @brief Parameters of the PageRank vertex program.
+ */
+typedef struct {
+  double damping;    /**< The damping factor */
+  int nb_iterations; /**< The number of iterations */
+} pagerank_s;
+
+/**
+ * @brief Vertex program of PageRank: a vertex sums the rank sent by its
+ * in-neighbours and spreads its own rank over its out-edges; the vertices without
+ * out-edge give their rank to the aggregator, shared by all the vertices.
+ */
+static void pagerank_compute(pregel_context_s *ctx, int v, double *rank, double message, bool has_message,
+                             void *arg) {
+  (void)has_message;
+  const pagerank_s *pr = arg;
+  int n = pregel_graph(ctx)->nb_vertices;
+  if (pregel_superstep(ctx) > 0)
+    *rank = (1.0 - pr->damping) / n + pr->damping * (message + pregel_aggregated(ctx) / n);
+  if (pregel_superstep(ctx) == pr->nb_iterations) {
+    pregel_vote_to_halt(ctx, v);
+  } else if (pregel_out_degree(ctx, v) == 0) {
+    pregel_aggregate(ctx, *rank);
+  } else {
+    double share = *rank / pregel_out_degree(ctx, v);
+    GRAPH_LIST_FOREACH_EDGE(pregel_graph(ctx), v, u, w, (void)w; pregel_send(ctx, u, share);)
+  }
+}
+
+/**
+ * @brief Computes the PageRank of the vertices (vertex program).
+ *
+ * @param g The graph.
+ * @param damping The damping factor (usually 0.85).
+ * @param nb_iterations The number of iterations.
+ * @param rank Receives the rank of each vertex (the ranks sum to 1).
+ * @param pool The thread pool.
+ * @param stats Receives the statistics of the run (may be NULL).
+ */
+void pregel_pagerank(graph_s *g, double damping, int nb_iterations, double *rank, thread_pool_s *pool,
+                     pregel_stats_s *stats) {
+  assert(damping >= 0.0 && damping <= 1.0 && nb_iterations >= 0);
+  pagerank_s pr = {damping, nb_iterations};
+  for (int v = 0; v < g->nb_vertices; v++)
+    rank[v] = 1.0 / g->nb_vertices;
+  pregel_run(g, COMBINE_SUM, pagerank_compute, &pr, rank, nb_iterations + 1, pool, stats);
+}
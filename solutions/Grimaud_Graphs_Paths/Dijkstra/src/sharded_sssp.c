@@ -0,0 +1,703 @@
+/**
+ * @file sharded_sssp.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Shortest paths computed by processes owning shards of the graph.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <assert.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "sharded_sssp.h"
+#include "heap.h"
+
+/**
+ * @brief Structure representing a distance update sent to another shard.
+ *
+ * The first record of a batch is a header whose `vertex` is the number of updates.
+ */
+typedef struct {
+  int vertex;  /**< Index of the vertex in the shard receiving the update */
+  int prev;    /**< Predecessor of the vertex (index in the whole graph) */
+  double dist; /**< Distance of the vertex through the predecessor */
+} update_s;
+
+/**
+ * @brief Kinds of the commands of the coordinator.
+ */
+typedef enum {
+  CMD_START, /**< Resets the distances and starts a search from a source */
+  CMD_STEP,  /**< Runs a step below a bound */
+  CMD_WRITE, /**< Writes the distances of the shard to the shared results */
+  CMD_STOP   /**< Exits */
+} command_e;
+
+/**
+ * @brief Structure representing a command of the coordinator.
+ */
+typedef struct {
+  command_e kind; /**< The kind of the command */
+  int source;     /**< Index of the source in the shard, -1 if it lies in another shard (CMD_START) */
+  double bound;   /**< Vertices below this distance are settled by the step (CMD_STEP) */
+} command_s;
+
+/**
+ * @brief Structure representing the reply of a process to a step.
+ */
+typedef struct {
+  long long nb_sent; /**< Number of updates sent by the step */
+  double min_dist;   /**< Smallest pending distance of the shard after the step */
+  int nb_ghosts;     /**< Number of ghosts of the shard */
+} reply_s;
+
+/**
+ * @brief Structure representing the size of a shard, sent before its arrays.
+ */
+typedef struct {
+  int nb_vertices; /**< Number of vertices of the shard */
+  int nb_edges;    /**< Number of edges leaving them */
+} shard_header_s;
+
+/**
+ * @brief Structure representing an edge sent to the process of its tail.
+ */
+typedef struct {
+  int head;      /**< Head of the edge (index in the whole graph) */
+  int owner;     /**< Shard of the head */
+  int local;     /**< Index of the head in its shard */
+  double weight; /**< Weight of the edge */
+} edge_record_s;
+
+/** @brief Number of edges sent per write. */
+#define EDGE_CHUNK 4096
+
+/**
+ * @brief Structure representing a growable batch of updates.
+ */
+typedef struct {
+  update_s *records; /**< Header followed by the updates */
+  int capacity;      /**< Number of records allocated */
+  size_t done;       /**< Number of bytes already sent or received */
+} batch_s;
+
+/**
+ * @brief Structure representing the shard of a process.
+ *
+ * The heads of the edges are local indices: below nb_vertices for the vertices of
+ * the shard, nb_vertices + i for the ghost i.
+ */
+typedef struct {
+  int self;           /**< Index of the shard */
+  int nb_vertices;    /**< Number of vertices of the shard */
+  int *global;        /**< Index in the whole graph of each vertex of the shard */
+  int *first;         /**< First edge of each vertex (nb_vertices+1 entries) */
+  int *head;          /**< Local head of each edge */
+  double *weight;     /**< Weight of each edge */
+  int nb_ghosts;      /**< Number of ghosts */
+  int *ghost_global;  /**< Index in the whole graph of each ghost (sorted) */
+  int *ghost_owner;   /**< Shard of each ghost */
+  int *ghost_index;   /**< Index of each ghost in its shard */
+  double *ghost_dist; /**< Best distance of each ghost sent so far */
+  int *ghost_slot;    /**< Position of each ghost in its outgoing batch (valid if ghost_step is the step) */
+  int *ghost_step;    /**< Last step that sent an update of each ghost */
+  double *dist;       /**< Tentative distance of each vertex */
+  int *prev;          /**< Predecessor of each vertex (index in the whole graph) */
+  heap_s *q;          /**< Vertices whose distance improved since they were settled */
+} shard_s;
+
+/**
+ * @brief Structure of the shard processes and of their coordinator.
+ */
+struct sharded {
+  int nb_vertices;   /**< Number of vertices of the graph */
+  int nb_shards;     /**< Number of shards, hence of processes */
+  int *owner;        /**< Shard of each vertex */
+  int *local;        /**< Index of each vertex in its shard */
+  int largest_shard; /**< Largest number of vertices of a shard */
+  pid_t *pid;        /**< Process of each shard */
+  int *control;      /**< End of the coordinator of the socket of each process */
+  vertex_s *result;  /**< Shared mapping of the results (nb_vertices+1 entries) */
+};
+
+/**
+ * @brief Comparison function of integers for qsort.
+ */
+static int compare_int(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Appends an update to a batch.
+ *
+ * @param b The batch.
+ * @param u The update.
+ * @return The position of the update in the batch.
+ */
+static int batch_push(batch_s *b, update_s u) {
+  int count = b->records[0].vertex + 1;
+  if (count == b->capacity) {
+    b->capacity *= 2;
+    b->records = realloc(b->records, b->capacity * sizeof(update_s));
+    assert(b->records!=NULL);
+  }
+  b->records[count] = u;
+  b->records[0].vertex = count;
+  return count;
+}
+
+/**
+ * @brief Improves the distance of a vertex of the shard.
+ */
+static void improve(shard_s *s, int v, double d, int prev) {
+  if (d < s->dist[v]) {
+    s->dist[v] = d;
+    s->prev[v] = prev;
+    heap_add((vertex_s){v, d, prev}, s->q);
+  }
+}
+
+/**
+ * @brief Writes a buffer entirely to a blocking socket.
+ *
+ * The socket is written with MSG_NOSIGNAL, so that a process that died makes the
+ * write fail instead of killing the writer with SIGPIPE.
+ *
+ * @return false if the socket is closed or fails.
+ */
+static bool write_all(int fd, const void *buf, size_t size) {
+  const char *p = buf;
+  while (size > 0) {
+    ssize_t nb = send(fd, p, size, MSG_NOSIGNAL);
+    if (nb < 0 && errno == EINTR) continue;
+    if (nb <= 0) return false;
+    p += nb;
+    size -= nb;
+  }
+  return true;
+}
+
+/**
+ * @brief Reads a buffer entirely from a blocking descriptor.
+ *
+ * @return false if the descriptor is closed or fails.
+ */
+static bool read_all(int fd, void *buf, size_t size) {
+  char *p = buf;
+  while (size > 0) {
+    ssize_t nb = read(fd, p, size);
+    if (nb < 0 && errno == EINTR) continue;
+    if (nb <= 0) return false;
+    p += nb;
+    size -= nb;
+  }
+  return true;
+}
+
+/**
+ * @brief Sends one batch to every other process and receives one batch from each.
+ *
+ * The sockets are non-blocking and served by poll as they become ready, so that
+ * two processes sending each other large batches never wait for each other.
+ *
+ * @param nb_shards The number of processes.
+ * @param self The index of the calling process.
+ * @param peer The socket connected to each other process (non-blocking).
+ * @param out The batch to send to each process.
+ * @param in Receives the batch of each process.
+ * @return false if a socket fails.
+ */
+static bool exchange(int nb_shards, int self, const int *peer, batch_s *out, batch_s *in) {
+  struct pollfd fds[nb_shards];
+  int pending = 0;
+  for (int p = 0; p < nb_shards; p++) {
+    out[p].done = in[p].done = 0;
+    if (p != self) pending += 2;
+  }
+  while (pending > 0) {
+    int nb_fds = 0;
+    for (int p = 0; p < nb_shards; p++) {
+      if (p == self) continue;
+      size_t out_size = (out[p].records[0].vertex + 1) * sizeof(update_s);
+      size_t in_size = in[p].done < sizeof(update_s) ? sizeof(update_s)
+                                                     : (in[p].records[0].vertex + 1) * sizeof(update_s);
+      short events = (out[p].done < out_size ? POLLOUT : 0) | (in[p].done < in_size ? POLLIN : 0);
+      if (events) fds[nb_fds++] = (struct pollfd){peer[p], events, 0};
+    }
+    if (poll(fds, nb_fds, -1) < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    for (int p = 0, i = 0; p < nb_shards; p++) {
+      if (p == self || i >= nb_fds || fds[i].fd != peer[p]) continue;
+      short revents = fds[i++].revents;
+      if (revents & (POLLERR | POLLNVAL)) return false;
+      if (revents & POLLOUT) {
+        size_t out_size = (out[p].records[0].vertex + 1) * sizeof(update_s);
+        ssize_t nb = send(peer[p], (char *)out[p].records + out[p].done, out_size - out[p].done, MSG_NOSIGNAL);
+        if (nb < 0 && errno != EAGAIN && errno != EINTR) return false;
+        if (nb > 0 && (out[p].done += nb) == out_size) pending--;
+      }
+      if (revents & (POLLIN | POLLHUP)) {
+        size_t in_size = in[p].done < sizeof(update_s) ? sizeof(update_s)
+                                                       : (in[p].records[0].vertex + 1) * sizeof(update_s);
+        ssize_t nb = read(peer[p], (char *)in[p].records + in[p].done, in_size - in[p].done);
+        if (nb == 0 || (nb < 0 && errno != EAGAIN && errno != EINTR)) return false;
+        if (nb > 0) in[p].done += nb;
+        if (in[p].done == sizeof(update_s) && in[p].records[0].vertex + 1 > in[p].capacity) {
+          in[p].capacity = in[p].records[0].vertex + 1;
+          in[p].records = realloc(in[p].records, in[p].capacity * sizeof(update_s));
+          assert(in[p].records!=NULL);
+        }
+        if (in[p].done >= sizeof(update_s) && in[p].done == (in[p].records[0].vertex + 1) * sizeof(update_s))
+          pending--;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Structure representing a ghost met while a shard is received.
+ */
+typedef struct {
+  int global; /**< Index of the ghost in the whole graph */
+  int owner;  /**< Shard of the ghost */
+  int local;  /**< Index of the ghost in its shard */
+} ghost_s;
+
+/**
+ * @brief Comparison function of ghosts by index in the whole graph, for qsort.
+ */
+static int compare_ghost(const void *a, const void *b) {
+  int x = ((const ghost_s *)a)->global, y = ((const ghost_s *)b)->global;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Sends its part of the graph to the process of a shard (coordinator side).
+ *
+ * The shard is sent as its size, the index in the whole graph of each of its
+ * vertices, the first edge of each vertex, then the edges by chunks.
+ *
+ * @param fd The socket connected to the process.
+ * @param g The graph.
+ * @param owner The shard of each vertex.
+ * @param local The index of each vertex in its shard.
+ * @param self The shard to send.
+ * @param nb_vertices The number of vertices of the shard.
+ * @return false if the socket fails.
+ */
+static bool shard_send(int fd, graph_s *g, const int *owner, const int *local, int self, int nb_vertices) {
+  int *global = malloc((nb_vertices + 1) * sizeof(int));
+  int *first = malloc((nb_vertices + 1) * sizeof(int));
+  edge_record_s *chunk = malloc(EDGE_CHUNK * sizeof(edge_record_s));
+  assert(global!=NULL && first!=NULL && chunk!=NULL);
+  for (int v = 0; v < g->nb_vertices; v++)
+    if (owner[v] == self) global[local[v]] = v;
+  first[0] = 0;
+  for (int u = 0; u < nb_vertices; u++) {
+    first[u + 1] = first[u];
+    for (adj_list_s *adj = get_adj_list(g, global[u]); adj != NULL; adj = adj->next)
+      first[u + 1]++;
+  }
+  shard_header_s h = {nb_vertices, first[nb_vertices]};
+  bool ok = write_all(fd, &h, sizeof(h)) && write_all(fd, global, nb_vertices * sizeof(int)) &&
+            write_all(fd, first, (nb_vertices + 1) * sizeof(int));
+  int nb = 0;
+  for (int u = 0; ok && u < nb_vertices; u++)
+    for (adj_list_s *adj = get_adj_list(g, global[u]); ok && adj != NULL; adj = adj->next) {
+      int v = adj->vertex.ind;
+      chunk[nb++] = (edge_record_s){v, owner[v], local[v], adj->vertex.weight};
+      if (nb == EDGE_CHUNK) {
+        ok = write_all(fd, chunk, nb * sizeof(edge_record_s));
+        nb = 0;
+      }
+    }
+  if (ok && nb > 0) ok = write_all(fd, chunk, nb * sizeof(edge_record_s));
+  free(chunk);
+  free(first);
+  free(global);
+  return ok;
+}
+
+/**
+ * @brief Receives the shard of a process from the coordinator (process side).
+ *
+ * The remote heads become the ghosts, sorted without duplicates.
+ *
+ * @param fd The socket connected to the coordinator.
+ * @param self The index of the shard.
+ * @return Pointer to the shard, NULL if the socket fails.
+ */
+static shard_s *shard_receive(int fd, int self) {
+  shard_header_s h;
+  if (!read_all(fd, &h, sizeof(h))) return NULL;
+  int n = h.nb_vertices, m = h.nb_edges;
+  shard_s *s = calloc(1, sizeof(shard_s));
+  assert(s!=NULL);
+  s->self = self;
+  s->nb_vertices = n;
+  s->global = malloc((n + 1) * sizeof(int));
+  s->first = malloc((n + 1) * sizeof(int));
+  s->head = malloc((m + 1) * sizeof(int));
+  s->weight = malloc((m + 1) * sizeof(double));
+  ghost_s *ghosts = malloc((m + 1) * sizeof(ghost_s));
+  edge_record_s *chunk = malloc(EDGE_CHUNK * sizeof(edge_record_s));
+  assert(s->global!=NULL && s->first!=NULL && s->head!=NULL && s->weight!=NULL);
+  assert(ghosts!=NULL && chunk!=NULL);
+  if (!read_all(fd, s->global, n * sizeof(int)) || !read_all(fd, s->first, (n + 1) * sizeof(int))) return NULL;
+  // The local heads are stored at once, the remote ones as -1-v until the ghosts are numbered
+  int nb_ghosts = 0;
+  for (int e = 0; e < m; e += EDGE_CHUNK) {
+    int nb = (m - e < EDGE_CHUNK) ? m - e : EDGE_CHUNK;
+    if (!read_all(fd, chunk, nb * sizeof(edge_record_s))) return NULL;
+    for (int i = 0; i < nb; i++) {
+      s->weight[e + i] = chunk[i].weight;
+      if (chunk[i].owner == self) {
+        s->head[e + i] = chunk[i].local;
+      } else {
+        s->head[e + i] = -1 - chunk[i].head;
+        ghosts[nb_ghosts++] = (ghost_s){chunk[i].head, chunk[i].owner, chunk[i].local};
+      }
+    }
+  }
+  free(chunk);
+  qsort(ghosts, nb_ghosts, sizeof(ghost_s), compare_ghost);
+  s->nb_ghosts = 0;
+  for (int i = 0; i < nb_ghosts; i++)
+    if (s->nb_ghosts == 0 || ghosts[s->nb_ghosts - 1].global != ghosts[i].global)
+      ghosts[s->nb_ghosts++] = ghosts[i];
+  nb_ghosts = s->nb_ghosts;
+  s->ghost_global = malloc((nb_ghosts + 1) * sizeof(int));
+  s->ghost_owner = malloc((nb_ghosts + 1) * sizeof(int));
+  s->ghost_index = malloc((nb_ghosts + 1) * sizeof(int));
+  s->ghost_dist = malloc((nb_ghosts + 1) * sizeof(double));
+  s->ghost_slot = malloc((nb_ghosts + 1) * sizeof(int));
+  s->ghost_step = malloc((nb_ghosts + 1) * sizeof(int));
+  s->dist = malloc((n + 1) * sizeof(double));
+  s->prev = malloc((n + 1) * sizeof(int));
+  assert(s->ghost_global!=NULL && s->ghost_owner!=NULL && s->ghost_index!=NULL && s->ghost_dist!=NULL);
+  assert(s->ghost_slot!=NULL && s->ghost_step!=NULL);
+  assert(s->dist!=NULL && s->prev!=NULL);
+  for (int i = 0; i < nb_ghosts; i++) {
+    s->ghost_global[i] = ghosts[i].global;
+    s->ghost_owner[i] = ghosts[i].owner;
+    s->ghost_index[i] = ghosts[i].local;
+  }
+  free(ghosts);
+  for (int e = 0; e < m; e++)
+    if (s->head[e] < 0) {
+      int v = -1 - s->head[e];
+      int *ghost = bsearch(&v, s->ghost_global, nb_ghosts, sizeof(int), compare_int);
+      s->head[e] = n + (int)(ghost - s->ghost_global);
+    }
+  s->q = heap_create(n + 1);
+  return s;
+}
+
+/**
+ * @brief Runs the commands of the coordinator until it stops the process.
+ *
+ * @param s The shard of the process.
+ * @param nb_shards The number of processes.
+ * @param control The socket connected to the coordinator.
+ * @param peer The socket connected to each other process.
+ * @param result The shared array of the results.
+ * @return The exit status of the process.
+ */
+static int shard_run(shard_s *s, int nb_shards, int control, const int *peer, vertex_s *result) {
+  for (int p = 0; p < nb_shards; p++)
+    if (p != s->self) fcntl(peer[p], F_SETFL, fcntl(peer[p], F_GETFL) | O_NONBLOCK);
+  batch_s out[nb_shards], in[nb_shards];
+  for (int p = 0; p < nb_shards; p++) {
+    out[p].capacity = in[p].capacity = 1024;
+    out[p].records = malloc(1024 * sizeof(update_s));
+    in[p].records = malloc(1024 * sizeof(update_s));
+    assert(out[p].records!=NULL && in[p].records!=NULL);
+  }
+  int status = 1, step = 0;
+  command_s cmd;
+  while (read_all(control, &cmd, sizeof(cmd))) {
+    if (cmd.kind == CMD_STOP) {
+      status = 0;
+      break;
+    }
+    if (cmd.kind == CMD_START) {
+      for (int u = 0; u < s->nb_vertices; u++) {
+        s->dist[u] = INFINITY;
+        s->prev[u] = -1;
+      }
+      for (int i = 0; i < s->nb_ghosts; i++) {
+        s->ghost_dist[i] = INFINITY;
+        s->ghost_step[i] = -1;
+      }
+      while (!heap_empty(s->q))
+        heap_remove(s->q);
+      step = 0;
+      if (cmd.source >= 0) improve(s, cmd.source, 0.0, -1);
+      continue;
+    }
+    if (cmd.kind == CMD_WRITE) {
+      for (int u = 0; u < s->nb_vertices; u++)
+        result[s->global[u]] = (vertex_s){s->global[u], s->dist[u], s->prev[u]};
+      int done = 1;
+      if (!write_all(control, &done, sizeof(done))) break;
+      continue;
+    }
+    reply_s reply = {0, INFINITY, s->nb_ghosts};
+    for (int p = 0; p < nb_shards; p++)
+      out[p].records[0] = (update_s){0, -1, 0.0};
+    // Local Dijkstra loop below the bound, the ghosts keeping their best distance
+    while (!heap_empty(s->q) && heap_peek(s->q).weight < cmd.bound) {
+      vertex_s top = heap_peek(s->q);
+      heap_remove(s->q);
+      int u = top.ind;
+      for (int e = s->first[u]; e < s->first[u + 1]; e++) {
+        int v = s->head[e];
+        double d = top.weight + s->weight[e];
+        if (v < s->nb_vertices) {
+          improve(s, v, d, s->global[u]);
+        } else if (d < s->ghost_dist[v - s->nb_vertices]) {
+          int ghost = v - s->nb_vertices;
+          batch_s *b = &out[s->ghost_owner[ghost]];
+          update_s upd = {s->ghost_index[ghost], s->global[u], d};
+          s->ghost_dist[ghost] = d;
+          if (s->ghost_step[ghost] == step) {
+            b->records[s->ghost_slot[ghost]] = upd;
+          } else {
+            s->ghost_step[ghost] = step;
+            s->ghost_slot[ghost] = batch_push(b, upd);
+          }
+        }
+      }
+    }
+    for (int p = 0; p < nb_shards; p++)
+      reply.nb_sent += out[p].records[0].vertex;
+    if (!exchange(nb_shards, s->self, peer, out, in)) break;
+    for (int p = 0; p < nb_shards; p++)
+      for (int i = 1; p != s->self && i <= in[p].records[0].vertex; i++)
+        improve(s, in[p].records[i].vertex, in[p].records[i].dist, in[p].records[i].prev);
+    if (!heap_empty(s->q)) reply.min_dist = heap_peek(s->q).weight;
+    if (!write_all(control, &reply, sizeof(reply))) break;
+    step++;
+  }
+  for (int p = 0; p < nb_shards; p++) {
+    free(out[p].records);
+    free(in[p].records);
+  }
+  return status;
+}
+
+/**
+ * @brief Stops the processes after a failure.
+ *
+ * @param pid The processes.
+ * @param nb The number of processes.
+ */
+static void kill_shards(const pid_t *pid, int nb) {
+  for (int i = 0; i < nb; i++)
+    if (pid[i] > 0) {
+      kill(pid[i], SIGKILL);
+      waitpid(pid[i], NULL, 0);
+    }
+}
+
+/**
+ * @brief Forks one process per shard and sends each one its part of the graph.
+ *
+ * Each process frees the graph inherited at the fork before receiving its shard,
+ * so that the graph is only held by the coordinator while the shards are sent.
+ *
+ * @param g The graph (the weights must be non negative).
+ * @param owner The shard of each vertex (0 to nb_shards-1).
+ * @param nb_shards The number of shards, hence of processes.
+ * @return Pointer to the shard processes, or NULL if a process or a socket could not
+ *         be created.
+ */
+sharded_s *sharded_create(graph_s *g, const int *owner, int nb_shards) {
+  assert(g!=NULL && owner!=NULL && nb_shards >= 1);
+  int n = g->nb_vertices;
+  sharded_s *sh = malloc(sizeof(sharded_s));
+  assert(sh!=NULL);
+  sh->nb_vertices = n;
+  sh->nb_shards = nb_shards;
+  sh->owner = malloc((n + 1) * sizeof(int));
+  sh->local = malloc((n + 1) * sizeof(int));
+  sh->pid = calloc(nb_shards, sizeof(pid_t));
+  sh->control = malloc(nb_shards * sizeof(int));
+  int *size = calloc(nb_shards, sizeof(int));
+  int *sockets = malloc(2 * nb_shards * sizeof(int));
+  int *mesh = malloc(nb_shards * nb_shards * sizeof(int));
+  assert(sh->owner!=NULL && sh->local!=NULL && sh->pid!=NULL && sh->control!=NULL);
+  assert(size!=NULL && sockets!=NULL && mesh!=NULL);
+  sh->largest_shard = 0;
+  for (int v = 0; v < n; v++) {
+    assert(owner[v] >= 0 && owner[v] < nb_shards);
+    sh->owner[v] = owner[v];
+    sh->local[v] = size[owner[v]]++;
+  }
+  for (int i = 0; i < nb_shards; i++)
+    if (size[i] > sh->largest_shard) sh->largest_shard = size[i];
+  // sockets[2i] is the end of the coordinator, sockets[2i+1] the end of the process i;
+  // mesh[i*nb_shards+j] is the end of the process i connected to the process j
+  for (int i = 0; i < 2 * nb_shards; i++)
+    sockets[i] = -1;
+  for (int i = 0; i < nb_shards * nb_shards; i++)
+    mesh[i] = -1;
+  sh->result = mmap(NULL, (n + 1) * sizeof(vertex_s), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  bool ok = (sh->result != MAP_FAILED);
+  for (int i = 0; ok && i < nb_shards; i++) {
+    ok = socketpair(AF_UNIX, SOCK_STREAM, 0, sockets + 2 * i) == 0;
+    for (int j = i + 1; ok && j < nb_shards; j++) {
+      int sv[2];
+      ok = socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0;
+      if (ok) {
+        mesh[i * nb_shards + j] = sv[0];
+        mesh[j * nb_shards + i] = sv[1];
+      }
+    }
+  }
+  fflush(NULL);
+  for (int i = 0; ok && i < nb_shards; i++) {
+    sh->pid[i] = fork();
+    ok = (sh->pid[i] >= 0);
+    if (sh->pid[i] == 0) {
+      // Process of the shard i: it keeps its control end and its mesh ends only,
+      // and drops the graph before receiving its part of it
+      for (int j = 0; j < nb_shards; j++) {
+        close(sockets[2 * j]);
+        if (j != i) close(sockets[2 * j + 1]);
+        for (int k = 0; k < nb_shards; k++)
+          if (j != i && mesh[j * nb_shards + k] >= 0) close(mesh[j * nb_shards + k]);
+      }
+      delete_graph(g);
+      shard_s *s = shard_receive(sockets[2 * i + 1], i);
+      _exit(s ? shard_run(s, nb_shards, sockets[2 * i + 1], mesh + i * nb_shards, sh->result) : 1);
+    }
+  }
+  for (int i = 0; i < nb_shards * nb_shards; i++)
+    if (mesh[i] >= 0) close(mesh[i]);
+  for (int i = 0; i < nb_shards; i++) {
+    if (sockets[2 * i + 1] >= 0) close(sockets[2 * i + 1]);
+    sh->control[i] = sockets[2 * i];
+  }
+  for (int i = 0; ok && i < nb_shards; i++)
+    ok = shard_send(sh->control[i], g, sh->owner, sh->local, i, size[i]);
+  free(mesh);
+  free(sockets);
+  free(size);
+  if (!ok) {
+    kill_shards(sh->pid, nb_shards);
+    for (int i = 0; i < nb_shards; i++)
+      sh->pid[i] = 0;
+    sharded_delete(sh);
+    return NULL;
+  }
+  return sh;
+}
+
+/**
+ * @brief Computes the shortest paths from a source with the shard processes.
+ *
+ * @param sh The shard processes.
+ * @param src The source vertex.
+ * @param delta The width of the distance buckets (INFINITY: one bucket).
+ * @param stats Receives the statistics of the search (may be NULL).
+ * @return An array of vertices with the shortest path information, or NULL if a
+ *         process failed.
+ */
+vertex_s *sharded_search(sharded_s *sh, int src, double delta, sharded_stats_s *stats) {
+  assert(sh!=NULL && delta > 0.0);
+  assert(src >= 0 && src < sh->nb_vertices);
+  int nb_shards = sh->nb_shards;
+  sharded_stats_s st = {0, 0, 0, sh->largest_shard, 0};
+  bool ok = true;
+  for (int i = 0; ok && i < nb_shards; i++) {
+    command_s start = {CMD_START, sh->owner[src] == i ? sh->local[src] : -1, 0.0};
+    ok = write_all(sh->control[i], &start, sizeof(start));
+  }
+  // One bound per step until no distance is pending
+  double min_dist = 0.0;
+  while (ok && min_dist < INFINITY) {
+    command_s cmd = {CMD_STEP, -1, isinf(delta) ? INFINITY : (floor(min_dist / delta) + 1.0) * delta};
+    for (int i = 0; ok && i < nb_shards; i++)
+      ok = write_all(sh->control[i], &cmd, sizeof(cmd));
+    min_dist = INFINITY;
+    for (int i = 0; ok && i < nb_shards; i++) {
+      reply_s reply;
+      ok = read_all(sh->control[i], &reply, sizeof(reply));
+      if (!ok) break;
+      st.nb_messages += reply.nb_sent;
+      if (reply.min_dist < min_dist) min_dist = reply.min_dist;
+      if (reply.nb_ghosts > st.largest_ghosts) st.largest_ghosts = reply.nb_ghosts;
+    }
+    st.nb_steps++;
+  }
+  command_s write = {CMD_WRITE, -1, 0.0};
+  for (int i = 0; ok && i < nb_shards; i++)
+    ok = write_all(sh->control[i], &write, sizeof(write));
+  for (int i = 0; ok && i < nb_shards; i++) {
+    int done;
+    ok = read_all(sh->control[i], &done, sizeof(done));
+  }
+  st.nb_bytes = (st.nb_messages + (long long)st.nb_steps * nb_shards * (nb_shards - 1)) * sizeof(update_s);
+  if (stats != NULL) *stats = st;
+  if (!ok) {
+    kill_shards(sh->pid, nb_shards);
+    for (int i = 0; i < nb_shards; i++)
+      sh->pid[i] = 0;
+    return NULL;
+  }
+  vertex_s *dst = malloc((sh->nb_vertices + 1) * sizeof(vertex_s));
+  assert(dst!=NULL);
+  memcpy(dst, sh->result, sh->nb_vertices * sizeof(vertex_s));
+  return dst;
+}
+
+/**
+ * @brief Stops the shard processes and frees the coordinator.
+ *
+ * @param sh Pointer to the shard processes (may be NULL).
+ */
+void sharded_delete(sharded_s *sh) {
+  if (!sh) return;
+  command_s stop = {CMD_STOP, -1, 0.0};
+  for (int i = 0; i < sh->nb_shards; i++)
+    if (sh->pid[i] > 0) write_all(sh->control[i], &stop, sizeof(stop));
+  for (int i = 0; i < sh->nb_shards; i++) {
+    if (sh->pid[i] > 0) waitpid(sh->pid[i], NULL, 0);
+    if (sh->control[i] >= 0) close(sh->control[i]);
+  }
+  if (sh->result != MAP_FAILED) munmap(sh->result, (sh->nb_vertices + 1) * sizeof(vertex_s));
+  free(sh->control);
+  free(sh->pid);
+  free(sh->local);
+  free(sh->owner);
+  free(sh);
+}
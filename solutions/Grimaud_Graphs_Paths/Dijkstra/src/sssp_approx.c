@@ -0,0 +1,321 @@
+/**
+ * @file sssp_approx.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief (1+ε)-approximate shortest path distances with rounded weights and bucket queues.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include "sssp_approx.h"
+#include "numa_alloc.h"
+
+/**
+ * @brief Parses the name of a rounding.
+ *
+ * @param str The name: "grid" or "geometric".
+ * @param rounding Address where the rounding is stored.
+ * @return false if the name is unknown.
+ */
+bool sssp_approx_parse_rounding(const char *str, rounding_e *rounding) {
+  if (strcmp(str, "grid") == 0) *rounding = ROUND_GRID;
+  else if (strcmp(str, "geometric") == 0) *rounding = ROUND_GEOMETRIC;
+  else return false;
+  return true;
+}
+
+/**
+ * @brief Rounds the weights up to multiples of the unit and prepares the circular buckets.
+ *
+ * @param a The prepared graph, whose unit is set.
+ * @return false if more than SSSP_APPROX_MAX_BUCKETS buckets are needed.
+ */
+static bool round_grid(sssp_approx_s *a) {
+  const graph_csr_s *csr = a->csr;
+  int max_level = 0;
+  for (int e = 0; e < csr->nb_edges; e++) {
+    double units = ceil(csr->weight[e] / a->unit);
+    if (units >= SSSP_APPROX_MAX_BUCKETS) return false;
+    a->level[e] = (int)units;
+    if (a->level[e] > max_level) max_level = a->level[e];
+  }
+  // The tentative keys lie within max_level units of the key being settled
+  a->nb_buckets = max_level + 1;
+  a->bucket = malloc(a->nb_buckets * sizeof(int));
+  a->next = malloc(csr->nb_vertices * sizeof(int));
+  a->previous = malloc(csr->nb_vertices * sizeof(int));
+  assert(a->bucket!=NULL && a->next!=NULL && a->previous!=NULL);
+  // The searches leave the buckets empty
+  for (int b = 0; b < a->nb_buckets; b++)
+    a->bucket[b] = -1;
+  return true;
+}
+
+/**
+ * @brief Rounds the weights up to powers of (1+ε) and prepares one bucket per weight class.
+ *
+ * The class 0 holds the edges of weight 0, the class c > 0 the edges rounded to the
+ * smallest positive weight times (1+ε)^(c-1).
+ *
+ * @param a The prepared graph.
+ * @param min_weight The smallest positive weight.
+ */
+static void round_geometric(sssp_approx_s *a, double min_weight) {
+  const graph_csr_s *csr = a->csr;
+  double ratio = log1p(a->epsilon);
+  int max_class = 0;
+  for (int e = 0; e < csr->nb_edges; e++) {
+    double w = csr->weight[e];
+    int c = 0;
+    if (w > 0.0) {
+      int k = (int)ceil(log(w / min_weight) / ratio);
+      while (k > 0 && min_weight * pow(1.0 + a->epsilon, k - 1) >= w) k--;
+      while (min_weight * pow(1.0 + a->epsilon, k) < w) k++;
+      c = k + 1;
+    }
+    a->level[e] = c;
+    if (c > max_class) max_class = c;
+  }
+  a->nb_buckets = max_class + 1;
+  a->class_weight = malloc(a->nb_buckets * sizeof(double));
+  a->class_first = calloc(a->nb_buckets + 1, sizeof(int));
+  a->class_head = malloc(a->nb_buckets * sizeof(int));
+  a->class_tail = malloc(a->nb_buckets * sizeof(int));
+  assert(a->class_weight!=NULL && a->class_first!=NULL && a->class_head!=NULL && a->class_tail!=NULL);
+  a->class_weight[0] = 0.0;
+  for (int c = 1; c < a->nb_buckets; c++)
+    a->class_weight[c] = min_weight * pow(1.0 + a->epsilon, c - 1);
+  // Each edge is relaxed at most once per search: a class holds at most its edges
+  for (int e = 0; e < csr->nb_edges; e++)
+    a->class_first[a->level[e] + 1]++;
+  for (int c = 0; c < a->nb_buckets; c++)
+    a->class_first[c + 1] += a->class_first[c];
+  a->entry_vertex = numa_alloc_local(((size_t)csr->nb_edges + 1) * sizeof(int));
+  a->entry_key = numa_alloc_local(((size_t)csr->nb_edges + 1) * sizeof(double));
+  assert(a->entry_vertex!=NULL && a->entry_key!=NULL);
+  a->classes = heap_create(a->nb_buckets);
+}
+
+/**
+ * @brief Rounds the weights of a graph for approximate searches.
+ *
+ * @param csr The CSR graph (the weights must be non negative), kept until the deletion.
+ * @param epsilon The bound of the relative error (positive).
+ * @param rounding The rounding of the weights.
+ * @return Pointer to the prepared graph, NULL if the grid rounding needs more than
+ *         SSSP_APPROX_MAX_BUCKETS buckets.
+ */
+sssp_approx_s *sssp_approx_create(const graph_csr_s *csr, double epsilon, rounding_e rounding) {
+  assert(csr!=NULL && epsilon > 0.0);
+  sssp_approx_s *a = calloc(1, sizeof(sssp_approx_s));
+  assert(a!=NULL);
+  a->csr = csr;
+  a->rounding = rounding;
+  a->epsilon = epsilon;
+  double min_weight = INFINITY;
+  for (int e = 0; e < csr->nb_edges; e++)
+    if (csr->weight[e] > 0.0 && csr->weight[e] < min_weight) min_weight = csr->weight[e];
+  if (min_weight == INFINITY) min_weight = 1.0; // only edges of weight 0
+  a->unit = epsilon * min_weight;
+  a->level = numa_alloc_local(((size_t)csr->nb_edges + 1) * sizeof(int));
+  a->key = malloc(csr->nb_vertices * sizeof(double));
+  a->settled = malloc(csr->nb_vertices * sizeof(bool));
+  assert(a->level!=NULL && a->key!=NULL && a->settled!=NULL);
+  if (rounding == ROUND_GEOMETRIC) {
+    round_geometric(a, min_weight);
+  } else if (!round_grid(a)) {
+    sssp_approx_delete(a);
+    return NULL;
+  }
+  return a;
+}
+
+/**
+ * @brief Inserts a vertex in the circular bucket of its key.
+ *
+ * @param a The prepared graph.
+ * @param v The vertex.
+ */
+static inline void bucket_link(sssp_approx_s *a, int v) {
+  int b = (int)((long long)a->key[v] % a->nb_buckets);
+  a->next[v] = a->bucket[b];
+  a->previous[v] = -1;
+  if (a->bucket[b] != -1) a->previous[a->bucket[b]] = v;
+  a->bucket[b] = v;
+}
+
+/**
+ * @brief Removes a vertex from the circular bucket of its key.
+ *
+ * @param a The prepared graph.
+ * @param v The vertex.
+ */
+static inline void bucket_unlink(sssp_approx_s *a, int v) {
+  if (a->previous[v] != -1) a->next[a->previous[v]] = a->next[v];
+  else a->bucket[(int)((long long)a->key[v] % a->nb_buckets)] = a->next[v];
+  if (a->next[v] != -1) a->previous[a->next[v]] = a->previous[v];
+}
+
+/**
+ * @brief Runs Dial's algorithm on the weights rounded to multiples of the unit.
+ *
+ * The keys are numbers of units: the bucket of the key k is k modulo the number of
+ * buckets, and the buckets are scanned in circular order from the key of the source.
+ *
+ * @param a The prepared graph.
+ * @param src The source vertex.
+ * @param dst The lengths and predecessors of the paths found.
+ */
+static void query_grid(sssp_approx_s *a, int src, vertex_s *dst) {
+  const graph_csr_s *csr = a->csr;
+  a->key[src] = 0.0;
+  dst[src].weight = 0.0;
+  bucket_link(a, src);
+  int nb_queued = 1;
+  for (long long cur = 0; nb_queued > 0; cur++) {
+    int b = (int)(cur % a->nb_buckets);
+    while (a->bucket[b] != -1) {
+      int u = a->bucket[b];
+      bucket_unlink(a, u);
+      nb_queued--;
+      a->settled[u] = true;
+      for (int e = csr->first[u]; e < csr->first[u + 1]; e++) {
+        int v = csr->head[e];
+        if (a->settled[v]) continue;
+        double key = a->key[u] + a->level[e];
+        double length = dst[u].weight + csr->weight[e];
+        if (key < a->key[v]) {
+          if (a->key[v] == INFINITY) nb_queued++;
+          else bucket_unlink(a, v);
+          a->key[v] = key;
+          bucket_link(a, v);
+          dst[v].weight = length;
+          dst[v].prev = u;
+        } else if (key == a->key[v] && length < dst[v].weight) {
+          dst[v].weight = length; // same rounded distance, shorter path
+          dst[v].prev = u;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Settles a vertex of the geometric search and queues its unsettled neighbours.
+ *
+ * @param a The prepared graph.
+ * @param u The vertex.
+ * @param dst The lengths and predecessors of the paths found.
+ */
+static void settle_geometric(sssp_approx_s *a, int u, vertex_s *dst) {
+  const graph_csr_s *csr = a->csr;
+  a->settled[u] = true;
+  for (int e = csr->first[u]; e < csr->first[u + 1]; e++) {
+    int v = csr->head[e];
+    if (a->settled[v]) continue;
+    int c = a->level[e];
+    double key = a->key[u] + a->class_weight[c];
+    double length = dst[u].weight + csr->weight[e];
+    if (key < a->key[v]) {
+      a->key[v] = key;
+      dst[v].weight = length;
+      dst[v].prev = u;
+      // The keys of a class are queued in increasing order: only its head competes
+      if (a->class_head[c] == a->class_tail[c])
+        heap_add((vertex_s){c, key, -1}, a->classes);
+      a->entry_vertex[a->class_tail[c]] = v;
+      a->entry_key[a->class_tail[c]] = key;
+      a->class_tail[c]++;
+    } else if (key == a->key[v] && length < dst[v].weight) {
+      dst[v].weight = length;
+      dst[v].prev = u;
+    }
+  }
+}
+
+/**
+ * @brief Runs Dijkstra's algorithm on the weights rounded to powers of (1+ε).
+ *
+ * @param a The prepared graph.
+ * @param src The source vertex.
+ * @param dst The lengths and predecessors of the paths found.
+ */
+static void query_geometric(sssp_approx_s *a, int src, vertex_s *dst) {
+  for (int c = 0; c < a->nb_buckets; c++)
+    a->class_head[c] = a->class_tail[c] = a->class_first[c];
+  a->key[src] = 0.0;
+  dst[src].weight = 0.0;
+  settle_geometric(a, src, dst);
+  while (!heap_empty(a->classes)) {
+    int c = heap_peek(a->classes).ind;
+    heap_remove(a->classes);
+    int i = a->class_head[c]++;
+    if (a->class_head[c] < a->class_tail[c])
+      heap_add((vertex_s){c, a->entry_key[a->class_head[c]], -1}, a->classes);
+    int v = a->entry_vertex[i];
+    // Skip the entries of settled vertices and those superseded by a smaller key
+    if (a->settled[v] || a->entry_key[i] > a->key[v]) continue;
+    settle_geometric(a, v, dst);
+  }
+}
+
+/**
+ * @brief Computes (1+ε)-approximate distances from a source to all the vertices.
+ *
+ * @param a The prepared graph.
+ * @param src The source vertex.
+ * @param dst Array of `csr->nb_vertices` vertices, filled with the length of the path
+ *            found to each vertex (INFINITY if unreachable) and its predecessor.
+ */
+void sssp_approx_query(sssp_approx_s *a, int src, vertex_s *dst) {
+  assert(a!=NULL && dst!=NULL);
+  assert(src >= 0 && src < a->csr->nb_vertices);
+  for (int v = 0; v < a->csr->nb_vertices; v++) {
+    a->key[v] = INFINITY;
+    a->settled[v] = false;
+    dst[v] = (vertex_s){v, INFINITY, -1};
+  }
+  if (a->rounding == ROUND_GEOMETRIC) query_geometric(a, src, dst);
+  else query_grid(a, src, dst);
+}
+
+/**
+ * @brief Deletes a prepared graph and frees its memory (the CSR graph is kept).
+ *
+ * @param a Pointer to the prepared graph.
+ */
+void sssp_approx_delete(sssp_approx_s *a) {
+  assert(a!=NULL);
+  size_t nb_entries = (size_t)a->csr->nb_edges + 1;
+  numa_free(a->level, nb_entries * sizeof(int));
+  free(a->key);
+  free(a->settled);
+  free(a->bucket);
+  free(a->next);
+  free(a->previous);
+  free(a->class_weight);
+  free(a->class_first);
+  free(a->class_head);
+  free(a->class_tail);
+  numa_free(a->entry_vertex, nb_entries * sizeof(int));
+  numa_free(a->entry_key, nb_entries * sizeof(double));
+  if (a->classes) heap_delete(a->classes);
+  free(a);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file sssp_csr.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Dijkstra searches on a CSR graph with an optional prefetching relaxation loop.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <string.h>
+#include <assert.h>
+#include "sssp_csr.h"
+
+/**
+ * @brief Parses the name of a relaxation loop.
+ *
+ * @param str The name: "plain" or "prefetch".
+ * @param relax Address where the relaxation loop is stored.
+ * @return false if the name is unknown.
+ */
+bool sssp_csr_parse_relax(const char *str, relax_e *relax) {
+  if (strcmp(str, "plain") == 0) *relax = RELAX_PLAIN;
+  else if (strcmp(str, "prefetch") == 0) *relax = RELAX_PREFETCH;
+  else return false;
+  return true;
+}
+
+/**
+ * @brief Prefetches the labels of a vertex read by `workspace_push`.
+ *
+ * @param ws The workspace.
+ * @param v The vertex.
+ */
+static inline void prefetch_labels(const workspace_s *ws, int v) {
+  __builtin_prefetch(&ws->settled[v]);
+  __builtin_prefetch(&ws->reached[v]);
+  __builtin_prefetch(&ws->dist[v]);
+  heap_prefetch(ws->q, v);
+}
+
+/**
+ * @brief Settles the vertices in order, relaxing their edges without any hint.
+ *
+ * @param csr The CSR graph.
+ * @param ws The workspace, holding the source.
+ */
+static void relax_plain(const graph_csr_s *csr, workspace_s *ws) {
+  vertex_s v;
+  while (workspace_pop(ws, &v))
+    for (int e = csr->first[v.ind]; e < csr->first[v.ind + 1]; e++)
+      workspace_push(ws, csr->head[e], v.weight + csr->weight[e], v.ind);
+}
+
+/**
+ * @brief Settles the vertices in order, prefetching the data of the upcoming edges.
+ *
+ * When a vertex is popped, the labels of the heads of its first PREFETCH_DISTANCE
+ * edges are prefetched, then relaxing the edge e prefetches the labels of the head of
+ * the edge e + PREFETCH_DISTANCE. The vertex on top of the heap is usually the next
+ * one popped: its entry in `first` is prefetched before the relaxations, and the
+ * beginning of its edges after them.
+ *
+ * @param csr The CSR graph.
+ * @param ws The workspace, holding the source.
+ */
+static void relax_prefetch(const graph_csr_s *csr, workspace_s *ws) {
+  const int *first = csr->first, *head = csr->head;
+  const double *weight = csr->weight;
+  vertex_s v;
+  while (workspace_pop(ws, &v)) {
+    int lo = first[v.ind], hi = first[v.ind + 1];
+    if (!heap_empty(ws->q))
+      __builtin_prefetch(&first[heap_peek(ws->q).ind]);
+    int ahead = (hi - lo > PREFETCH_DISTANCE) ? lo + PREFETCH_DISTANCE : hi;
+    for (int e = lo; e < ahead; e++)
+      prefetch_labels(ws, head[e]);
+    for (int e = lo; e < hi; e++) {
+      if (e + PREFETCH_DISTANCE < hi)
+        prefetch_labels(ws, head[e + PREFETCH_DISTANCE]);
+      workspace_push(ws, head[e], v.weight + weight[e], v.ind);
+    }
+    if (!heap_empty(ws->q)) {
+      int next = first[heap_peek(ws->q).ind];
+      __builtin_prefetch(&head[next]);
+      __builtin_prefetch(&weight[next]);
+    }
+  }
+}
+
+/**
+ * @brief Computes the distances from a source to all the vertices of a CSR graph.
+ *
+ * @param csr The CSR graph (the weights must be non negative).
+ * @param src The source vertex.
+ * @param relax The relaxation loop.
+ * @param ws A workspace created for `csr->nb_vertices` vertices.
+ */
+void dijkstra_csr(const graph_csr_s *csr, int src, relax_e relax, workspace_s *ws) {
+  assert(csr!=NULL && ws!=NULL && ws->nb_vertices >= csr->nb_vertices);
+  assert(src >= 0 && src < csr->nb_vertices);
+  workspace_reset(ws);
+  workspace_push(ws, src, 0.0, -1);
+  if (relax == RELAX_PREFETCH) relax_prefetch(csr, ws);
+  else relax_plain(csr, ws);
+}
+
+/**
+ * @brief Computes the distances from all the vertices to a target (many-to-one).
+ *
+ * An edge (u, v) of the graph is the edge (v, u) of the transpose: settling u from v
+ * backward makes v the next vertex of u toward the target.
+ *
+ * @param transpose The transpose of the CSR graph, or the graph itself if it is undirected.
+ * @param dst The target vertex.
+ * @param relax The relaxation loop.
+ * @param ws A workspace created for `transpose->nb_vertices` vertices.
+ */
+void dijkstra_csr_to(const graph_csr_s *transpose, int dst, relax_e relax, workspace_s *ws) {
+  dijkstra_csr(transpose, dst, relax, ws);
+}
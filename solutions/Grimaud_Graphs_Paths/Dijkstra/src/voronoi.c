@@ -0,0 +1,90 @@
+/**
+ * @file voronoi.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Multi-source Dijkstra and graph Voronoi partitioning.
+ *
+ * The seeds are all pushed in the heap with a null distance. The nearest seed of a
+ * vertex is inherited from its predecessor when the vertex is settled: since the
+ * predecessor was settled before, its nearest seed is already known.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <assert.h>
+#include "voronoi.h"
+#include "heap.h"
+
+/**
+ * @brief Performs Dijkstra's algorithm from several seed vertices at once.
+ *
+ * @param g The graph.
+ * @param seeds Array of seed vertices.
+ * @param nb_seeds Number of seed vertices.
+ * @param nearest Array filled with the nearest seed of each vertex, may be NULL.
+ * @return An array of vertices with the shortest path information.
+ */
+vertex_s *dijkstra_multi(graph_s *g, const int *seeds, int nb_seeds, int *nearest) {
+  assert(g!=NULL && (seeds!=NULL || nb_seeds==0));
+  int nb_vertices = g->nb_vertices;
+  vertex_s *dist = malloc(nb_vertices*sizeof(vertex_s));
+  assert(dist!=NULL);
+  bool *visited_vertices = malloc(nb_vertices*sizeof(bool));
+  int *seed_of = malloc(nb_vertices*sizeof(int));
+  assert(visited_vertices!=NULL && seed_of!=NULL);
+  for (int i = 0; i < nb_vertices; i++) {
+    visited_vertices[i] = false;
+    seed_of[i] = -1;
+    dist[i].ind = i;
+    dist[i].weight = INFINITY;
+    dist[i].prev = -1;
+  }
+  // All the seeds start at distance 0 in the same heap
+  heap_s *q = heap_create(nb_vertices);
+  for (int i = 0; i < nb_seeds; i++) {
+    assert(seeds[i] >= 0 && seeds[i] < nb_vertices);
+    vertex_s s = {.ind = seeds[i], .weight = 0.0, .prev = -1};
+    q = heap_add(s, q);
+  }
+  while (!heap_empty(q)) {
+    vertex_s v = heap_peek(q);
+    q = heap_remove(q);
+    if (visited_vertices[v.ind]) continue;
+    visited_vertices[v.ind] = true;
+    dist[v.ind].weight = v.weight;
+    dist[v.ind].prev = v.prev;
+    // A seed is its own nearest seed, other vertices inherit it from their predecessor
+    seed_of[v.ind] = (v.prev == -1) ? v.ind : seed_of[v.prev];
+    for (adj_list_s *adj = get_adj_list(g, v.ind); adj != NULL; adj = adj->next) {
+      double new_weight = v.weight + adj->vertex.weight;
+      if (!visited_vertices[adj->vertex.ind] && new_weight < dist[adj->vertex.ind].weight) {
+        vertex_s tmp = {.ind = adj->vertex.ind, .weight = new_weight, .prev = v.ind};
+        q = heap_add(tmp, q);
+      }
+    }
+  }
+  if (nearest != NULL)
+    for (int i = 0; i < nb_vertices; i++)
+      nearest[i] = seed_of[i];
+  // Clean up
+  heap_delete(q);
+  free(seed_of);
+  free(visited_vertices);
+  return dist;
+}
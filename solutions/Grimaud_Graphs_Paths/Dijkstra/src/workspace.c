@@ -0,0 +1,139 @@
+/**
+ * @file workspace.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Reusable workspace for repeated Dijkstra searches.
+ *
+ * The arrays of the workspace are never cleared: a value is only meaningful if it
+ * has been stamped with the epoch of the current search. When the epoch counter
+ * wraps around, the stamps are cleared once.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "workspace.h"
+#include "numa_alloc.h"
+
+/**
+ * @brief Creates a workspace for graphs of a given number of vertices.
+ *
+ * @param nb_vertices Number of vertices of the graphs.
+ * @return Pointer to the created workspace.
+ */
+workspace_s *workspace_create(int nb_vertices) {
+  workspace_s *ws = malloc(sizeof(workspace_s));
+  assert(ws!=NULL);
+  ws->nb_vertices = nb_vertices;
+  ws->epoch = 0;
+  // large random access arrays: huge pages on the node of the first search
+  ws->reached = numa_alloc_local(nb_vertices*sizeof(unsigned int));
+  ws->settled = numa_alloc_local(nb_vertices*sizeof(unsigned int));
+  ws->dist = numa_alloc_local(nb_vertices*sizeof(double));
+  ws->prev = numa_alloc_local(nb_vertices*sizeof(int));
+  ws->settled_list = numa_alloc_local(nb_vertices*sizeof(vertex_s));
+  assert(ws->reached!=NULL && ws->settled!=NULL && ws->dist!=NULL);
+  assert(ws->prev!=NULL && ws->settled_list!=NULL);
+  ws->q = heap_create(nb_vertices);
+  ws->nb_settled = 0;
+  return ws;
+}
+
+/**
+ * @brief Prepares the workspace for a new search.
+ *
+ * @param ws Pointer to the workspace.
+ */
+void workspace_reset(workspace_s *ws) {
+  assert(ws!=NULL);
+  ws->q = heap_clear(ws->q);
+  ws->nb_settled = 0;
+  ws->epoch++;
+  if (ws->epoch == 0) { // the counter wrapped around, forget all the stamps once
+    memset(ws->reached, 0, ws->nb_vertices*sizeof(unsigned int));
+    memset(ws->settled, 0, ws->nb_vertices*sizeof(unsigned int));
+    ws->epoch = 1;
+  }
+}
+
+/**
+ * @brief Deletes a workspace and frees its memory.
+ *
+ * @param ws Pointer to the workspace.
+ */
+void workspace_delete(workspace_s *ws) {
+  if (!ws) return;
+  heap_delete(ws->q);
+  numa_free(ws->reached, ws->nb_vertices*sizeof(unsigned int));
+  numa_free(ws->settled, ws->nb_vertices*sizeof(unsigned int));
+  numa_free(ws->dist, ws->nb_vertices*sizeof(double));
+  numa_free(ws->prev, ws->nb_vertices*sizeof(int));
+  numa_free(ws->settled_list, ws->nb_vertices*sizeof(vertex_s));
+  free(ws);
+}
+
+/**
+ * @brief Records a tentative distance and predecessor for a vertex and pushes it in the heap.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Index of the vertex.
+ * @param weight Tentative distance of the vertex.
+ * @param prev Predecessor of the vertex (-1 for the source).
+ */
+void workspace_push(workspace_s *ws, int v, double weight, int prev) {
+  if (workspace_is_settled(ws, v) || weight >= workspace_dist(ws, v)) return;
+  ws->reached[v] = ws->epoch;
+  ws->dist[v] = weight;
+  ws->prev[v] = prev;
+  vertex_s tmp = {.ind = v, .weight = weight, .prev = prev};
+  ws->q = heap_add(tmp, ws->q);
+}
+
+/**
+ * @brief Records a tentative distance for a vertex and pushes it in the heap with another key.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Index of the vertex.
+ * @param weight Tentative distance of the vertex.
+ * @param key Key of the vertex in the heap.
+ * @param prev Predecessor of the vertex (-1 for the source).
+ */
+void workspace_push_keyed(workspace_s *ws, int v, double weight, double key, int prev) {
+  if (workspace_is_settled(ws, v) || weight >= workspace_dist(ws, v)) return;
+  ws->reached[v] = ws->epoch;
+  ws->dist[v] = weight;
+  ws->prev[v] = prev;
+  vertex_s tmp = {.ind = v, .weight = key, .prev = prev};
+  ws->q = heap_add(tmp, ws->q);
+}
+
+/**
+ * @brief Pops the closest unsettled vertex and settles it.
+ *
+ * @param ws Pointer to the workspace.
+ * @param v Address where the settled vertex is stored.
+ * @return false if no vertex remains to visit.
+ */
+bool workspace_pop(workspace_s *ws, vertex_s *v) {
+  if (heap_empty(ws->q)) return false;
+  *v = heap_peek(ws->q);
+  ws->q = heap_remove(ws->q);
+  ws->settled[v->ind] = ws->epoch;
+  ws->settled_list[ws->nb_settled++] = *v;
+  return true;
+}
@@ -96,6 +96,22 @@ void delete_graph(graph_s *g);
  */
 adj_list_s *get_adj_list(graph_s *g, int ind);
 
+/**
+ * @brief Iterates over the edges leaving a vertex (backend of `SSSP_ENGINE`).
+ *
+ * @param g Pointer to the graph
+ * @param u Index of the vertex
+ * @param v Name of the int variable holding the head of each edge
+ * @param w Name of the double variable holding the weight of each edge
+ * @param ... The statement executed for each edge
+ */
+#define GRAPH_LIST_FOREACH_EDGE(g, u, v, w, ...)                                     \
+  for (adj_list_s *adj_ = (g)->adj_lists[u]; adj_ != NULL; adj_ = adj_->next) {     \
+    int v = adj_->vertex.ind;                                                       \
+    double w = adj_->vertex.weight;                                                 \
+    __VA_ARGS__                                                                     \
+  }
+
 /**
  * @brief Prints the details of the graph to the standard output.
  * 
@@ -99,7 +99,7 @@ heap_s *heap_create(int nb_inds) {
 }
 
 bool check_heap(heap_s *h) {
-  if(h->nb_elements>=h->max_elements) return false;
+  if(h->nb_elements>h->max_elements) return false;
   for(int i=0;i<h->nb_elements;i++)
     if(h->inds[h->array[i].ind]!=i) return false;
   return true;
@@ -132,8 +132,13 @@ heap_s *heap_add(vertex_s vertex, heap_s *heap) {
     } 
   } else {
     int i=heap->inds[vertex.ind];
-    if(vertex.weight < heap->array[i].weight)
+    if(vertex.weight < heap->array[i].weight) {
       heap->array[i]=vertex;
+      while(i>0 && heap->array[i].weight < heap->array[(i-1)/2].weight) {
+        swap(heap,i,(i-1)/2); // decrease-key: restore the heap property
+        i=(i-1)/2;
+      }
+    }
   } 
   assert(check_heap(heap));
   return heap;
@@ -150,6 +155,17 @@ bool heap_empty(heap_s *heap) {
   return heap->nb_elements==0;
 }
 
+/** 
+ * @brief Gets the number of elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The number of elements.
+ * @note Asserts that the heap is created.
+ */
+int heap_size(heap_s *heap) {
+  assert(heap!=NULL);
+  return heap->nb_elements;
+}
+
 /** 
  * @brief Reads the head element without removing it.
  * @param heap The address of the current heap.
@@ -161,6 +177,18 @@ vertex_s heap_peek(heap_s *heap) {
   return heap->array[0];
 }
 
+/** 
+ * @brief Hints the processor that the entry of a vertex will be accessed soon.
+ *
+ * Prefetches the position of the vertex in the heap array, read by `heap_add`.
+ *
+ * @param heap The address of the current heap.
+ * @param ind The index of the vertex.
+ */
+void heap_prefetch(heap_s *heap, int ind) {
+  __builtin_prefetch(&heap->inds[ind]);
+}
+
 /**
  * @brief Removes the root element from the heap.
  * 
@@ -175,9 +203,15 @@ vertex_s heap_peek(heap_s *heap) {
 heap_s *heap_remove(heap_s *heap) {
   assert(heap!=NULL);
   assert(check_heap(heap));
-  heap->array[0]=heap->array[heap->nb_elements-1];
-  heap->inds[heap->array[0].ind]=0;
+  assert(heap->nb_elements>0);
+  heap->inds[heap->array[0].ind]=-1; // the removed vertex may be added again later
   heap->nb_elements--;
+  if (heap->nb_elements==0) {
+    assert(check_heap(heap));
+    return heap;
+  }
+  heap->array[0]=heap->array[heap->nb_elements];
+  heap->inds[heap->array[0].ind]=0;
   int i=0; // index of the actual tree node
   while (i<heap->nb_elements) {
     int left_index = i*2+1;
@@ -196,6 +230,20 @@ heap_s *heap_remove(heap_s *heap) {
   return heap;
 }
 
+/** 
+ * @brief Removes all the elements of the heap.
+ * @param heap The address of the current heap.
+ * @return The address of the updated heap.
+ * @note The cost is proportional to the number of elements left in the heap.
+ */
+heap_s *heap_clear(heap_s *heap) {
+  assert(heap!=NULL);
+  for(int i=0;i<heap->nb_elements;i++)
+    heap->inds[heap->array[i].ind]=-1;
+  heap->nb_elements=0;
+  return heap;
+}
+
 /** 
  * @brief Prints the heap elements from the head to the last element.
  * @param heap The address of the current heap.
@@ -42,9 +42,18 @@
 #include <assert.h>
 #include "graph_list.h"
 #include "heap.h"
+#include "implicit_graph.h"
+#include "sssp_engine.h"
 
 #define EPSILON 1e-6 // Tolerance for floating-point comparisons
 
+/** @brief Cost of a transition of probability p: the most probable path is the shortest. */
+#define MARKOV_COST(p) (-log(p))
+
+// The Dijkstra engine specialized for each graph backend
+SSSP_ENGINE(markov_list, graph_s *, GRAPH_LIST_FOREACH_EDGE, MARKOV_COST)
+SSSP_ENGINE(markov_implicit, implicit_graph_s *, IMPLICIT_GRAPH_FOREACH_EDGE, MARKOV_COST)
+
 /**
  * @brief Verifies whether a graph satisfies Markov chain properties.
  * 
@@ -99,59 +108,46 @@ bool check_markov(graph_s *g) {
  * - The computed probability (logarithmic scale for intermediate calculations).
  * - The predecessor vertex for reconstructing the path.
  * 
+ * The search is the generic engine (see `sssp_engine.h`) on the adjacency lists,
+ * with the cost -log(p) for a transition of probability p.
+ *
  * @param g Pointer to the graph structure.
  * @param src The source vertex.
  * @return A dynamically allocated array of `vertex_s` containing the results.
  */
 vertex_s *dijkstra_markov(graph_s *g, int src) {
-  // Allocate memory for the result array dist
-  int nb_vertices = g->nb_vertices;
-  vertex_s *dist = malloc(nb_vertices*sizeof(vertex_s));
-  assert(dist!=NULL);
-  // Create an array of visited vertices and setup dist
-  bool visited_vertices[nb_vertices];
-  for (int i = 0; i < nb_vertices; i++) {
-    visited_vertices[i] = false;
-    dist[i].ind = i;
-    dist[i].weight = 0.0;
-    dist[i].prev = -1;
-  }
-  // Create a heap to record the next vertex to visit
-  heap_s *q = heap_create(nb_vertices);
-  // Start with the source vertex
-  dist[src].weight=1.0;
-  q = heap_add(dist[src], q);
-  // While it remains vertices to visit
-  while (!heap_empty(q)) {
-    // Dequeue the the highest priority vertex
-    vertex_s v = heap_peek(q);
-    q = heap_remove(q);
-    v.weight = exp(-v.weight);
-    if (!visited_vertices[v.ind]) {
-      // Mark the current vertex as visited and update dist
-      visited_vertices[v.ind] = true;
-      dist[v.ind].weight = v.weight;
-      dist[v.ind].prev = v.prev;
-      // Process all adjacent vertices
-      adj_list_s *adj = get_adj_list(g, v.ind);
-      while (adj != NULL) {
-	// Calculate new weight and update if it's smaller
-	double new_weight =  v.weight * adj->vertex.weight;
-	if (new_weight > dist[adj->vertex.ind].weight) {
-	  vertex_s tmp = {.ind = adj->vertex.ind,
-			  .weight=-log(new_weight),
-			  .prev=v.ind};
-	  q = heap_add(tmp,q);
-	}
-      adj = adj->next;
-      }
-    }
-  } 
-  // Clean up
-  heap_delete(q);
+  vertex_s *dist = markov_list(g, src, -1);
+  // Convert the sums of -log(p) back to probabilities (0 for the unreachable vertices)
+  for (int i = 0; i < g->nb_vertices; i++)
+    dist[i].weight = exp(-dist[i].weight);
   return dist;
 }
 
+/**
+ * @brief Generates the transitions of the counter chain, a Markov chain given by a callback.
+ *
+ * The state is a counter between 0 and n-1 (n being stored in the context). From
+ * the state k, the counter is incremented with probability 0.5, doubled with
+ * probability 0.3 and reset to 0 with probability 0.2 (a move leaving the states
+ * keeps the counter unchanged instead).
+ *
+ * @param ctx Pointer to the number of states n.
+ * @param k The current state.
+ * @param heads Array where the next states are written.
+ * @param weights Array where the probabilities of the transitions are written.
+ * @return The number of transitions.
+ */
+int counter_chain(void *ctx, int k, int *heads, double *weights) {
+  int n = *(int *)ctx;
+  heads[0] = (k + 1 < n) ? k + 1 : k;
+  weights[0] = 0.5;
+  heads[1] = (k < n / 2) ? 2 * k : k;
+  weights[1] = 0.3;
+  heads[2] = 0;
+  weights[2] = 0.2;
+  return 3;
+}
+
 /**
  * @brief Prints the most probable path as a sentence of states or transitions.
  * 
@@ -200,8 +196,12 @@ void print_help(char *prog_name) {
   printf("  -v, --vertices <number> Specify the number of vertices\n");
   printf("  -a, --adjacencies       Specify the adjacency list in the format \"src:dst1,dst2 ...\"\n");
   printf("  -s, --start             Specify the start vertex for Dijkstra (default: 0)\n");
+  printf("  -t, --target <vertex>   Specify the target state of the counter chain\n");
+  printf("      --implicit <n>      Find the most probable path in the counter chain over n states, its\n");
+  printf("                          transitions being generated by a callback\n");
   printf("\nExamples:\n");
   printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" -s 3\n",prog_name);
+  printf("  %s --implicit 10000 -s 1 -t 9999\n",prog_name);
   printf("  %s --vertices 5 --adjancencies \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0\" --directed\n",prog_name);
 }
 
@@ -227,6 +227,8 @@ int main(int argc, char **argv) {
   char *edges_list = NULL;
   bool directed = false;
   int start_vertex = 0; // Default start vertex
+  int target_vertex = -1;
+  int implicit_states = 0;
   
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -255,7 +257,42 @@ int main(int argc, char **argv) {
 	fprintf(stderr, "Error: Missing argument for --start\n");
 	return 1;
       }
+    } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--target") == 0) {
+      if (i + 1 < argc) {
+        target_vertex = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --target\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--implicit") == 0) {
+      if (i + 1 < argc) {
+        implicit_states = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --implicit\n");
+        return 1;
+      }
+    }
+  }
+  if (implicit_states > 0) {
+    // Most probable path in the counter chain, never built as a graph
+    if (start_vertex < 0 || start_vertex >= implicit_states || target_vertex < 0 || target_vertex >= implicit_states) {
+      fprintf(stderr, "Error: --implicit requires valid --start and --target states\n");
+      return 1;
+    }
+    implicit_graph_s *ig = implicit_graph_create(implicit_states, 3, counter_chain, &implicit_states);
+    vertex_s *dst = markov_implicit(ig, start_vertex, target_vertex);
+    printf("Counter chain over %d states, from %d to %d: ", implicit_states, start_vertex, target_vertex);
+    if (dst[target_vertex].weight == INFINITY) {
+      printf("unreachable\n");
+    } else {
+      int nb_steps = 0;
+      for (int v = target_vertex; dst[v].prev != -1; v = dst[v].prev)
+        nb_steps++;
+      printf("probability %g in %d steps\n", exp(-dst[target_vertex].weight), nb_steps);
     }
+    free(dst);
+    implicit_graph_delete(ig);
+    return 0;
   }
   if (vertices == 0 || edges_list == NULL) {
     fprintf(stderr, "Error: --vertices and --adjacencies are required\n\n");
@@ -40,6 +40,7 @@
 #define GRAPH_MATRIX_H
 
 #include <stdbool.h>
+#include "thread_pool.h"
 
 /**
  * @brief Structure representing a graph.
@@ -51,8 +52,12 @@ typedef struct graph {
   double **adj_matrix; /**< Adjacency matrix representing the graph */
   double **dist;       /**< Distance matrix used to compute shortest paths lengths via Floyd-Warshall algorithm */
   int **parent;        /**< Parent matrix used to reconstruct shortest paths */
+  int row_block;       /**< Rows are allocated by blocks of row_block rows on NUMA nodes (0: one malloc per row) */
 } graph_s;
 
+/** @brief Number of rows of the blocks allocated by `create_graph_parallel`. */
+#define GRAPH_ROW_BLOCK 64
+
 
 /**
  * @brief Structure representing an edge in the graph.
@@ -75,6 +80,22 @@ typedef struct edge {
  */
 graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edges);
 
+/**
+ * @brief Create a graph, allocating and initializing the rows of the matrices in parallel.
+ *
+ * The rows are allocated by blocks of `GRAPH_ROW_BLOCK` rows. The block b is owned by
+ * the worker b % nb_workers: it is allocated by a task submitted to this worker, on
+ * the memory node of the processor running it (see `numa_alloc.h`).
+ *
+ * @param nb_vertices Number of vertices in the graph.
+ * @param nb_edges Number of edges in the graph.
+ * @param directed Indicates if the graph is directed.
+ * @param edges Array of edges to initialize the graph.
+ * @param pool The thread pool (NULL for a sequential execution).
+ * @return Pointer to the created graph.
+ */
+graph_s *create_graph_parallel(int nb_vertices, int nb_edges, bool directed, edge_s *edges, thread_pool_s *pool);
+
 /**
  * @brief Delete a graph and free its resources.
  *
@@ -0,0 +1,137 @@
+/**
+ * @file thread_pool.h
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Work-stealing thread pool shared by the graph engines.
+ *
+ * This file declares a task scheduler with a configurable number of worker
+ * threads, optionally pinned to processors. Each worker owns a double-ended queue
+ * of tasks: it pushes and pops its own tasks at the bottom, while idle workers
+ * steal tasks at the top of the queues of the others. Tasks are gathered in task
+ * groups that can be waited for; a worker waiting for a group keeps executing
+ * tasks, so parallel loops may be nested.
+ *
+ * A program creates one pool (from its `--threads` option) and hands it to every
+ * engine, so that several engines running in the same process never create more
+ * threads than requested.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+
+/**
+ * @struct thread_pool_s
+ * @brief Structure of the thread pool.
+ */
+typedef struct thread_pool thread_pool_s;
+
+/**
+ * @brief Structure representing a group of tasks that can be waited for.
+ *
+ * A task group must be initialized with `TASK_GROUP_INIT` before its first use.
+ */
+typedef struct {
+  int pending; /**< Number of tasks of the group not yet completed */
+} task_group_s;
+
+/** @brief Initializer of an empty task group. */
+#define TASK_GROUP_INIT {0}
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * @param nb_workers Number of worker threads (at least 1).
+ * @param pin Pins the worker i to the processor i (modulo the number of processors).
+ * @return Pointer to the created pool.
+ */
+thread_pool_s *thread_pool_create(int nb_workers, bool pin);
+
+/**
+ * @brief Waits for the workers to finish and deletes the pool.
+ *
+ * @param pool Pointer to the pool.
+ */
+void thread_pool_delete(thread_pool_s *pool);
+
+/**
+ * @brief Gets the number of worker threads of a pool.
+ *
+ * @param pool Pointer to the pool (NULL stands for a sequential execution).
+ * @return The number of workers (1 if pool is NULL).
+ */
+int thread_pool_size(const thread_pool_s *pool);
+
+/**
+ * @brief Gets the index of the calling worker.
+ *
+ * @return The index of the worker in its pool, or -1 if the caller is not a worker.
+ */
+int thread_pool_worker_id(void);
+
+/**
+ * @brief Submits a task to the pool.
+ *
+ * @param pool Pointer to the pool (if NULL, the task is executed immediately).
+ * @param group The group of the task.
+ * @param fn The function of the task.
+ * @param arg The argument given to the function.
+ */
+void thread_pool_submit(thread_pool_s *pool, task_group_s *group, void (*fn)(void *), void *arg);
+
+/**
+ * @brief Submits a task to the queue of a given worker.
+ *
+ * The worker executes the tasks of its own queue first, so the task usually runs on
+ * this worker (and on its processor when the workers are pinned); an idle worker may
+ * still steal it.
+ *
+ * @param pool Pointer to the pool (if NULL, the task is executed immediately).
+ * @param worker Index of the worker (modulo the number of workers).
+ * @param group The group of the task.
+ * @param fn The function of the task.
+ * @param arg The argument given to the function.
+ */
+void thread_pool_submit_to(thread_pool_s *pool, int worker, task_group_s *group, void (*fn)(void *), void *arg);
+
+/**
+ * @brief Waits for all the tasks of a group to complete.
+ *
+ * @param pool Pointer to the pool.
+ * @param group The group of tasks.
+ */
+void thread_pool_wait(thread_pool_s *pool, task_group_s *group);
+
+/**
+ * @brief Executes a loop in parallel.
+ *
+ * The range [begin, end) is split into chunks of `grain` iterations and `body` is
+ * called once per chunk, with the bounds of the chunk.
+ *
+ * @param pool Pointer to the pool (if NULL, the loop is executed sequentially).
+ * @param begin The first iteration.
+ * @param end The iteration after the last one.
+ * @param grain The number of iterations per chunk (at least 1).
+ * @param body The function executing the iterations [lo, hi).
+ * @param arg The argument given to the function.
+ */
+void thread_pool_parallel_for(thread_pool_s *pool, int begin, int end, int grain,
+                              void (*body)(int lo, int hi, void *arg), void *arg);
+
+#endif // THREAD_POOL_H
@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include "graph_matrix.h"
+#include "numa_alloc.h"
 
 /**
  * @brief Creates a graph.
@@ -58,6 +59,7 @@ graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edge
   g->nb_vertices = nb_vertices;
   g->nb_edges = nb_edges;
   g->directed = directed;
+  g->row_block = 0;
 
   g->adj_matrix = (double **)malloc(nb_vertices * sizeof(double *));
   g->dist = (double **)malloc(nb_vertices * sizeof(double *));
@@ -91,12 +93,127 @@ graph_s *create_graph(int nb_vertices, int nb_edges, bool directed, edge_s *edge
   return g;
 }
 
+/**
+ * @brief Structure describing the task building a block of rows.
+ */
+typedef struct {
+  graph_s *g;    /**< The graph being built */
+  int block;     /**< Index of the block of rows */
+  bool *failed;  /**< Set when a memory allocation fails (atomic) */
+} graph_build_s;
+
+/**
+ * @brief Allocates the rows of a block on the node of the calling worker and initializes them.
+ */
+static void build_block(void *arg) {
+  graph_build_s *b = arg;
+  graph_s *g = b->g;
+  int nb_vertices = g->nb_vertices;
+  int lo = b->block * GRAPH_ROW_BLOCK;
+  int hi = (lo + GRAPH_ROW_BLOCK < nb_vertices) ? lo + GRAPH_ROW_BLOCK : nb_vertices;
+  size_t nb_cells = (size_t)(hi - lo) * nb_vertices;
+  int node = numa_current_node();
+  double *adj_rows = numa_alloc_onnode(nb_cells * sizeof(double), node);
+  double *dist_rows = numa_alloc_onnode(nb_cells * sizeof(double), node);
+  int *parent_rows = numa_alloc_onnode(nb_cells * sizeof(int), node);
+  g->adj_matrix[lo] = adj_rows;
+  g->dist[lo] = dist_rows;
+  g->parent[lo] = parent_rows;
+  if (!adj_rows || !dist_rows || !parent_rows) {
+    __atomic_store_n(b->failed, true, __ATOMIC_RELAXED);
+    return;
+  }
+  for (int i = lo; i < hi; i++) {
+    g->adj_matrix[i] = adj_rows + (size_t)(i - lo) * nb_vertices;
+    g->dist[i] = dist_rows + (size_t)(i - lo) * nb_vertices;
+    g->parent[i] = parent_rows + (size_t)(i - lo) * nb_vertices;
+    // first touch of the pages by the owner
+    for (int j = 0; j < nb_vertices; j++) {
+      g->adj_matrix[i][j] = (i == j) ? 0 : INFINITY;
+      g->dist[i][j] = INFINITY;
+      g->parent[i][j] = -1;
+    }
+  }
+}
+
+/**
+ * @brief Creates a graph, allocating and initializing the rows of the matrices in parallel.
+ * 
+ * The block of rows b is allocated by a task submitted to the worker b % nb_workers,
+ * on the memory node of this worker.
+ * 
+ * @param nb_vertices Number of vertices in the graph
+ * @param nb_edges Number of edges in the graph
+ * @param directed Boolean indicating if the graph is directed
+ * @param edges Array of edges in the graph
+ * @param pool The thread pool (NULL for a sequential execution)
+ * 
+ * @return Pointer to the created graph
+ */
+graph_s *create_graph_parallel(int nb_vertices, int nb_edges, bool directed, edge_s *edges, thread_pool_s *pool) {
+  graph_s *g = (graph_s *)malloc(sizeof(graph_s));
+  if (!g) return NULL; // Memory allocation failed
+  
+  g->nb_vertices = nb_vertices;
+  g->nb_edges = nb_edges;
+  g->directed = directed;
+  g->row_block = GRAPH_ROW_BLOCK;
+
+  g->adj_matrix = (double **)calloc(nb_vertices, sizeof(double *));
+  g->dist = (double **)calloc(nb_vertices, sizeof(double *));
+  g->parent = (int **)calloc(nb_vertices, sizeof(int *));
+  if (!g->adj_matrix || !g->dist || !g->parent) {
+    delete_graph(g);
+    return NULL;
+  }
+
+  int nb_blocks = (nb_vertices + GRAPH_ROW_BLOCK - 1) / GRAPH_ROW_BLOCK;
+  graph_build_s *blocks = malloc((nb_blocks + 1) * sizeof(graph_build_s));
+  if (!blocks) {
+    delete_graph(g);
+    return NULL;
+  }
+  bool failed = false;
+  task_group_s group = TASK_GROUP_INIT;
+  for (int b = 0; b < nb_blocks; b++) {
+    blocks[b] = (graph_build_s){.g = g, .block = b, .failed = &failed};
+    thread_pool_submit_to(pool, b, &group, build_block, &blocks[b]);
+  }
+  thread_pool_wait(pool, &group);
+  free(blocks);
+  if (__atomic_load_n(&failed, __ATOMIC_RELAXED)) {
+    delete_graph(g);
+    return NULL;
+  }
+
+  // Initialize weights
+  for (int i = 0; i < nb_edges; i++) {
+    g->adj_matrix[edges[i].src][edges[i].dst] = edges[i].weight;
+    if (!directed) {
+      g->adj_matrix[edges[i].dst][edges[i].src] = edges[i].weight;
+    }
+  }
+
+  return g;
+}
+
 /**
  * @brief Deletes a graph and frees its memory.
  * 
  * @param g Pointer to the graph to be deleted
  */
 void delete_graph(graph_s *g) {
+  if (g && g->row_block > 0) {
+    // rows allocated by blocks, the first row of a block is the address of the block
+    for (int i = 0; i < g->nb_vertices; i += g->row_block) {
+      int nb_rows = (i + g->row_block < g->nb_vertices) ? g->row_block : g->nb_vertices - i;
+      size_t nb_cells = (size_t)nb_rows * g->nb_vertices;
+      if(g->adj_matrix) numa_free(g->adj_matrix[i], nb_cells * sizeof(double));
+      if(g->dist)       numa_free(g->dist[i], nb_cells * sizeof(double));
+      if(g->parent)     numa_free(g->parent[i], nb_cells * sizeof(int));
+    }
+    g->nb_vertices = 0; // rows already freed
+  }
   if (g) {
     for (int i = 0; i < g->nb_vertices; i++) {
       if(g->adj_matrix && g->adj_matrix[i]) free(g->adj_matrix[i]);
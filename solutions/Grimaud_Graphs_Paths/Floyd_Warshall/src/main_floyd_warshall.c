@@ -42,7 +42,13 @@
 #include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <unistd.h>
 #include "graph_matrix.h"
+#include "thread_pool.h"
+#include "numa_alloc.h"
+
+/** @brief Size of the square tiles of the blocked Floyd-Warshall algorithm (a block of rows). */
+#define FW_BLOCK GRAPH_ROW_BLOCK
 
 /**
  * @brief Applies the Floyd-Warshall algorithm to find shortest paths between all pairs of vertices.
@@ -95,6 +101,140 @@ bool floyd_warshall(graph_s *g) {
   return true;
 }
 
+/**
+ * @brief Structure describing a task of the blocked Floyd-Warshall algorithm.
+ */
+typedef struct {
+  graph_s *g;    /**< The graph */
+  int nb_blocks; /**< Number of tiles per row (and per column) */
+  int kb;        /**< Index of the pivot tile row and column */
+  int ib;        /**< Row index of the tiles */
+  int jb;        /**< Column index of the tile, -1 for all the tiles of the row but the pivot one */
+} fw_task_s;
+
+/**
+ * @brief Relaxes the tile (ib, jb) through the intermediate vertices of the pivot tile kb.
+ *
+ * @param g The graph.
+ * @param kb Index of the pivot tile.
+ * @param ib Row index of the tile.
+ * @param jb Column index of the tile.
+ */
+static void fw_tile(graph_s *g, int kb, int ib, int jb) {
+  int nb_vertices = g->nb_vertices;
+  double **dist = g->dist;
+  int **parent = g->parent;
+  int k_end = (kb + 1) * FW_BLOCK < nb_vertices ? (kb + 1) * FW_BLOCK : nb_vertices;
+  int v_end = (ib + 1) * FW_BLOCK < nb_vertices ? (ib + 1) * FW_BLOCK : nb_vertices;
+  int w_end = (jb + 1) * FW_BLOCK < nb_vertices ? (jb + 1) * FW_BLOCK : nb_vertices;
+  for (int k = kb * FW_BLOCK; k < k_end; k++) {
+    for (int v = ib * FW_BLOCK; v < v_end; v++) {
+      double dist_vk = dist[v][k];
+      if (dist_vk == INFINITY) continue;
+      for (int w = jb * FW_BLOCK; w < w_end; w++) {
+	double new_distance = dist_vk + dist[k][w];
+	if (new_distance < dist[v][w]) {
+	  dist[v][w] = new_distance;
+	  parent[v][w] = parent[k][w];
+	}
+      }
+    }
+  }
+}
+
+/**
+ * @brief Initializes the distance and parent matrices on the block of rows ib.
+ */
+static void fw_init_block(void *arg) {
+  fw_task_s *t = arg;
+  graph_s *g = t->g;
+  int v_end = (t->ib + 1) * FW_BLOCK < g->nb_vertices ? (t->ib + 1) * FW_BLOCK : g->nb_vertices;
+  for (int v = t->ib * FW_BLOCK; v < v_end; v++) {
+    for (int w = 0; w < g->nb_vertices; w++) {
+      g->dist[v][w] = g->adj_matrix[v][w];
+      g->parent[v][w] = (g->adj_matrix[v][w] != INFINITY) ? v : -1;
+    }
+  }
+}
+
+/**
+ * @brief Relaxes the tile (ib, jb), or all the tiles of the row ib but the pivot one if jb is -1.
+ */
+static void fw_tiles(void *arg) {
+  fw_task_s *t = arg;
+  if (t->jb >= 0) {
+    fw_tile(t->g, t->kb, t->ib, t->jb);
+    return;
+  }
+  for (int jb = 0; jb < t->nb_blocks; jb++) {
+    if (jb != t->kb) fw_tile(t->g, t->kb, t->ib, jb);
+  }
+}
+
+/**
+ * @brief Applies the blocked Floyd-Warshall algorithm in parallel.
+ *
+ * The matrices are cut into square tiles of `FW_BLOCK` vertices. For each pivot tile
+ * kb, the diagonal tile (kb, kb) is relaxed first, then the tiles of the pivot row and
+ * column in parallel, and finally all the other tiles in parallel. The tasks working
+ * on a block of rows are submitted to the worker owning it, whose memory node holds
+ * the rows when the graph comes from `create_graph_parallel`. The tiles relaxed
+ * during a phase only read tiles completed by the previous phases, so the distances
+ * are the ones of `floyd_warshall` (up to rounding, and ties between paths of equal
+ * length may be broken differently).
+ *
+ * @param g Pointer to the graph structure containing adjacency matrix, distance matrix, and parent matrix.
+ * @param pool The thread pool.
+ * @return `true` if no negative weight cycle is detected, `false` otherwise.
+ */
+bool floyd_warshall_parallel(graph_s *g, thread_pool_s *pool) {
+  assert(g && g->adj_matrix && g->dist && g->parent);
+
+  int nb_vertices = g->nb_vertices;
+  int nb_blocks = (nb_vertices + FW_BLOCK - 1) / FW_BLOCK;
+
+  fw_task_s *tasks = malloc(2 * nb_blocks * sizeof(fw_task_s));
+  assert(tasks);
+
+  // each task on a block of rows goes to the worker owning it (see create_graph_parallel)
+  task_group_s group = TASK_GROUP_INIT;
+  for (int ib = 0; ib < nb_blocks; ib++) {
+    tasks[ib] = (fw_task_s){.g = g, .nb_blocks = nb_blocks, .kb = -1, .ib = ib, .jb = -1};
+    thread_pool_submit_to(pool, ib, &group, fw_init_block, &tasks[ib]);
+  }
+  thread_pool_wait(pool, &group);
+
+  for (int kb = 0; kb < nb_blocks; kb++) {
+    fw_tile(g, kb, kb, kb);
+    // the tiles of the pivot row and of the pivot column
+    int nb_tasks = 0;
+    for (int i = 0; i < nb_blocks; i++) {
+      if (i == kb) continue;
+      tasks[nb_tasks] = (fw_task_s){.g = g, .nb_blocks = nb_blocks, .kb = kb, .ib = kb, .jb = i};
+      thread_pool_submit_to(pool, kb, &group, fw_tiles, &tasks[nb_tasks++]);
+      tasks[nb_tasks] = (fw_task_s){.g = g, .nb_blocks = nb_blocks, .kb = kb, .ib = i, .jb = kb};
+      thread_pool_submit_to(pool, i, &group, fw_tiles, &tasks[nb_tasks++]);
+    }
+    thread_pool_wait(pool, &group);
+    // the remaining tiles, one task per row of tiles
+    for (int ib = 0; ib < nb_blocks; ib++) {
+      tasks[ib] = (fw_task_s){.g = g, .nb_blocks = nb_blocks, .kb = kb, .ib = ib, .jb = -1};
+      if (ib != kb) thread_pool_submit_to(pool, ib, &group, fw_tiles, &tasks[ib]);
+    }
+    thread_pool_wait(pool, &group);
+  }
+  free(tasks);
+
+  // Verification of negative weight cycles
+  for (int v = 0; v < nb_vertices; v++) {
+    if (g->dist[v][v] < 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /**
  * @brief Prints the shortest path from a source vertex to a destination vertex using the parent matrix.
  * 
@@ -137,6 +277,13 @@ void print_path(graph_s *g, int src, int dst) {
   return;
 }
 
+/**
+ * @brief Prints the pages obtained for the large arrays (registered with atexit).
+ */
+void print_huge_pages_report(void) {
+  numa_report(stdout);
+}
+
 /**
  * @brief Prints the help message with usage examples.
  */
@@ -147,9 +294,14 @@ void print_help(char *prog_name) {
   printf("  -d, --directed          Specify that the graph is a directed graph (default: undirected)\n");
   printf("  -v, --vertices <number> Specify the number of vertices\n");
   printf("  -a, --adjacencies       Specify the adjacency list in the format \"src:dst1/weight1,dst2/weight2 ...\"\n");
+  printf("  -j, --threads <number>  Number of worker threads (default: number of online processors)\n");
+  printf("      --pin               Pin each worker thread to a processor\n");
+  printf("      --huge-pages <kind> Back the matrices with \"thp\" (default), \"hugetlb\" or \"none\" huge pages, and report them\n");
   printf("\nExamples:\n");
   printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\"\n", prog_name);
   printf("  %s --vertices 5 --adjacencies \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0\" --directed\n", prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" --threads 4 --pin\n", prog_name);
+  printf("  %s -v 8 -a \"0:1/1.0,2/2.0 1:2/1.5 2:3/1.0 3:5/8.1,6/5.1 5:7/0.7,4/9.1\" --huge-pages hugetlb\n", prog_name);
   return;
 }
 
@@ -168,6 +320,8 @@ int main(int argc, char **argv) {
   int vertices = 0;
   char *edges_list = NULL;
   bool directed = false;
+  int nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  bool pin_threads = false;
   
   // parse options
   for (int i = 1; i < argc; i++) {
@@ -190,8 +344,29 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Error: Missing argument for --adjacencies\n");
         return 1;
       }
+    } else if (strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--threads") == 0) {
+      if (i + 1 < argc) {
+        nb_threads = atoi(argv[++i]);
+      } else {
+        fprintf(stderr, "Error: Missing argument for --threads\n");
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--pin") == 0) {
+      pin_threads = true;
+    } else if (strcmp(argv[i], "--huge-pages") == 0) {
+      huge_pages_e mode;
+      if (i + 1 < argc && numa_parse_huge_pages(argv[i + 1], &mode)) {
+        numa_set_huge_pages(mode);
+        numa_set_report(true);
+        atexit(print_huge_pages_report);
+        i++;
+      } else {
+        fprintf(stderr, "Error: Missing or invalid argument for --huge-pages (none, thp or hugetlb)\n");
+        return 1;
+      }
     }
   }
+  if (nb_threads < 1) nb_threads = 1;
   if (vertices == 0 || edges_list == NULL) {
     fprintf(stderr, "Error: --vertices and --adjacencies are required\n\n");
     print_help(argv[0]);
@@ -265,16 +440,18 @@ int main(int argc, char **argv) {
     while (*ptr == ' ') ptr++;
   }
   
-  // create the graph_s 
-  graph_s *g = create_graph(vertices, edge_count, directed, edges);
+  // create the thread pool and the graph_s 
+  thread_pool_s *pool = thread_pool_create(nb_threads, pin_threads);
+  graph_s *g = create_graph_parallel(vertices, edge_count, directed, edges, pool);
   if (!g) {
     fprintf(stderr, "Error: Failed to create graph\n");
+    thread_pool_delete(pool);
     return 1;
   }
   print(g);
 
   // Floyd-Warshall algorithm process - beginning
-  bool has_neg_weight_cycle = !floyd_warshall(g);
+  bool has_neg_weight_cycle = (thread_pool_size(pool) > 1) ? !floyd_warshall_parallel(g, pool) : !floyd_warshall(g);
   printf("Resulting Floyd-Warshall shortest path matrix :\n");
   print_matrix(g->dist, vertices);
 
@@ -297,6 +474,7 @@ int main(int argc, char **argv) {
   
   // delete the graph_s
   delete_graph(g);
+  thread_pool_delete(pool);
   
   // that's all folk !
   return 0;
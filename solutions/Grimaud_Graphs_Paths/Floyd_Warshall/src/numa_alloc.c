@@ -0,0 +1,286 @@
+/**
+ * @file numa_alloc.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Placement and page size of large arrays (NUMA nodes, huge pages).
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "numa_alloc.h"
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000 // Linux value, for old headers
+#endif
+
+#define NUMA_MPOL_PREFERRED 1   /**< Memory policy: prefer a node (see mbind(2)) */
+#define NUMA_MPOL_INTERLEAVE 3  /**< Memory policy: interleave over nodes (see mbind(2)) */
+#define NUMA_MAX_NODES 64       /**< Maximum number of nodes handled (one word of mask) */
+
+static int nb_nodes = 0; // number of nodes, read once from /sys
+static huge_pages_e huge_pages = HUGE_PAGES_TRANSPARENT; // kind of pages of the large arrays
+static size_t hugetlb_bytes = 0;   // bytes mapped on hugetlbfs pages (atomic)
+static size_t advised_bytes = 0;   // bytes advised for transparent huge pages (atomic)
+static size_t small_bytes = 0;     // bytes of large arrays mapped on small pages (atomic)
+static size_t peak_huge_kb = 0;    // most memory seen backed by transparent huge pages (atomic)
+static bool sample_huge = false;   // whether the frees sample the huge pages for the report
+
+/**
+ * @brief Selects the kind of pages backing the arrays allocated from now on.
+ *
+ * @param mode The kind of pages.
+ */
+void numa_set_huge_pages(huge_pages_e mode) {
+  huge_pages = mode;
+}
+
+/**
+ * @brief Enables the sampling of the huge pages when large arrays are freed.
+ *
+ * @param enabled true to sample them for `numa_report`.
+ */
+void numa_set_report(bool enabled) {
+  sample_huge = enabled;
+}
+
+/**
+ * @brief Parses the name of a kind of pages ("none", "thp" or "hugetlb").
+ *
+ * @param name The name.
+ * @param mode Receives the kind of pages.
+ * @return true if the name is valid.
+ */
+bool numa_parse_huge_pages(const char *name, huge_pages_e *mode) {
+  if (strcmp(name, "none") == 0) *mode = HUGE_PAGES_NONE;
+  else if (strcmp(name, "thp") == 0) *mode = HUGE_PAGES_TRANSPARENT;
+  else if (strcmp(name, "hugetlb") == 0) *mode = HUGE_PAGES_HUGETLB;
+  else return false;
+  return true;
+}
+
+/**
+ * @brief Reads the memory of the process backed by transparent huge pages and records the peak.
+ *
+ * @return The memory currently backed by transparent huge pages, in KB.
+ */
+static size_t numa_sample_huge_kb(void) {
+  size_t anon_huge_kb = 0;
+  FILE *smaps = fopen("/proc/self/smaps_rollup", "r");
+  if (smaps) {
+    char line[256];
+    while (fgets(line, sizeof(line), smaps))
+      if (strncmp(line, "AnonHugePages:", strlen("AnonHugePages:")) == 0)
+        anon_huge_kb = strtoull(line + strlen("AnonHugePages:"), NULL, 10);
+    fclose(smaps);
+  }
+  size_t peak = __atomic_load_n(&peak_huge_kb, __ATOMIC_RELAXED);
+  while (anon_huge_kb > peak &&
+         !__atomic_compare_exchange_n(&peak_huge_kb, &peak, anon_huge_kb, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  return anon_huge_kb;
+}
+
+/**
+ * @brief Prints the amount of memory obtained with each kind of pages.
+ *
+ * The memory backed by transparent huge pages is sampled from the kernel now and,
+ * once `numa_set_report` enabled it, each time a large array is freed; its peak is
+ * reported.
+ *
+ * @param f The output stream.
+ */
+void numa_report(FILE *f) {
+  numa_sample_huge_kb();
+  fprintf(f, "Large arrays: %.1f MB on hugetlbfs pages, %.1f MB advised for transparent huge pages"
+          " (peak %.1f MB backed by huge pages), %.1f MB on small pages\n",
+          __atomic_load_n(&hugetlb_bytes, __ATOMIC_RELAXED) / 1048576.0,
+          __atomic_load_n(&advised_bytes, __ATOMIC_RELAXED) / 1048576.0,
+          __atomic_load_n(&peak_huge_kb, __ATOMIC_RELAXED) / 1024.0,
+          __atomic_load_n(&small_bytes, __ATOMIC_RELAXED) / 1048576.0);
+}
+
+/**
+ * @brief Gets the number of memory nodes of the machine.
+ *
+ * The nodes are read from `/sys/devices/system/node/online` (like "0-1").
+ *
+ * @return The number of nodes (1 if the machine is not NUMA).
+ */
+int numa_nb_nodes(void) {
+  int n = __atomic_load_n(&nb_nodes, __ATOMIC_ACQUIRE);
+  if (n > 0) return n;
+  n = 1;
+  FILE *f = fopen("/sys/devices/system/node/online", "r");
+  if (f) {
+    char line[256];
+    if (fgets(line, sizeof(line), f)) {
+      // the last number of the list is the highest node
+      char *save = NULL;
+      for (char *p = strtok_r(line, ",-\n", &save); p != NULL; p = strtok_r(NULL, ",-\n", &save)) {
+        int node = atoi(p);
+        if (node + 1 > n) n = node + 1;
+      }
+    }
+    fclose(f);
+  }
+  if (n > NUMA_MAX_NODES) n = NUMA_MAX_NODES;
+  __atomic_store_n(&nb_nodes, n, __ATOMIC_RELEASE);
+  return n;
+}
+
+/**
+ * @brief Gets the memory node of the processor running the calling thread.
+ *
+ * @return The index of the node (0 if unknown).
+ */
+int numa_current_node(void) {
+  unsigned int cpu = 0, node = 0;
+  if (numa_nb_nodes() == 1 || syscall(SYS_getcpu, &cpu, &node, NULL) != 0) return 0;
+  return (int)node < NUMA_MAX_NODES ? (int)node : 0;
+}
+
+/**
+ * @brief Gets the amount of free memory of a node.
+ *
+ * The value is read from `/sys/devices/system/node/node<i>/meminfo`.
+ *
+ * @param node The index of the node.
+ * @return The number of free bytes (0 if unknown).
+ */
+size_t numa_node_free(int node) {
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/meminfo", node);
+  FILE *f = fopen(path, "r");
+  if (!f) return 0;
+  size_t free_kb = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), f)) {
+    char *p = strstr(line, "MemFree:");
+    if (p) {
+      free_kb = strtoull(p + strlen("MemFree:"), NULL, 10);
+      break;
+    }
+  }
+  fclose(f);
+  return free_kb * 1024;
+}
+
+/**
+ * @brief Gets the size of the mapping of a large array (a whole number of huge pages).
+ */
+static size_t numa_mapping_size(size_t size) {
+  return (size + NUMA_HUGE_PAGE_SIZE - 1) & ~(NUMA_HUGE_PAGE_SIZE - 1);
+}
+
+/**
+ * @brief Maps a large array on 2 MB boundaries, with the selected kind of pages.
+ */
+static void *numa_map_pages(size_t length) {
+  if (huge_pages == HUGE_PAGES_HUGETLB) {
+    void *ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+      __atomic_add_fetch(&hugetlb_bytes, length, __ATOMIC_RELAXED);
+      return ptr;
+    }
+    // no reserved huge pages left: fall back to transparent huge pages
+  }
+  // map one more huge page, then trim the ends so that the array is aligned
+  char *raw = mmap(NULL, length + NUMA_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) return NULL;
+  char *ptr = (char *)(((uintptr_t)raw + NUMA_HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(NUMA_HUGE_PAGE_SIZE - 1));
+  if (ptr > raw) munmap(raw, ptr - raw);
+  if (raw + NUMA_HUGE_PAGE_SIZE > ptr) munmap(ptr + length, raw + NUMA_HUGE_PAGE_SIZE - ptr);
+  if (huge_pages != HUGE_PAGES_NONE && madvise(ptr, length, MADV_HUGEPAGE) == 0)
+    __atomic_add_fetch(&advised_bytes, length, __ATOMIC_RELAXED);
+  else
+    __atomic_add_fetch(&small_bytes, length, __ATOMIC_RELAXED);
+  return ptr;
+}
+
+/**
+ * @brief Allocates an array and applies a memory policy to its pages.
+ *
+ * @param size The size of the array in bytes.
+ * @param mode The memory policy, or -1 to keep the default policy (first touch).
+ * @param mask The nodes of the policy.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+static void *numa_map(size_t size, int mode, uint64_t mask) {
+  if (size < NUMA_HUGE_PAGE_SIZE) return calloc(1, size == 0 ? 1 : size);
+  size_t length = numa_mapping_size(size);
+  void *ptr = numa_map_pages(length);
+  if (ptr && mode >= 0 && numa_nb_nodes() > 1) {
+    // best effort: without the policy, the pages are placed on first touch
+    syscall(SYS_mbind, ptr, length, mode, &mask, (unsigned long)NUMA_MAX_NODES + 1, 0UL);
+  }
+  return ptr;
+}
+
+/**
+ * @brief Allocates an array whose pages are interleaved over all the nodes.
+ *
+ * @param size The size of the array in bytes.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+void *numa_alloc_interleaved(size_t size) {
+  int n = numa_nb_nodes();
+  uint64_t mask = (n >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << n) - 1);
+  return numa_map(size, NUMA_MPOL_INTERLEAVE, mask);
+}
+
+/**
+ * @brief Allocates an array whose pages are placed on a given node.
+ *
+ * @param size The size of the array in bytes.
+ * @param node The index of the node.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+void *numa_alloc_onnode(size_t size, int node) {
+  return numa_map(size, NUMA_MPOL_PREFERRED, (uint64_t)1 << (node % NUMA_MAX_NODES));
+}
+
+/**
+ * @brief Allocates an array whose pages are placed by the first thread writing them.
+ *
+ * @param size The size of the array in bytes.
+ * @return Pointer to the array (filled with zeros), NULL if the allocation failed.
+ */
+void *numa_alloc_local(size_t size) {
+  return numa_map(size, -1, 0);
+}
+
+/**
+ * @brief Frees an array allocated by one of the `numa_alloc` functions.
+ *
+ * @param ptr Pointer to the array (may be NULL).
+ * @param size The size given to the allocation.
+ */
+void numa_free(void *ptr, size_t size) {
+  if (!ptr) return;
+  if (size < NUMA_HUGE_PAGE_SIZE) {
+    free(ptr);
+    return;
+  }
+  if (sample_huge && __atomic_load_n(&advised_bytes, __ATOMIC_RELAXED) > 0) numa_sample_huge_kb();
+  munmap(ptr, numa_mapping_size(size));
+}
@@ -0,0 +1,399 @@
+/**
+ * @file thread_pool.c
+ *
+ * @author Grimaud
+ * @date 2026-10-18
+ *
+ * @brief Work-stealing thread pool shared by the graph engines.
+ *
+ * Each worker owns a double-ended queue protected by its own lock: the owner works
+ * at the bottom (last in, first out, which keeps its data in cache) and thieves
+ * take the oldest tasks at the top. A global counter of queued tasks lets idle
+ * workers sleep on a condition variable instead of spinning; threads which are not
+ * workers wait for their task groups on a second condition variable. A task submitted by
+ * a thread which is not a worker is dealt to the workers in round robin.
+ *
+ * @license
+ * This code is licensed under the GNU Lesser General Public License (LGPL).
+ * You can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this
+ * code. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "thread_pool.h"
+
+/**
+ * @brief Structure representing a task.
+ */
+typedef struct {
+  void (*fn)(void *);   /**< Function of the task */
+  void *arg;            /**< Argument of the function */
+  task_group_s *group;  /**< Group of the task */
+} task_s;
+
+/**
+ * @brief Structure representing the double-ended queue of a worker.
+ */
+typedef struct {
+  pthread_mutex_t lock; /**< Lock of the queue */
+  task_s *tasks;        /**< Circular array of tasks */
+  int capacity;         /**< Size of the circular array */
+  int top;              /**< Index of the oldest task (stolen first) */
+  int nb;               /**< Number of tasks in the queue */
+} deque_s;
+
+/**
+ * @brief Structure of a worker thread.
+ */
+typedef struct {
+  thread_pool_s *pool;  /**< Pool of the worker */
+  int id;               /**< Index of the worker in the pool */
+  pthread_t thread;     /**< Thread of the worker */
+  unsigned int seed;    /**< Seed of the choice of the victims */
+} worker_s;
+
+/**
+ * @brief Structure of the thread pool.
+ */
+struct thread_pool {
+  int nb_workers;        /**< Number of worker threads */
+  bool pin;              /**< Workers are pinned to processors */
+  worker_s *workers;     /**< Workers */
+  deque_s *deques;       /**< Queue of each worker */
+  int nb_queued;         /**< Number of tasks in all the queues (atomic) */
+  unsigned int next;     /**< Next queue receiving an external task (atomic) */
+  bool stop;             /**< Workers must stop once the queues are empty */
+  pthread_mutex_t lock;  /**< Lock of the sleeping conditions */
+  pthread_cond_t work;   /**< Idle workers sleep on it until a task is queued */
+  pthread_cond_t done;   /**< External waiters sleep on it until a group completes */
+};
+
+static _Thread_local thread_pool_s *current_pool = NULL; // pool of the calling worker
+static _Thread_local int current_id = -1;               // index of the calling worker
+
+/**
+ * @brief Pushes a task at the bottom of a queue.
+ */
+static void deque_push(deque_s *d, task_s t) {
+  pthread_mutex_lock(&d->lock);
+  if (d->nb == d->capacity) {
+    int capacity = 2 * d->capacity + 16;
+    task_s *tasks = malloc(capacity*sizeof(task_s));
+    assert(tasks!=NULL);
+    for (int i = 0; i < d->nb; i++)
+      tasks[i] = d->tasks[(d->top + i) % d->capacity];
+    free(d->tasks);
+    d->tasks = tasks;
+    d->capacity = capacity;
+    d->top = 0;
+  }
+  d->tasks[(d->top + d->nb) % d->capacity] = t;
+  d->nb++;
+  pthread_mutex_unlock(&d->lock);
+}
+
+/**
+ * @brief Pops the newest task at the bottom of a queue (owner side).
+ */
+static bool deque_pop(deque_s *d, task_s *t) {
+  bool res = false;
+  pthread_mutex_lock(&d->lock);
+  if (d->nb > 0) {
+    d->nb--;
+    *t = d->tasks[(d->top + d->nb) % d->capacity];
+    res = true;
+  }
+  pthread_mutex_unlock(&d->lock);
+  return res;
+}
+
+/**
+ * @brief Steals the oldest task at the top of a queue (thief side).
+ */
+static bool deque_steal(deque_s *d, task_s *t) {
+  bool res = false;
+  if (pthread_mutex_trylock(&d->lock) != 0) return false;
+  if (d->nb > 0) {
+    *t = d->tasks[d->top];
+    d->top = (d->top + 1) % d->capacity;
+    d->nb--;
+    res = true;
+  }
+  pthread_mutex_unlock(&d->lock);
+  return res;
+}
+
+/**
+ * @brief Finds a task for a worker: its own queue first, then the queues of the others.
+ *
+ * @param pool The pool.
+ * @param id The index of the worker, or -1 for a thread which is not a worker.
+ * @param seed The seed of the choice of the first victim.
+ * @param t Address where the task is stored.
+ * @return true if a task was found.
+ */
+static bool find_task(thread_pool_s *pool, int id, unsigned int *seed, task_s *t) {
+  if (__atomic_load_n(&pool->nb_queued, __ATOMIC_ACQUIRE) == 0) return false;
+  bool found = (id >= 0) && deque_pop(&pool->deques[id], t);
+  int first = rand_r(seed) % pool->nb_workers;
+  for (int i = 0; i < pool->nb_workers && !found; i++) {
+    int victim = (first + i) % pool->nb_workers;
+    if (victim != id) found = deque_steal(&pool->deques[victim], t);
+  }
+  if (found) __atomic_sub_fetch(&pool->nb_queued, 1, __ATOMIC_ACQ_REL);
+  return found;
+}
+
+/**
+ * @brief Executes a task and signals the completion of its group.
+ */
+static void run_task(thread_pool_s *pool, task_s *t) {
+  t->fn(t->arg);
+  if (__atomic_sub_fetch(&t->group->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->done);
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+/**
+ * @brief Main loop of a worker thread.
+ */
+static void *worker_main(void *arg) {
+  worker_s *w = arg;
+  thread_pool_s *pool = w->pool;
+  current_pool = pool;
+  current_id = w->id;
+  if (pool->pin) {
+    long nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(w->id % (nb_cpus > 0 ? nb_cpus : 1), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // best effort
+  }
+  while (true) {
+    task_s t;
+    if (find_task(pool, w->id, &w->seed, &t)) {
+      run_task(pool, &t);
+      continue;
+    }
+    pthread_mutex_lock(&pool->lock);
+    while (__atomic_load_n(&pool->nb_queued, __ATOMIC_ACQUIRE) == 0 && !pool->stop)
+      pthread_cond_wait(&pool->work, &pool->lock);
+    bool stop = pool->stop && __atomic_load_n(&pool->nb_queued, __ATOMIC_ACQUIRE) == 0;
+    pthread_mutex_unlock(&pool->lock);
+    if (stop) break;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * @param nb_workers Number of worker threads (at least 1).
+ * @param pin Pins the worker i to the processor i (modulo the number of processors).
+ * @return Pointer to the created pool.
+ */
+thread_pool_s *thread_pool_create(int nb_workers, bool pin) {
+  thread_pool_s *pool = malloc(sizeof(thread_pool_s));
+  assert(pool!=NULL);
+  pool->nb_workers = (nb_workers < 1) ? 1 : nb_workers;
+  pool->pin = pin;
+  pool->nb_queued = 0;
+  pool->next = 0;
+  pool->stop = false;
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work, NULL);
+  pthread_cond_init(&pool->done, NULL);
+  pool->deques = calloc(pool->nb_workers, sizeof(deque_s));
+  pool->workers = calloc(pool->nb_workers, sizeof(worker_s));
+  assert(pool->deques!=NULL && pool->workers!=NULL);
+  for (int i = 0; i < pool->nb_workers; i++)
+    pthread_mutex_init(&pool->deques[i].lock, NULL);
+  for (int i = 0; i < pool->nb_workers; i++) {
+    pool->workers[i] = (worker_s){.pool = pool, .id = i, .seed = 2*i + 1};
+    pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]);
+  }
+  return pool;
+}
+
+/**
+ * @brief Waits for the workers to finish and deletes the pool.
+ *
+ * @param pool Pointer to the pool.
+ */
+void thread_pool_delete(thread_pool_s *pool) {
+  if (!pool) return;
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = true;
+  pthread_cond_broadcast(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
+  for (int i = 0; i < pool->nb_workers; i++)
+    pthread_join(pool->workers[i].thread, NULL);
+  for (int i = 0; i < pool->nb_workers; i++) {
+    pthread_mutex_destroy(&pool->deques[i].lock);
+    free(pool->deques[i].tasks);
+  }
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->work);
+  pthread_cond_destroy(&pool->done);
+  free(pool->deques);
+  free(pool->workers);
+  free(pool);
+}
+
+/**
+ * @brief Gets the number of worker threads of a pool.
+ *
+ * @param pool Pointer to the pool (NULL stands for a sequential execution).
+ * @return The number of workers (1 if pool is NULL).
+ */
+int thread_pool_size(const thread_pool_s *pool) {
+  return pool ? pool->nb_workers : 1;
+}
+
+/**
+ * @brief Gets the index of the calling worker.
+ *
+ * @return The index of the worker in its pool, or -1 if the caller is not a worker.
+ */
+int thread_pool_worker_id(void) {
+  return current_id;
+}
+
+/**
+ * @brief Pushes a task in the queue of a worker and wakes an idle worker up.
+ */
+static void submit_to_queue(thread_pool_s *pool, int id, task_group_s *group, void (*fn)(void *), void *arg) {
+  __atomic_add_fetch(&group->pending, 1, __ATOMIC_ACQ_REL);
+  deque_push(&pool->deques[id], (task_s){.fn = fn, .arg = arg, .group = group});
+  __atomic_add_fetch(&pool->nb_queued, 1, __ATOMIC_ACQ_REL);
+  pthread_mutex_lock(&pool->lock);
+  pthread_cond_signal(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Submits a task to the pool.
+ *
+ * @param pool Pointer to the pool (if NULL, the task is executed immediately).
+ * @param group The group of the task.
+ * @param fn The function of the task.
+ * @param arg The argument given to the function.
+ */
+void thread_pool_submit(thread_pool_s *pool, task_group_s *group, void (*fn)(void *), void *arg) {
+  assert(group!=NULL && fn!=NULL);
+  if (pool == NULL) {
+    fn(arg);
+    return;
+  }
+  int id = (current_pool == pool) ? current_id
+    : (int)(__atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED) % pool->nb_workers);
+  submit_to_queue(pool, id, group, fn, arg);
+}
+
+/**
+ * @brief Submits a task to the queue of a given worker.
+ *
+ * @param pool Pointer to the pool (if NULL, the task is executed immediately).
+ * @param worker Index of the worker (modulo the number of workers).
+ * @param group The group of the task.
+ * @param fn The function of the task.
+ * @param arg The argument given to the function.
+ */
+void thread_pool_submit_to(thread_pool_s *pool, int worker, task_group_s *group, void (*fn)(void *), void *arg) {
+  assert(group!=NULL && fn!=NULL && worker>=0);
+  if (pool == NULL) {
+    fn(arg);
+    return;
+  }
+  submit_to_queue(pool, worker % pool->nb_workers, group, fn, arg);
+}
+
+/**
+ * @brief Waits for all the tasks of a group to complete.
+ *
+ * A worker keeps executing tasks while it waits; another thread sleeps.
+ *
+ * @param pool Pointer to the pool.
+ * @param group The group of tasks.
+ */
+void thread_pool_wait(thread_pool_s *pool, task_group_s *group) {
+  assert(group!=NULL);
+  if (pool == NULL) return;
+  if (current_pool == pool) {
+    unsigned int seed = 2*current_id + 7;
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+      task_s t;
+      if (find_task(pool, current_id, &seed, &t)) run_task(pool, &t);
+      else sched_yield();
+    }
+    return;
+  }
+  pthread_mutex_lock(&pool->lock);
+  while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0)
+    pthread_cond_wait(&pool->done, &pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Structure of one chunk of a parallel loop.
+ */
+typedef struct {
+  int lo;                                 /**< First iteration of the chunk */
+  int hi;                                 /**< Iteration after the last one */
+  void (*body)(int lo, int hi, void *arg); /**< Body of the loop */
+  void *arg;                              /**< Argument of the body */
+} chunk_s;
+
+/**
+ * @brief Task executing one chunk of a parallel loop.
+ */
+static void run_chunk(void *arg) {
+  chunk_s *c = arg;
+  c->body(c->lo, c->hi, c->arg);
+}
+
+/**
+ * @brief Executes a loop in parallel.
+ *
+ * @param pool Pointer to the pool (if NULL, the loop is executed sequentially).
+ * @param begin The first iteration.
+ * @param end The iteration after the last one.
+ * @param grain The number of iterations per chunk (at least 1).
+ * @param body The function executing the iterations [lo, hi).
+ * @param arg The argument given to the function.
+ */
+void thread_pool_parallel_for(thread_pool_s *pool, int begin, int end, int grain,
+                              void (*body)(int lo, int hi, void *arg), void *arg) {
+  if (end <= begin) return;
+  if (grain < 1) grain = 1;
+  if (pool == NULL || end - begin <= grain) {
+    body(begin, end, arg);
+    return;
+  }
+  int nb_chunks = (end - begin + grain - 1) / grain;
+  chunk_s *chunks = malloc(nb_chunks*sizeof(chunk_s));
+  assert(chunks!=NULL);
+  task_group_s group = TASK_GROUP_INIT;
+  for (int c = 0; c < nb_chunks; c++) {
+    int lo = begin + c * grain;
+    chunks[c] = (chunk_s){.lo = lo, .hi = (lo + grain < end) ? lo + grain : end, .body = body, .arg = arg};
+    thread_pool_submit(pool, &group, run_chunk, &chunks[c]);
+  }
+  thread_pool_wait(pool, &group);
+  free(chunks);
+}